@@ -56,8 +56,9 @@ gams::algorithms::BaseAlgorithm::BaseAlgorithm (
   variables::Sensors * sensors,
   variables::Self * self,
   variables::Agents * agents)
-  : agents_ (agents), executions_ (0), knowledge_ (knowledge),
-    platform_ (platform), self_ (self), sensors_ (sensors)
+  : agents_ (agents), agent_views_ (0), executions_ (0), knowledge_ (knowledge),
+    platform_ (platform), self_ (self), sensors_ (sensors),
+    swarm_snapshot_ (0)
 {
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
@@ -74,11 +75,13 @@ gams::algorithms::BaseAlgorithm::operator= (const BaseAlgorithm & rhs)
 {
   if (this != &rhs)
   {
+    this->agent_views_ = rhs.agent_views_;
     this->knowledge_ = rhs.knowledge_;
     this->platform_ = rhs.platform_;
     this->sensors_ = rhs.sensors_;
     this->self_ = rhs.self_;
     this->status_ = rhs.status_;
+    this->swarm_snapshot_ = rhs.swarm_snapshot_;
   }
 }
 
@@ -100,6 +103,30 @@ gams::algorithms::BaseAlgorithm::set_self (variables::Self * self)
   self_ = self;
 }
 
+void
+gams::algorithms::BaseAlgorithm::reset (void)
+{
+}
+
+bool
+gams::algorithms::BaseAlgorithm::reusable (void) const
+{
+  return false;
+}
+
+bool
+gams::algorithms::BaseAlgorithm::uses_swarm_snapshot (void) const
+{
+  return false;
+}
+
+bool
+gams::algorithms::BaseAlgorithm::get_access_sets (
+  std::vector <std::string> &, std::vector <std::string> &) const
+{
+  return false;
+}
+
 void
 gams::algorithms::BaseAlgorithm::set_sensors (variables::Sensors * sensors)
 {
@@ -112,6 +139,18 @@ gams::algorithms::BaseAlgorithm::get_agents (void)
   return agents_;
 }
 
+variables::Agent *
+gams::algorithms::BaseAlgorithm::get_agent (size_t index)
+{
+  if (agent_views_)
+  {
+    return index < agent_views_->size () ?
+      &(*agent_views_)[index].agent () : 0;
+  }
+
+  return agents_ && index < agents_->size () ? &(*agents_)[index] : 0;
+}
+
 madara::knowledge::KnowledgeBase *
 gams::algorithms::BaseAlgorithm::get_knowledge_base (void)
 {
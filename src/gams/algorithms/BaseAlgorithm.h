@@ -58,6 +58,8 @@
 #include "gams/platforms/BasePlatform.h"
 #include "gams/variables/AlgorithmStatus.h"
 #include "gams/variables/Self.h"
+#include "gams/variables/SwarmSnapshot.h"
+#include "gams/variables/AgentView.h"
 #include "gams/pose/Region.h"
 #include "madara/knowledge/KnowledgeBase.h"
 
@@ -141,6 +143,46 @@ namespace gams
        * @return bitmask status of the platform. @see AlgorithmAnalyzeStatus
        **/
       virtual int plan (void) = 0;
+
+      /**
+       * Resets the algorithm when a cached instance is reused for a
+       * repeated command with the same arguments. The default does
+       * nothing. Override to clear progress such as visited waypoints.
+       * @see reusable
+       **/
+      virtual void reset (void);
+
+      /**
+       * Checks if the controller may cache this algorithm when it is
+       * replaced and reuse it for a repeated command. It is checked again
+       * when a cached instance would be reused, so algorithms built from
+       * knowledge base contents can refuse once those change. Algorithms
+       * that return true must restore their initial state in reset. The
+       * default is false, so replaced algorithms are deleted.
+       * @return true if the algorithm can be reused after a reset
+       **/
+      virtual bool reusable (void) const;
+
+      /**
+       * Checks if the algorithm reads swarm_snapshot_. The controller only
+       * copies agent state into the snapshot while a hosted algorithm or
+       * accent returns true, or while trajectories are recorded. The
+       * default is false.
+       * @return true if swarm_snapshot_ should be updated every cycle
+       **/
+      virtual bool uses_swarm_snapshot (void) const;
+
+      /**
+       * Declares the knowledge read and written by analyze, plan and
+       * execute, so that accents can be run concurrently. Names are
+       * treated as prefixes. Algorithms that command the platform should
+       * include "platform" in their writes. The default declares nothing.
+       * @param  reads    filled with the names the algorithm reads
+       * @param  writes   filled with the names the algorithm writes
+       * @return true if the sets were declared
+       **/
+      virtual bool get_access_sets (std::vector <std::string> & reads,
+        std::vector <std::string> & writes) const;
       
       /**
        * Sets the list of agents in the swarm
@@ -196,10 +238,26 @@ namespace gams
        **/
       variables::AlgorithmStatus * get_algorithm_status (void);
 
+      /**
+       * Gets an agent of the swarm with bound containers. If the controller
+       * uses lazy agents, the containers in get_agents are not bound, and
+       * the agent is bound through its view on first access instead.
+       * @param  index   the index of the agent in get_agents
+       * @return the agent, or 0 if index is out of range
+       **/
+      variables::Agent * get_agent (size_t index);
+
     protected:
       /// the list of agents potentially participating in the algorithm
       variables::Agents * agents_;
 
+      /**
+       * lazily bound views of the agents in agents_, set only if the
+       * controller uses lazy agents, in which case the containers in
+       * agents_ are unbound. Use get_agent to access either.
+       **/
+      variables::AgentViews * agent_views_;
+
       /// number of executions
       unsigned int executions_;
 
@@ -217,6 +275,14 @@ namespace gams
 
       /// provides access to status information for this platform
       variables::AlgorithmStatus status_;
+
+      /**
+       * the controller's copy of agent locations, velocities and
+       * orientations, updated once per MAPE cycle before analyze if
+       * uses_swarm_snapshot returns true. May be null if the algorithm is
+       * not hosted by a controller.
+       **/
+      const variables::SwarmSnapshot * swarm_snapshot_;
     };
 
     // deprecated typdef. Please use BaseAlgorithm instead.
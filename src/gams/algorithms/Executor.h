@@ -62,7 +62,7 @@
 #include "gams/algorithms/BaseAlgorithm.h"
 #include "gams/algorithms/AlgorithmFactory.h"
 #include "gams/algorithms/AlgorithmFactoryRepository.h"
-#include "madara/utility/EpochEnforcer.h"
+#include "gams/time/ModelsOfComputation.h"
 
 namespace gams
 {
@@ -165,7 +165,7 @@ namespace gams
       bool precond_met_;
 
       /// enforcer for time
-      madara::utility::EpochEnforcer<std::chrono::steady_clock> enforcer_;
+      time::EpochEnforcer enforcer_;
     };
     
     /**
@@ -59,6 +59,7 @@
 #include <math.h>
 
 #include "gams/utility/ArgumentParser.h"
+#include "gams/time/ModelsOfComputation.h"
 
 using std::stringstream;
 
@@ -81,6 +82,7 @@ gams::algorithms::FollowFactory::create (
   // set defaults
   std::string target;
   std::vector <double> offset;
+  double lead = 0.0;
   
 
   if (knowledge && platform && self)
@@ -92,6 +94,18 @@ gams::algorithms::FollowFactory::create (
 
     switch (i->first[0])
     {
+    case 'l':
+      if (i->first == "lead")
+      {
+        lead = i->second.to_double ();
+
+        madara_logger_ptr_log (gams::loggers::global_logger.get (),
+          gams::loggers::LOG_DETAILED,
+          "gams::algorithms::FollowFactory:" \
+          " leading target by %f s\n", lead);
+        break;
+      }
+      goto unknown;
     case 'o':
       if (i->first == "offset")
       {
@@ -137,7 +151,8 @@ gams::algorithms::FollowFactory::create (
   }
   else
   {
-    result = new Follow (target, offset, knowledge, platform, sensors, self);
+    result = new Follow (target, offset, knowledge, platform, sensors, self,
+      lead);
   }
 }
 
@@ -149,9 +164,10 @@ gams::algorithms::Follow::Follow (
   const std::vector <double> & offset,
   madara::knowledge::KnowledgeBase * knowledge,
   platforms::BasePlatform * platform, variables::Sensors * sensors,
-  variables::Self * self) :
+  variables::Self * self, double lead) :
   BaseAlgorithm (knowledge, platform, sensors, self), offset_ (offset),
-  had_valid_dest_orientation_ (false)
+  had_valid_dest_orientation_ (false), target_prefix_ (target), lead_ (lead),
+  has_last_move_ (false), warned_no_history_ (false)
 {
   if (knowledge && platform && sensors && self)
   {
@@ -187,6 +203,11 @@ gams::algorithms::Follow::operator= (const Follow & rhs)
     this->offset_ = rhs.offset_;
     this->need_move_ = rhs.need_move_;
     this->had_valid_dest_orientation_ = rhs.had_valid_dest_orientation_;
+    this->target_prefix_ = rhs.target_prefix_;
+    this->lead_ = rhs.lead_;
+    this->last_move_ = rhs.last_move_;
+    this->has_last_move_ = rhs.has_last_move_;
+    this->warned_no_history_ = rhs.warned_no_history_;
   }
 }
 
@@ -234,6 +255,35 @@ gams::algorithms::Follow::analyze (void)
       target_destination_.from_container (target_.dest);
       target_orientation_.from_container (target_.orientation);
 
+      // lead the target along its estimated trajectory
+      int index = swarm_snapshot_ && lead_ > 0 ?
+        swarm_snapshot_->find (target_prefix_) : -1;
+
+      if (index >= 0 && swarm_snapshot_->trajectories.empty () &&
+        !warned_no_history_)
+      {
+        madara_logger_ptr_log (gams::loggers::global_logger.get (),
+          gams::loggers::LOG_WARNING,
+          "gams::algorithms::Follow::analyze:" \
+          " lead is set, but the controller keeps no trajectories." \
+          " Set trajectory_length to lead the target.\n");
+
+        warned_no_history_ = true;
+      }
+
+      if (index >= 0 &&
+        (size_t)index < swarm_snapshot_->trajectories.size () &&
+        swarm_snapshot_->trajectories[index].size () >= 2)
+      {
+        double x, y, z;
+        swarm_snapshot_->trajectories[index].extrapolate (
+          gams::time::VirtualClock::seconds () + lead_, x, y, z);
+
+        target_location_.x (x);
+        target_location_.y (y);
+        target_location_.z (z);
+      }
+
       madara_logger_ptr_log (gams::loggers::global_logger.get (),
         gams::loggers::LOG_MAJOR,
         "gams::algorithms::Follow::analyze:" \
@@ -316,6 +366,25 @@ gams::algorithms::Follow::execute (void)
         " moving to position %s.\n",
         destination.to_string ().c_str ());
 
+      // a leading follower only corrects its course when the predicted
+      // destination moves beyond the platform's accuracy
+      pose::Position move = destination.transform_to (
+        target_location_.frame ());
+
+      if (lead_ > 0 && has_last_move_ &&
+        move.distance_to (last_move_) < platform_->get_accuracy ())
+      {
+        madara_logger_ptr_log (gams::loggers::global_logger.get (),
+          gams::loggers::LOG_MINOR,
+          "gams::algorithms::Follow::execute:"
+          " prediction unchanged. Not moving.\n");
+
+        return 0;
+      }
+
+      last_move_ = move;
+      has_last_move_ = true;
+
       // move to new destination
       platform_->move (destination, platform_->get_accuracy ());
 
@@ -351,3 +420,9 @@ gams::algorithms::Follow::plan (void)
 {
   return 0;
 }
+
+bool
+gams::algorithms::Follow::uses_swarm_snapshot (void) const
+{
+  return lead_ > 0;
+}
@@ -82,6 +82,10 @@ namespace gams
        * @param  platform   the underlying platform the algorithm will use
        * @param  sensors    map of sensor names to sensor information
        * @param  self       self-referencing variables
+       * @param  lead       seconds ahead of the target's estimated
+       *                    trajectory to follow. Requires the controller
+       *                    to keep trajectory histories. 0 follows the
+       *                    last reported location.
        **/
       Follow (
         const std::string & target,
@@ -89,7 +93,8 @@ namespace gams
         madara::knowledge::KnowledgeBase * knowledge = 0,
         platforms::BasePlatform * platform = 0,
         variables::Sensors * sensors = 0,
-        variables::Self * self = 0);
+        variables::Self * self = 0,
+        double lead = 0.0);
       
       /**
        * Destructor
@@ -119,6 +124,13 @@ namespace gams
        * @return bitmask status of the platform. @see Status.
        **/
       virtual int plan (void);
+
+      /**
+       * Checks if the algorithm reads the swarm snapshot, which is only
+       * the case when leading the target
+       * @return true if lead is positive
+       **/
+      virtual bool uses_swarm_snapshot (void) const;
       
     protected:
       /// location of agent to follow
@@ -156,6 +168,21 @@ namespace gams
 
       /// last valid destination based orientation
       gams::pose::Orientation last_dest_orientation;
+
+      /// the prefix of the target agent
+      std::string target_prefix_;
+
+      /// seconds to lead the target by
+      double lead_;
+
+      /// the last destination moved to, in the target location's frame
+      pose::Position last_move_;
+
+      /// true if last_move_ is valid
+      bool has_last_move_;
+
+      /// true once the missing trajectory history has been reported
+      bool warned_no_history_;
     };
 
     /**
@@ -66,8 +66,7 @@ namespace containers = engine::containers;
 
 using namespace gams::utility;
 
-typedef  madara::utility::EpochEnforcer<
-  std::chrono::steady_clock> EpochEnforcer;
+typedef  gams::time::EpochEnforcer EpochEnforcer;
 
 typedef madara::knowledge::KnowledgeRecord::Integer  Integer;
 
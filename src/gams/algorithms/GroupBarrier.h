@@ -66,7 +66,7 @@
 #include "gams/algorithms/AlgorithmFactory.h"
 #include "madara/knowledge/containers/Integer.h"
 #include "madara/knowledge/containers/Barrier.h"
-#include "madara/utility/EpochEnforcer.h"
+#include "gams/time/ModelsOfComputation.h"
 
 namespace gams
 {
@@ -147,7 +147,7 @@ namespace gams
       madara::knowledge::containers::Barrier barrier_;
 
       /// enforcer of barrier times
-      madara::utility::EpochEnforcer<std::chrono::steady_clock> enforcer_;
+      time::EpochEnforcer enforcer_;
     };
     
     /**
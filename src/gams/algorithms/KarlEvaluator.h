@@ -56,7 +56,7 @@
 
 #include "gams/algorithms/BaseAlgorithm.h"
 #include "gams/algorithms/AlgorithmFactory.h"
-#include "madara/utility/EpochEnforcer.h"
+#include "gams/time/ModelsOfComputation.h"
 
 namespace gams
 {
@@ -141,7 +141,7 @@ namespace gams
       double wait_time_;
 
       /// an enforcer for maximum time taken
-      madara::utility::EpochEnforcer<std::chrono::steady_clock> enforcer_;
+      time::EpochEnforcer enforcer_;
     };
     
     /**
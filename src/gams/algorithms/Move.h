@@ -64,7 +64,7 @@
 #include "gams/variables/Self.h"
 #include "gams/pose/Position.h"
 #include "gams/algorithms/AlgorithmFactory.h"
-#include "madara/utility/EpochEnforcer.h"
+#include "gams/time/ModelsOfComputation.h"
 
 #include "gams/GamsExport.h"
 
@@ -155,7 +155,7 @@ namespace gams
       bool finished_moving_;
 
       /// the timing enforcer
-      madara::utility::EpochEnforcer<std::chrono::steady_clock> enforcer_;
+      time::EpochEnforcer enforcer_;
     };
 
     /**
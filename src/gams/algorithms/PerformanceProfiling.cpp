@@ -114,3 +114,15 @@ gams::algorithms::PerformanceProfiling::plan (void)
 {
   return OK;
 }
+
+bool
+gams::algorithms::PerformanceProfiling::get_access_sets (
+  std::vector <std::string> & reads,
+  std::vector <std::string> & writes) const
+{
+  reads.clear ();
+  writes.clear ();
+  writes.push_back (self_->agent.prefix + ".algorithm." + status_.name);
+
+  return true;
+}
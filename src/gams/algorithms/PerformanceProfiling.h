@@ -111,6 +111,15 @@ namespace gams
        * @return bitmask status of the platform. @see Status.
        **/
       virtual int plan (void);
+
+      /**
+       * Declares the algorithm's status as its only access
+       * @param  reads    filled with the names the algorithm reads
+       * @param  writes   filled with the names the algorithm writes
+       * @return true
+       **/
+      virtual bool get_access_sets (std::vector <std::string> & reads,
+        std::vector <std::string> & writes) const;
     };
 
     /**
@@ -64,7 +64,7 @@
 #include "gams/platforms/BasePlatform.h"
 #include "gams/variables/AlgorithmStatus.h"
 #include "gams/variables/Self.h"
-#include "madara/utility/EpochEnforcer.h"
+#include "gams/time/ModelsOfComputation.h"
 #include "gams/utility/Position.h"
 #include "gams/algorithms/AlgorithmFactory.h"
 
@@ -154,7 +154,7 @@ namespace gams
       bool initialized_;
 
       /// max run time enforcer
-      madara::utility::EpochEnforcer<std::chrono::steady_clock> enforcer_;
+      time::EpochEnforcer enforcer_;
     };
 
     /**
@@ -63,7 +63,7 @@
 #include "gams/variables/AlgorithmStatus.h"
 #include "gams/variables/Self.h"
 #include "gams/algorithms/AlgorithmFactory.h"
-#include "madara/utility/EpochEnforcer.h"
+#include "gams/time/ModelsOfComputation.h"
 
 namespace gams
 {
@@ -121,7 +121,7 @@ namespace gams
       
     protected:
       /// an enforcer for max wait time
-      madara::utility::EpochEnforcer<std::chrono::steady_clock> enforcer_;
+      time::EpochEnforcer enforcer_;
     };
 
     /**
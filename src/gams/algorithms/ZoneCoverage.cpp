@@ -382,13 +382,13 @@ gams::algorithms::ZoneCoverage::ZoneCoverage (
       assets_members_.push_back (assets);
     }
 
-    update_arrays (assets_members_, asset_loc_cont_);
+    asset_snapshot_.init (*knowledge, assets_members_);
 
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
       gams::loggers::LOG_MAJOR,
       "gams::algorithms::ZoneCoverage::constructor:" \
-      " assets list size: %i; asset loc array size: %i\n",
-      assets_members_.size (), asset_loc_cont_.size ());
+      " assets list size: %i; asset snapshot size: %i\n",
+      assets_members_.size (), asset_snapshot_.size ());
 
     // check if enemies is a single agent or a group
     if (!gams::variables::Agent::is_agent (*knowledge, enemies))
@@ -451,13 +451,13 @@ gams::algorithms::ZoneCoverage::ZoneCoverage (
       enemies_members_.push_back (enemies);
     }
 
-    update_arrays (enemies_members_, enemy_loc_cont_);
+    enemy_snapshot_.init (*knowledge, enemies_members_);
 
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
       gams::loggers::LOG_MAJOR,
       "gams::algorithms::ZoneCoverage::constructor:" \
-      " enemy list size: %i; enemy loc array size: %i\n",
-      enemies_members_.size (), enemy_loc_cont_.size ());
+      " enemy list size: %i; enemy snapshot size: %i\n",
+      enemies_members_.size (), enemy_snapshot_.size ());
 
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
       gams::loggers::LOG_MAJOR,
@@ -486,38 +486,28 @@ gams::algorithms::ZoneCoverage::operator= (const ZoneCoverage & rhs)
   }
 }
 
-void
-gams::algorithms::ZoneCoverage::update_arrays (
-  const gams::groups::AgentVector &names,
-  MadaraArrayVec &arrays) const
-{
-  arrays.clear ();
-
-  arrays.resize (names.size ());
-  for (size_t i = 0; i < names.size (); ++i)
-  {
-    arrays[i].set_name (names[i] + ".location", *knowledge_, 3);
-  }
-}
-
 void
 gams::algorithms::ZoneCoverage::update_locs (
-  const MadaraArrayVec &arrays,
+  variables::SwarmSnapshot &snapshot,
   std::vector<Position> &locs) const
 {
-  if (locs.size () != arrays.size ())
+  snapshot.update ();
+
+  if (locs.size () != snapshot.size ())
   {
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
       gams::loggers::LOG_MAJOR,
       "gams::algorithms::ZoneCoverage::update_locs:" \
       " resizing locs array\n");
-    locs.resize (arrays.size (), Position (platform_->get_frame ()));
+    locs.resize (snapshot.size (), Position (platform_->get_frame ()));
   }
-  for (size_t i = 0; i < arrays.size (); ++i)
+  for (size_t i = 0; i < snapshot.size (); ++i)
   {
-    if (arrays[i].size () >= 2)
+    if (snapshot.has_location[i])
     {
-      locs[i].from_container (arrays[i]);
+      locs[i].set (0, snapshot.x[i]);
+      locs[i].set (1, snapshot.y[i]);
+      locs[i].set (2, snapshot.z[i]);
 
       madara_logger_ptr_log (gams::loggers::global_logger.get (),
         gams::loggers::LOG_MAJOR,
@@ -536,8 +526,8 @@ gams::algorithms::ZoneCoverage::analyze (void)
     "gams::algorithms::ZoneCoverage::analyze:" \
     " entering analyze method\n");
 
-  update_locs (asset_loc_cont_, asset_locs_);
-  update_locs (enemy_loc_cont_, enemy_locs_);
+  update_locs (asset_snapshot_, asset_locs_);
+  update_locs (enemy_snapshot_, enemy_locs_);
   return OK;
 }
 
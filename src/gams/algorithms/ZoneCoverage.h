@@ -172,19 +172,15 @@ namespace gams
 
       static formation_func get_form_func (const std::string &form_name);
 
-      typedef std::vector<madara::knowledge::containers::NativeDoubleArray> MadaraArrayVec;
-
-      MadaraArrayVec asset_loc_cont_;
-      MadaraArrayVec enemy_loc_cont_;
+      variables::SwarmSnapshot asset_snapshot_;
+      variables::SwarmSnapshot enemy_snapshot_;
 
       std::vector<pose::Position> asset_locs_;
       std::vector<pose::Position> enemy_locs_;
       pose::Position next_loc_;
 
     private:
-      void update_arrays (const gams::groups::AgentVector &names,
-                         MadaraArrayVec &arrays) const;
-      void update_locs (const MadaraArrayVec &arrays,
+      void update_locs (variables::SwarmSnapshot &snapshot,
                        std::vector<pose::Position> &locs) const;
     };
     
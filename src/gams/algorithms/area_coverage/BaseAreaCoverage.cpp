@@ -58,6 +58,8 @@
 
 #include "gams/algorithms/area_coverage/BaseAreaCoverage.h"
 
+#include "gams/pose/SearchArea.h"
+
 gams::algorithms::area_coverage::BaseAreaCoverage::BaseAreaCoverage (
   madara::knowledge::KnowledgeBase * knowledge,
   platforms::BasePlatform * platform,
@@ -87,6 +89,8 @@ gams::algorithms::area_coverage::BaseAreaCoverage::operator= (
     this->next_position_ = rhs.next_position_;
     this->max_time_ = rhs.max_time_;
     this->enforcer_ = rhs.enforcer_;
+    this->search_area_id_ = rhs.search_area_id_;
+    this->search_area_clocks_ = rhs.search_area_clocks_;
 
     this->BaseAlgorithm::operator= (rhs);
   }
@@ -196,6 +200,76 @@ gams::algorithms::area_coverage::BaseAreaCoverage::get_next_position() const
   return next_position_;
 }
 
+void
+gams::algorithms::area_coverage::BaseAreaCoverage::reset (void)
+{
+  enforcer_ = gams::time::EpochEnforcer (
+    max_time_, max_time_);
+  status_.finished = 0;
+  executions_ = 0;
+
+  if (search_area_id_ != "")
+  {
+    generate_new_position ();
+  }
+}
+
+bool
+gams::algorithms::area_coverage::BaseAreaCoverage::reusable (void) const
+{
+  return search_area_id_ != "" &&
+    get_search_area_clocks () == search_area_clocks_;
+}
+
+void
+gams::algorithms::area_coverage::BaseAreaCoverage::record_search_area (
+  const std::string & search_area_id)
+{
+  search_area_id_ = search_area_id;
+  search_area_clocks_ = get_search_area_clocks ();
+}
+
+std::string
+gams::algorithms::area_coverage::BaseAreaCoverage::get_search_area_clocks (
+  void) const
+{
+  std::string result;
+
+  if (knowledge_ && search_area_id_ != "")
+  {
+    pose::SearchArea search;
+    search.from_container (*knowledge_, search_area_id_);
+
+    std::vector <std::string> prefixes (1, search_area_id_);
+
+    const std::vector <pose::PrioritizedRegion> & regions =
+      search.get_regions ();
+
+    for (size_t i = 0; i < regions.size (); ++i)
+    {
+      prefixes.push_back (regions[i].get_name ());
+    }
+
+    // any change to the area or a region ticks the clock of its record
+    for (size_t i = 0; i < prefixes.size (); ++i)
+    {
+      madara::knowledge::KnowledgeMap records (
+        knowledge_->to_map (prefixes[i] + "."));
+
+      for (madara::knowledge::KnowledgeMap::const_iterator j =
+        records.begin (); j != records.end (); ++j)
+      {
+        result += j->first;
+        result += '=';
+        result += std::to_string (j->second.clock);
+        result += '\n';
+      }
+    }
+  }
+
+  return result;
+}
+
 int
 gams::algorithms::area_coverage::BaseAreaCoverage::check_if_finished (
   int ret_val) const
@@ -54,12 +54,14 @@
 #ifndef _GAMS_ALGORITHMS_AREA_COVERAGE_BASE_AREA_COVERAGE_H_
 #define _GAMS_ALGORITHMS_AREA_COVERAGE_BASE_AREA_COVERAGE_H_
 
+#include <string>
+
 #include "gams/algorithms/BaseAlgorithm.h"
 
 #include "gams/utility/GPSPosition.h"
 
 #include "madara/utility/Utility.h"
-#include "madara/utility/EpochEnforcer.h"
+#include "gams/time/ModelsOfComputation.h"
 
 namespace gams
 {
@@ -119,6 +121,22 @@ namespace gams
          **/
         virtual int plan (void);
 
+        /**
+         * Restarts the coverage time limit, clears the finished status
+         * and, for coverages that recorded their search area, generates
+         * a new first position when a cached instance is reused
+         **/
+        virtual void reset (void);
+
+        /**
+         * Area coverages that recorded their search area with
+         * record_search_area are reusable while the search area and its
+         * regions are unchanged in the knowledge base, since reading and
+         * discretizing the search area is expensive
+         * @return true if a search area was recorded and is unchanged
+         **/
+        virtual bool reusable (void) const;
+
         /**
          * Get next position
          * @return next_position_ member
@@ -136,6 +154,21 @@ namespace gams
          */
         int check_if_finished (int ret_val) const;
 
+        /**
+         * Records the search area the coverage was built from. Only call
+         * this if the rest of the coverage state is regenerated by
+         * generate_new_position, since reset relies on it.
+         * @param  search_area_id   the name of the search area
+         **/
+        void record_search_area (const std::string & search_area_id);
+
+        /**
+         * Lists the records of the recorded search area and its regions
+         * with their clocks
+         * @return  the record names and clocks, one per line
+         **/
+        std::string get_search_area_clocks (void) const;
+
         /// next position
         utility::GPSPosition next_position_;
 
@@ -146,7 +179,13 @@ namespace gams
         double max_time_;
 
         /// enforcer for maximum time
-        madara::utility::EpochEnforcer<std::chrono::steady_clock> enforcer_;
+        time::EpochEnforcer enforcer_;
+
+        /// the search area set by record_search_area, or "" if none
+        std::string search_area_id_;
+
+        /// the search area records when the coverage was built
+        std::string search_area_clocks_;
       };
     } // namespace area_coverage
   } // namespace algorithms
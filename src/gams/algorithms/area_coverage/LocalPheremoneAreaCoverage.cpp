@@ -219,6 +219,17 @@ gams::algorithms::area_coverage::LocalPheremoneAreaCoverage::operator= (
   }
 }
 
+int
+gams::algorithms::area_coverage::LocalPheremoneAreaCoverage::execute (void)
+{
+  int ret_val = BaseAreaCoverage::execute ();
+
+  // pheremone updates are only sent to other agents by sync
+  pheremone_.sync ();
+
+  return ret_val;
+}
+
 void
 gams::algorithms::area_coverage::LocalPheremoneAreaCoverage::
   generate_new_position (void)
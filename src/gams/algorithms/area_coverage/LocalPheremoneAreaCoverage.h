@@ -96,6 +96,11 @@ namespace gams
          * @param  rhs   values to copy
          **/
         void operator= (const LocalPheremoneAreaCoverage & rhs);
+
+        /**
+         * Moves to the next position and publishes pheremone updates
+         */
+        virtual int execute (void);
         
       protected:
         /**
@@ -273,6 +273,17 @@ gams::algorithms::area_coverage::MinTimeAreaCoverage::analyze (void)
   return check_if_finished (OK);
 }
 
+int
+gams::algorithms::area_coverage::MinTimeAreaCoverage::execute (void)
+{
+  int ret_val = BaseAreaCoverage::execute ();
+
+  // the resets in analyze and generate_new_position are only sent by sync
+  min_time_.sync ();
+
+  return ret_val;
+}
+
 void
 gams::algorithms::area_coverage::MinTimeAreaCoverage::
   generate_new_position (void)
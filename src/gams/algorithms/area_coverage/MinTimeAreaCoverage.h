@@ -113,6 +113,11 @@ namespace gams
          */
         virtual int analyze (void);
 
+        /**
+         * Moves to the next position and publishes sensor updates
+         */
+        virtual int execute (void);
+
       protected:
         /// generate new next position
         virtual void generate_new_position (void);
@@ -188,6 +188,7 @@ PriorityWeightedRandomAreaCoverage (
 
   // get search area
   search_area_.from_container (*knowledge, search_id);
+  record_search_area (search_id);
 
   // calculate total priority
   const vector<pose::PrioritizedRegion>& regions =
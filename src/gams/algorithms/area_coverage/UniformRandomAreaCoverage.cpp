@@ -172,6 +172,7 @@ gams::algorithms::area_coverage::UniformRandomAreaCoverage::
   pose::SearchArea search;
   search.from_container (*knowledge, search_area_id);
   region_ = search.get_convex_hull ();
+  record_search_area (search_area_id);
 
   // generate initial waypoint
   generate_new_position();
@@ -191,6 +191,7 @@ UniformRandomEdgeCoverage::UniformRandomEdgeCoverage (
     " getting convex hull of \"%s\"\n", prefix.c_str ());
   
   region_ = search.get_convex_hull ();
+  record_search_area (prefix);
 
   // generate initial waypoint
   generate_new_position ();
@@ -153,6 +153,25 @@ gams::algorithms::area_coverage::WaypointsCoverage::~WaypointsCoverage ()
 {
 }
 
+void
+gams::algorithms::area_coverage::WaypointsCoverage::reset (void)
+{
+  BaseAreaCoverage::reset ();
+
+  cur_waypoint_ = 0;
+
+  if (waypoints_.size () > 0)
+  {
+    next_position_ = waypoints_[cur_waypoint_];
+  }
+}
+
+bool
+gams::algorithms::area_coverage::WaypointsCoverage::reusable (void) const
+{
+  return true;
+}
+
 void
 gams::algorithms::area_coverage::WaypointsCoverage::operator= (
   const WaypointsCoverage& rhs)
@@ -111,7 +111,19 @@ namespace gams
          * @return bitmask status of the platform. @see Status.
          **/
         virtual int analyze (void);
-        
+
+        /**
+         * Restarts from the first waypoint when a cached instance is reused
+         **/
+        virtual void reset (void);
+
+        /**
+         * Waypoints coverage is reusable, since its waypoints come from its
+         * arguments and reset returns to the first one
+         * @return true
+         **/
+        virtual bool reusable (void) const;
+
       protected:
         /**
          * Generate new next position
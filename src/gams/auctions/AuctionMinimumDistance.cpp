@@ -50,7 +50,7 @@
 
 #include "AuctionMinimumDistance.h"
 #include "gams/loggers/GlobalLogger.h"
-#include "gams/variables/Agent.h"
+#include "gams/pose/PositionArrays.h"
 
 namespace knowledge = madara::knowledge;
 namespace containers = knowledge::containers;
@@ -128,26 +128,36 @@ void gams::auctions::AuctionMinimumDistance::calculate_bids (void)
 
   if (knowledge_ && platform_)
   {
-    // initialize the agent list within the group
-    variables::Agents agents;
-    variables::init_vars (agents, *knowledge_, group_);
+    // copy the locations of the group members in one pass
+    groups::AgentVector members;
+    group_.get_members (members);
 
-    for (size_t i = 0; i < agents.size (); ++i)
+    if (members != snapshot_.prefixes)
     {
-      // import the agents's location into the GAMS Pose system
-      gams::pose::Position location (platform_->get_frame ());
-      location.from_container (agents[i].location);
+      snapshot_.init (*knowledge_, members);
+    }
+
+    snapshot_.update ();
 
-      double distance = location.distance_to (target_);
+    // import the agents' locations into the GAMS Pose system, and
+    // measure them all against the target at once
+    pose::PositionArrays locations (platform_->get_frame (),
+      snapshot_.x.data (), snapshot_.y.data (), snapshot_.z.data (),
+      snapshot_.size ());
+    std::vector <double> distances = locations.distances_from (target_);
+
+    for (size_t i = 0; i < snapshot_.size (); ++i)
+    {
+      double distance = distances[i];
 
       madara_logger_ptr_log (gams::loggers::global_logger.get (),
         gams::loggers::LOG_MINOR,
         "gams::auctions::AuctionMinimumDistance::calculate_bids:" \
         " agent %s distance is %f. Bidding distance.\n",
-        agents[i].prefix.c_str (), distance);
+        snapshot_.prefixes[i].c_str (), distance);
 
       // bid for the agent using their distance to the target
-      bids_.set (agents[i].prefix, distance);
+      bids_.set (snapshot_.prefixes[i], distance);
     }
   }
   else
@@ -66,6 +66,7 @@
 #include "gams/platforms/BasePlatform.h"
 #include "gams/groups/GroupFixedList.h"
 #include "gams/pose/Position.h"
+#include "gams/variables/SwarmSnapshot.h"
 
 namespace gams
 {
@@ -134,6 +135,12 @@ namespace gams
        * The platform is necessary to construct poses (we need frame)
        **/
       platforms::BasePlatform * platform_;
+
+      /**
+       * Locations of the group members, reused between calculations and
+       * only reinitialized when the membership changes
+       **/
+      variables::SwarmSnapshot snapshot_;
     };
 
     /**
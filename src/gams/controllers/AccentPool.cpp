@@ -0,0 +1,283 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file AccentPool.cpp
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the definition of the accent worker pool
+ **/
+
+#include "AccentPool.h"
+#include "MapeStatistics.h"
+
+#include "gams/loggers/GlobalLogger.h"
+
+gams::controllers::AccentPool::AccentPool (size_t num_threads)
+  : next_ (0), remaining_ (0), terminated_ (false)
+{
+  for (size_t i = 0; i < num_threads; ++i)
+  {
+    threads_.push_back (std::thread (&AccentPool::run_worker_, this));
+  }
+}
+
+gams::controllers::AccentPool::~AccentPool ()
+{
+  {
+    std::lock_guard <std::mutex> guard (lock_);
+    terminated_ = true;
+  }
+
+  work_ready_.notify_all ();
+
+  for (size_t i = 0; i < threads_.size (); ++i)
+  {
+    threads_[i].join ();
+  }
+}
+
+bool
+gams::controllers::AccentPool::conflicts (
+  const std::vector <std::string> & writes,
+  const std::vector <std::string> & reads,
+  const std::vector <std::string> & other_writes)
+{
+  for (size_t i = 0; i < writes.size (); ++i)
+  {
+    const std::string & write = writes[i];
+
+    for (size_t j = 0; j < reads.size () + other_writes.size (); ++j)
+    {
+      const std::string & other = j < reads.size () ?
+        reads[j] : other_writes[j - reads.size ()];
+
+      // either name is a prefix of the other
+      if (write.compare (0, other.size (), other) == 0 ||
+        other.compare (0, write.size (), write) == 0)
+      {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+void
+gams::controllers::AccentPool::set_accents (
+  const algorithms::Algorithms & accents)
+{
+  std::vector <std::vector <std::string> > reads (accents.size ());
+  std::vector <std::vector <std::string> > writes (accents.size ());
+  std::vector <bool> declared (accents.size (), false);
+
+  for (size_t i = 0; i < accents.size (); ++i)
+  {
+    declared[i] = accents[i]->get_access_sets (reads[i], writes[i]);
+  }
+
+  algorithms::Algorithms parallel, serial;
+
+  for (size_t i = 0; i < accents.size (); ++i)
+  {
+    bool independent = declared[i];
+
+    for (size_t j = 0; independent && j < accents.size (); ++j)
+    {
+      if (i != j && declared[j] &&
+        (conflicts (writes[i], reads[j], writes[j]) ||
+         conflicts (writes[j], reads[i], writes[i])))
+      {
+        independent = false;
+      }
+    }
+
+    if (independent)
+    {
+      parallel.push_back (accents[i]);
+    }
+    else
+    {
+      serial.push_back (accents[i]);
+    }
+  }
+
+  std::lock_guard <std::mutex> guard (lock_);
+
+  parallel_.swap (parallel);
+  serial_.swap (serial);
+  next_ = parallel_.size ();
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::controllers::AccentPool::set_accents:" \
+    " %d accents run concurrently, %d run in order\n",
+    (int)parallel_.size (), (int)serial_.size ());
+}
+
+void
+gams::controllers::AccentPool::run_serial (int phase)
+{
+  for (size_t i = 0; i < serial_.size (); ++i)
+  {
+    call_ (serial_[i], phase);
+  }
+}
+
+void
+gams::controllers::AccentPool::run_parallel (void)
+{
+  if (parallel_.size () > 0)
+  {
+    std::unique_lock <std::mutex> lock (lock_);
+
+    next_ = 0;
+    remaining_ = parallel_.size ();
+
+    work_ready_.notify_all ();
+
+    // the calling thread claims accents too, rather than idling
+    while (next_ < parallel_.size ())
+    {
+      algorithms::BaseAlgorithm * accent = parallel_[next_++];
+
+      lock.unlock ();
+      analyze_and_plan_ (accent);
+      lock.lock ();
+
+      --remaining_;
+    }
+
+    while (remaining_ > 0)
+    {
+      work_done_.wait (lock);
+    }
+  }
+}
+
+void
+gams::controllers::AccentPool::execute_parallel (void)
+{
+  for (size_t i = 0; i < parallel_.size (); ++i)
+  {
+    call_ (parallel_[i], MAPE_PHASE_EXECUTE);
+  }
+}
+
+size_t
+gams::controllers::AccentPool::get_num_parallel (void) const
+{
+  return parallel_.size ();
+}
+
+size_t
+gams::controllers::AccentPool::get_num_serial (void) const
+{
+  return serial_.size ();
+}
+
+void
+gams::controllers::AccentPool::run_worker_ (void)
+{
+  std::unique_lock <std::mutex> lock (lock_);
+
+  while (!terminated_)
+  {
+    if (next_ >= parallel_.size ())
+    {
+      work_ready_.wait (lock);
+      continue;
+    }
+
+    algorithms::BaseAlgorithm * accent = parallel_[next_++];
+
+    lock.unlock ();
+    analyze_and_plan_ (accent);
+    lock.lock ();
+
+    if (--remaining_ == 0)
+    {
+      work_done_.notify_all ();
+    }
+  }
+}
+
+void
+gams::controllers::AccentPool::call_ (
+  algorithms::BaseAlgorithm * accent, int phase)
+{
+  try
+  {
+    if (phase == MAPE_PHASE_ANALYZE)
+    {
+      accent->analyze ();
+    }
+    else if (phase == MAPE_PHASE_PLAN)
+    {
+      accent->plan ();
+    }
+    else if (phase == MAPE_PHASE_EXECUTE)
+    {
+      accent->execute ();
+    }
+  }
+  catch (std::exception & e)
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_MAJOR,
+      "gams::controllers::AccentPool::call_:" \
+      " exception in accent phase %d: %s\n", phase, e.what ());
+  }
+}
+
+void
+gams::controllers::AccentPool::analyze_and_plan_ (
+  algorithms::BaseAlgorithm * accent)
+{
+  call_ (accent, MAPE_PHASE_ANALYZE);
+  call_ (accent, MAPE_PHASE_PLAN);
+}
@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file AccentPool.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a worker pool for running accent phases concurrently
+ **/
+
+#ifndef   _GAMS_CONTROLLERS_ACCENTPOOL_H_
+#define   _GAMS_CONTROLLERS_ACCENTPOOL_H_
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "gams/GamsExport.h"
+#include "gams/algorithms/BaseAlgorithm.h"
+
+namespace gams
+{
+  namespace controllers
+  {
+    /**
+     * Runs accents on a small pool of worker threads. Accents are run
+     * concurrently only if they declare their read and write sets with
+     * BaseAlgorithm::get_access_sets and no other declared accent reads
+     * or writes what they write. All other accents run in order, one
+     * phase at a time, with run_serial.
+     *
+     * The concurrent group runs its analyze and plan phases with
+     * run_parallel, which must be called without the context lock held,
+     * since the workers access the knowledge base from their own threads.
+     * run_parallel returns once every accent has planned, and their
+     * execute phases are then run in order with execute_parallel.
+     **/
+    class GAMS_EXPORT AccentPool
+    {
+    public:
+      /**
+       * Constructor
+       * @param  num_threads   the number of worker threads
+       **/
+      AccentPool (size_t num_threads);
+
+      /**
+       * Destructor. Joins the worker threads.
+       **/
+      ~AccentPool ();
+
+      /**
+       * Sets the accents to run and splits them into the concurrent and
+       * in-order groups. Should not be called while run is executing.
+       * @param  accents   the accents, in the order they were added
+       **/
+      void set_accents (const algorithms::Algorithms & accents);
+
+      /**
+       * Runs a phase of every accent in the in-order group, on the
+       * calling thread
+       * @param  phase   MAPE_PHASE_ANALYZE, MAPE_PHASE_PLAN or
+       *                 MAPE_PHASE_EXECUTE
+       **/
+      void run_serial (int phase);
+
+      /**
+       * Runs the analyze and plan phases of every accent in the
+       * concurrent group and waits for all of them. The caller must not
+       * hold the context lock.
+       **/
+      void run_parallel (void);
+
+      /**
+       * Runs the execute phase of every accent in the concurrent group,
+       * in order, on the calling thread
+       **/
+      void execute_parallel (void);
+
+      /**
+       * Returns the number of accents that run concurrently
+       * @return  the size of the concurrent group
+       **/
+      size_t get_num_parallel (void) const;
+
+      /**
+       * Returns the number of accents that run in order
+       * @return  the size of the in-order group
+       **/
+      size_t get_num_serial (void) const;
+
+      /**
+       * Checks if one access set writes what another reads or writes.
+       * Names are compared as prefixes, so "agent.0" overlaps with
+       * "agent.0.location".
+       * @param  writes   the names written by the first accent
+       * @param  reads    the names read by the second accent
+       * @param  other_writes  the names written by the second accent
+       * @return  true if the accents conflict
+       **/
+      static bool conflicts (const std::vector <std::string> & writes,
+        const std::vector <std::string> & reads,
+        const std::vector <std::string> & other_writes);
+
+    private:
+
+      /// Main function of a worker thread
+      void run_worker_ (void);
+
+      /**
+       * Calls a phase on an accent, logging any exceptions
+       * @param  accent   the accent to call
+       * @param  phase    the phase to call
+       **/
+      static void call_ (algorithms::BaseAlgorithm * accent, int phase);
+
+      /**
+       * Calls the analyze and plan phases on an accent
+       * @param  accent   the accent to call
+       **/
+      static void analyze_and_plan_ (algorithms::BaseAlgorithm * accent);
+
+      /// the worker threads
+      std::vector <std::thread> threads_;
+
+      /// accents that run concurrently
+      algorithms::Algorithms parallel_;
+
+      /// accents that run in order, one phase at a time
+      algorithms::Algorithms serial_;
+
+      /// protects the fields below
+      std::mutex lock_;
+
+      /// signals workers that a phase is ready or that they should exit
+      std::condition_variable work_ready_;
+
+      /// signals run that the concurrent group has finished
+      std::condition_variable work_done_;
+
+      /// the index of the next concurrent accent to claim
+      size_t next_;
+
+      /// the number of concurrent accents that have not finished
+      size_t remaining_;
+
+      /// true if workers should exit
+      bool terminated_;
+    };
+  }
+}
+
+#endif // _GAMS_CONTROLLERS_ACCENTPOOL_H_
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+#include "AlgorithmCache.h"
+
+#include <functional>
+
+#include "gams/loggers/GlobalLogger.h"
+
+gams::controllers::AlgorithmCache::AlgorithmCache (size_t max_size)
+  : max_size_ (max_size)
+{
+}
+
+gams::controllers::AlgorithmCache::~AlgorithmCache ()
+{
+  clear ();
+}
+
+void
+gams::controllers::AlgorithmCache::set_max_size (size_t max_size)
+{
+  max_size_ = max_size;
+
+  while (entries_.size () > max_size_)
+  {
+    delete entries_.back ().algorithm;
+    entries_.pop_back ();
+  }
+}
+
+size_t
+gams::controllers::AlgorithmCache::get_max_size (void) const
+{
+  return max_size_;
+}
+
+size_t
+gams::controllers::AlgorithmCache::size (void) const
+{
+  return entries_.size ();
+}
+
+std::string
+gams::controllers::AlgorithmCache::key (const std::string & name,
+  const madara::knowledge::KnowledgeMap & args)
+{
+  // KnowledgeMap is ordered, so the key is independent of insertion order
+  std::string result (name);
+
+  for (madara::knowledge::KnowledgeMap::const_iterator i = args.begin ();
+    i != args.end (); ++i)
+  {
+    result += '\n';
+    result += i->first;
+    result += '=';
+    result += i->second.to_string ();
+  }
+
+  return result;
+}
+
+gams::algorithms::BaseAlgorithm *
+gams::controllers::AlgorithmCache::take (const std::string & name,
+  const madara::knowledge::KnowledgeMap & args)
+{
+  if (entries_.empty ())
+  {
+    return 0;
+  }
+
+  std::string lookup (key (name, args));
+  size_t hash = std::hash <std::string> () (lookup);
+
+  for (std::list <Entry>::iterator i = entries_.begin ();
+    i != entries_.end (); ++i)
+  {
+    if (i->hash == hash && i->key == lookup)
+    {
+      algorithms::BaseAlgorithm * result = i->algorithm;
+      entries_.erase (i);
+
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::AlgorithmCache::take:" \
+        " found cached %s algorithm\n", name.c_str ());
+
+      return result;
+    }
+  }
+
+  return 0;
+}
+
+void
+gams::controllers::AlgorithmCache::put (const std::string & name,
+  const madara::knowledge::KnowledgeMap & args,
+  algorithms::BaseAlgorithm * algorithm)
+{
+  if (max_size_ == 0)
+  {
+    delete algorithm;
+    return;
+  }
+
+  Entry entry;
+  entry.key = key (name, args);
+  entry.hash = std::hash <std::string> () (entry.key);
+  entry.algorithm = algorithm;
+
+  entries_.push_front (entry);
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::controllers::AlgorithmCache::put:" \
+    " caching %s algorithm (%d cached)\n",
+    name.c_str (), (int)entries_.size ());
+
+  while (entries_.size () > max_size_)
+  {
+    delete entries_.back ().algorithm;
+    entries_.pop_back ();
+  }
+}
+
+void
+gams::controllers::AlgorithmCache::clear (void)
+{
+  for (std::list <Entry>::iterator i = entries_.begin ();
+    i != entries_.end (); ++i)
+  {
+    delete i->algorithm;
+  }
+
+  entries_.clear ();
+}
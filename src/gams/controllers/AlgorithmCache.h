@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file AlgorithmCache.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a cache of recently used algorithm instances
+ **/
+
+#ifndef   _GAMS_CONTROLLERS_ALGORITHMCACHE_H_
+#define   _GAMS_CONTROLLERS_ALGORITHMCACHE_H_
+
+#include <list>
+#include <string>
+
+#include "gams/GamsExport.h"
+#include "gams/algorithms/BaseAlgorithm.h"
+
+#include "madara/knowledge/KnowledgeRecord.h"
+
+namespace gams
+{
+  namespace controllers
+  {
+    /**
+     * A least-recently-used cache of algorithm instances keyed by the
+     * algorithm name and a hash of its arguments. The controller parks its
+     * current algorithm here, if it is BaseAlgorithm::reusable, when a new
+     * one is commanded, so switching
+     * back to a recent configuration reuses the initialized instance
+     * instead of constructing it again. The cache owns its algorithms.
+     **/
+    class GAMS_EXPORT AlgorithmCache
+    {
+    public:
+      /**
+       * Constructor
+       * @param  max_size   the maximum number of cached algorithms
+       **/
+      AlgorithmCache (size_t max_size = 0);
+
+      /**
+       * Destructor. Deletes all cached algorithms.
+       **/
+      ~AlgorithmCache ();
+
+      /**
+       * Sets the maximum number of cached algorithms, deleting the least
+       * recently used algorithms if necessary
+       * @param  max_size   the maximum number of cached algorithms
+       **/
+      void set_max_size (size_t max_size);
+
+      /**
+       * Returns the maximum number of cached algorithms
+       * @return  the maximum size of the cache
+       **/
+      size_t get_max_size (void) const;
+
+      /**
+       * Returns the number of cached algorithms
+       * @return  the number of cached algorithms
+       **/
+      size_t size (void) const;
+
+      /**
+       * Removes an algorithm from the cache
+       * @param  name   the name of the algorithm
+       * @param  args   the arguments the algorithm was created with
+       * @return  the cached algorithm, or 0 if none matched. The caller
+       *          takes ownership.
+       **/
+      algorithms::BaseAlgorithm * take (const std::string & name,
+        const madara::knowledge::KnowledgeMap & args);
+
+      /**
+       * Adds an algorithm to the cache. If the cache is full, the least
+       * recently used algorithm is deleted. If the cache is disabled
+       * (max size of 0), the algorithm is deleted immediately.
+       * @param  name       the name of the algorithm
+       * @param  args       the arguments the algorithm was created with
+       * @param  algorithm  the algorithm. The cache takes ownership.
+       **/
+      void put (const std::string & name,
+        const madara::knowledge::KnowledgeMap & args,
+        algorithms::BaseAlgorithm * algorithm);
+
+      /**
+       * Deletes all cached algorithms
+       **/
+      void clear (void);
+
+      /**
+       * Builds the lookup key for an algorithm name and arguments
+       * @param  name   the name of the algorithm
+       * @param  args   the arguments of the algorithm
+       * @return  a canonical string of the name and arguments
+       **/
+      static std::string key (const std::string & name,
+        const madara::knowledge::KnowledgeMap & args);
+
+    private:
+
+      /**
+       * A cached algorithm
+       **/
+      struct Entry
+      {
+        /// hash of key, compared before the full key
+        size_t hash;
+
+        /// canonical name and arguments
+        std::string key;
+
+        /// the cached algorithm
+        algorithms::BaseAlgorithm * algorithm;
+      };
+
+      /// cached algorithms, most recently used first
+      std::list <Entry> entries_;
+
+      /// the maximum number of cached algorithms
+      size_t max_size_;
+    };
+  }
+}
+
+#endif // _GAMS_CONTROLLERS_ALGORITHMCACHE_H_
@@ -54,8 +54,16 @@
 #include "gams/platforms/PlatformFactoryRepository.h"
 #include "gams/loggers/GlobalLogger.h"
 #include "gams/groups/GroupFactoryRepository.h"
+#include "gams/time/ModelsOfComputation.h"
 #include "madara/utility/EpochEnforcer.h"
 
+#include <algorithm>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 // Java-specific header includes
 #ifdef _GAMS_JAVA_
 #include "gams/algorithms/java/JavaAlgorithm.h"
@@ -68,14 +76,72 @@ typedef  madara::knowledge::KnowledgeRecord::Integer  Integer;
 typedef  madara::utility::EpochEnforcer<
   std::chrono::steady_clock> EpochEnforcer;
 
+namespace
+{
+  /**
+   * Holds the context lock for a MAPE cycle, unless the controller
+   * leaves locking to the individual knowledge base accesses
+   **/
+  class CycleGuard
+  {
+  public:
+    CycleGuard (madara::knowledge::KnowledgeBase & knowledge, bool locked)
+      : knowledge_ (knowledge), locked_ (locked), held_ (locked)
+    {
+      if (locked_)
+        knowledge_.lock ();
+    }
+
+    ~CycleGuard ()
+    {
+      if (locked_ && held_)
+        knowledge_.unlock ();
+    }
+
+    /// releases the lock until acquire is called
+    void release (void)
+    {
+      if (locked_ && held_)
+      {
+        knowledge_.unlock ();
+        held_ = false;
+      }
+    }
+
+    /// retakes the lock after release
+    void acquire (void)
+    {
+      if (locked_ && !held_)
+      {
+        knowledge_.lock ();
+        held_ = true;
+      }
+    }
+
+  private:
+    madara::knowledge::KnowledgeBase & knowledge_;
+    bool locked_;
+    bool held_;
+  };
+}
+
 gams::controllers::BaseController::BaseController (
   madara::knowledge::KnowledgeBase & knowledge,
   const ControllerSettings & settings)
   : algorithm_ (0), knowledge_ (knowledge), platform_ (0),
-  settings_ (settings), checkpoint_count_ (0)
+  settings_ (settings), checkpoint_count_ (0),
+  checkpoint_writer_ (0),
+  stats_ (0), sense_thread_ (0),
+  accent_pool_ (0), accents_changed_ (true), parallel_accents_ (false),
+  lock_cycle_ (true), algorithm_cache_ (settings.algorithm_cache_size)
 {
   init_vars (settings_.agent_prefix);
 
+  if (settings_.virtual_time)
+  {
+    gams::time::VirtualClock::enable ();
+  }
+
   // setup the platform and algorithm global repositories
   platforms::global_platform_factory()->set_knowledge (&knowledge);
   platforms::global_platform_factory()->set_platforms (&platforms_);
@@ -99,22 +165,41 @@ gams::controllers::BaseController::BaseController (
 
 gams::controllers::BaseController::~BaseController ()
 {
+  if (checkpoint_writer_)
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_MAJOR,
+      "gams::controllers::BaseController::destructor:" \
+      " writing queued checkpoints.\n");
+
+    delete checkpoint_writer_;
+  }
+
+  delete stats_;
+
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::destructor:" \
     " deleting algorithm.\n");
   delete algorithm_;
+  algorithm_cache_.clear ();
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::destructor:" \
     " deleting platform.\n");
+  // the sense thread must not outlive the platform it senses
+  delete sense_thread_;
+  sense_thread_ = 0;
+
   delete platform_;
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::destructor:" \
     " deleting accents.\n");
+  delete accent_pool_;
+
   for (algorithms::Algorithms::iterator i = accents_.begin ();
     i != accents_.end (); ++i)
   {
@@ -143,18 +228,42 @@ gams::controllers::BaseController::monitor (void)
 
   if (platform_)
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::BaseController::monitor:" \
-      " calling platform_->sense ()\n");
+    if (settings_.sense_hertz > 0 && platform_->supports_sense_sample ())
+    {
+      if (!sense_thread_)
+      {
+        sense_thread_ = new platforms::PlatformSenseThread (
+          *platform_, settings_.sense_hertz);
+      }
 
-    try {
-      result = platform_->sense ();
-    } catch (std::exception &e) {
+      // blocking platform I/O happens on the sense thread. Only the
+      // latest sample is copied in while the context is locked.
+      platforms::PlatformSample sample;
+      if (sense_thread_->take (sample))
+      {
+        madara_logger_ptr_log (gams::loggers::global_logger.get (),
+          gams::loggers::LOG_DETAILED,
+          "gams::controllers::BaseController::monitor:" \
+          " applying sample from sense thread\n");
+
+        platform_->apply_sample (sample);
+      }
+    }
+    else
+    {
       madara_logger_ptr_log (gams::loggers::global_logger.get (),
         gams::loggers::LOG_MAJOR,
-        "gams::controllers::BaseController::analyze:" \
-        " exception in platform_->sense (): %s\n", e.what());
+        "gams::controllers::BaseController::monitor:" \
+        " calling platform_->sense ()\n");
+
+      try {
+        result = platform_->sense ();
+      } catch (std::exception &e) {
+        madara_logger_ptr_log (gams::loggers::global_logger.get (),
+          gams::loggers::LOG_MAJOR,
+          "gams::controllers::BaseController::analyze:" \
+          " exception in platform_->sense (): %s\n", e.what());
+      }
     }
   }
   else
@@ -165,6 +274,12 @@ gams::controllers::BaseController::monitor (void)
       " Platform undefined. Unable to call platform_->sense ()\n");
   }
 
+  // copied after sensing so the snapshot includes this agent's location
+  if (swarm_snapshot_needed_ ())
+  {
+    swarm_snapshot_.update ();
+  }
+
   return result;
 }
 
@@ -386,11 +501,7 @@ gams::controllers::BaseController::analyze (void)
       gams::loggers::LOG_MAJOR,
       "gams::controllers::BaseController::analyze:" \
       " calling analyze on accents\n");
-    for (algorithms::Algorithms::iterator i = accents_.begin ();
-      i != accents_.end (); ++i)
-    {
-      (*i)->analyze ();
-    }
+    run_accents_ (MAPE_PHASE_ANALYZE);
   }
 
   return return_value;
@@ -432,11 +543,7 @@ gams::controllers::BaseController::plan (void)
       "gams::controllers::BaseController::plan:" \
       " calling plan on accents\n");
 
-    for (algorithms::Algorithms::iterator i = accents_.begin ();
-      i != accents_.end (); ++i)
-    {
-      (*i)->plan ();
-    }
+    run_accents_ (MAPE_PHASE_PLAN);
   }
 
   return return_value;
@@ -473,10 +580,16 @@ gams::controllers::BaseController::execute (void)
 
   if (accents_.size () > 0)
   {
-    for (algorithms::Algorithms::iterator i = accents_.begin ();
-      i != accents_.end (); ++i)
+    run_accents_ (MAPE_PHASE_EXECUTE);
+  }
+
+  // publish the sensor cells written during this cycle
+  for (variables::Sensors::iterator i = sensors_.begin ();
+    i != sensors_.end (); ++i)
+  {
+    if (i->second)
     {
-      (*i)->execute ();
+      i->second->sync ();
     }
   }
 
@@ -495,10 +608,28 @@ gams::controllers::BaseController::run_once_ (void)
     " calling monitor ()\n");
 
   // lock the context from any external updates
-  madara::knowledge::ContextGuard guard (knowledge_);
+  CycleGuard guard (knowledge_, lock_cycle_);
+
+  if (!stats_ && settings_.stats_hertz > 0)
+  {
+    stats_ = new MapeStatistics (knowledge_, self_.agent.prefix,
+      settings_.stats_hertz, settings_.stats_file_prefix,
+      settings_.stats_file_format);
+  }
+
+  madara::utility::TimeValue phase_start, phase_end;
+
+  if (stats_)
+    phase_start = madara::utility::Clock::now ();
 
   return_value |= monitor ();
 
+  if (stats_)
+  {
+    phase_end = madara::utility::Clock::now ();
+    stats_->record (MAPE_PHASE_MONITOR, phase_start, phase_end);
+  }
+
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::run:" \
@@ -515,8 +646,17 @@ gams::controllers::BaseController::run_once_ (void)
     "gams::controllers::BaseController::run:" \
     " calling analyze ()\n");
 
+  if (stats_)
+    phase_start = madara::utility::Clock::now ();
+
   return_value |= analyze ();
 
+  if (stats_)
+  {
+    phase_end = madara::utility::Clock::now ();
+    stats_->record (MAPE_PHASE_ANALYZE, phase_start, phase_end);
+  }
+
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::run:" \
@@ -533,8 +673,32 @@ gams::controllers::BaseController::run_once_ (void)
     "gams::controllers::BaseController::run:" \
     " calling plan ()\n");
 
+  if (stats_)
+    phase_start = madara::utility::Clock::now ();
+
   return_value |= plan ();
 
+  if (parallel_accents_)
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_MINOR,
+      "gams::controllers::BaseController::run:" \
+      " analyzing and planning %d concurrent accents\n",
+      (int)accent_pool_->get_num_parallel ());
+
+    // the workers access the knowledge base from their own threads. The
+    // pool returns once all of them have planned, before execute.
+    guard.release ();
+    accent_pool_->run_parallel ();
+    guard.acquire ();
+  }
+
+  if (stats_)
+  {
+    phase_end = madara::utility::Clock::now ();
+    stats_->record (MAPE_PHASE_PLAN, phase_start, phase_end);
+  }
+
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::run:" \
@@ -551,8 +715,22 @@ gams::controllers::BaseController::run_once_ (void)
     "gams::controllers::BaseController::run:" \
     " calling execute ()\n");
 
+  if (stats_)
+    phase_start = madara::utility::Clock::now ();
+
   return_value |= execute ();
 
+  if (stats_)
+  {
+    phase_end = madara::utility::Clock::now ();
+    stats_->record (MAPE_PHASE_EXECUTE, phase_start, phase_end);
+  }
+
+  if (settings_.packed_status)
+  {
+    pack_status_ ();
+  }
+
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::run:" \
@@ -564,9 +742,152 @@ gams::controllers::BaseController::run_once_ (void)
     "gams::controllers::BaseController::run: modifieds=%s\n",
     knowledge_.debug_modifieds ().c_str ());
 
+  if (stats_)
+  {
+    stats_->publish_if_due ();
+  }
+
   return return_value;
 }
 
+void
+gams::controllers::BaseController::pack_status_ (void)
+{
+  if (algorithm_)
+  {
+    variables::AlgorithmStatus * status = algorithm_->get_algorithm_status ();
+    if (!status->is_packed ())
+      status->set_packed (true);
+    status->pack ();
+  }
+
+  if (platform_)
+  {
+    variables::PlatformStatus * status = platform_->get_platform_status ();
+    if (!status->is_packed ())
+      status->set_packed (true);
+    status->pack ();
+  }
+}
+
+void
+gams::controllers::BaseController::init_agents_ (void)
+{
+  agents_.resize (agent_views_.size ());
+
+  for (size_t i = 0; i < agent_views_.size (); ++i)
+  {
+    if (settings_.lazy_agents)
+    {
+      // only the prefix is kept. Containers are bound through the views.
+      agents_[i] = variables::Agent ();
+      agents_[i].prefix = agent_views_[i].get_prefix ();
+    }
+    else
+    {
+      agents_[i].init_vars (knowledge_, agent_views_[i].get_prefix ());
+    }
+  }
+
+  swarm_snapshot_.set_history_length (settings_.trajectory_length);
+  swarm_snapshot_.init (knowledge_, agents_);
+}
+
+bool
+gams::controllers::BaseController::prepare_accent_pool_ (void)
+{
+  if (settings_.accent_threads == 0 || accents_.size () < 2)
+  {
+    return false;
+  }
+
+  if (!accent_pool_)
+  {
+    accent_pool_ = new AccentPool (settings_.accent_threads);
+    accents_changed_ = true;
+  }
+
+  if (accents_changed_)
+  {
+    accent_pool_->set_accents (accents_);
+    accents_changed_ = false;
+  }
+
+  return accent_pool_->get_num_parallel () > 1;
+}
+
+bool
+gams::controllers::BaseController::swarm_snapshot_needed_ (void) const
+{
+  if (settings_.trajectory_length > 0 ||
+    (algorithm_ && algorithm_->uses_swarm_snapshot ()))
+  {
+    return true;
+  }
+
+  for (algorithms::Algorithms::const_iterator i = accents_.begin ();
+    i != accents_.end (); ++i)
+  {
+    if ((*i)->uses_swarm_snapshot ())
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void
+gams::controllers::BaseController::run_accents_ (int phase)
+{
+  // the concurrent group is analyzed and planned on the pool in
+  // run_once_, and executed here after the in-order group
+  if (parallel_accents_)
+  {
+    accent_pool_->run_serial (phase);
+
+    if (phase == MAPE_PHASE_EXECUTE)
+    {
+      accent_pool_->execute_parallel ();
+    }
+    return;
+  }
+
+  for (algorithms::Algorithms::iterator i = accents_.begin ();
+    i != accents_.end (); ++i)
+  {
+    if (phase == MAPE_PHASE_ANALYZE)
+    {
+      (*i)->analyze ();
+    }
+    else if (phase == MAPE_PHASE_PLAN)
+    {
+      (*i)->plan ();
+    }
+    else
+    {
+      (*i)->execute ();
+    }
+  }
+}
+
+void
+gams::controllers::BaseController::send_modifieds_ (void)
+{
+  if (stats_)
+  {
+    madara::utility::TimeValue start = madara::utility::Clock::now ();
+
+    knowledge_.send_modifieds ();
+
+    stats_->record (MAPE_PHASE_SEND, start, madara::utility::Clock::now ());
+  }
+  else
+  {
+    knowledge_.send_modifieds ();
+  }
+}
+
 int
 gams::controllers::BaseController::run_once (void)
 {
@@ -579,7 +900,7 @@ gams::controllers::BaseController::run_once (void)
     " sending updates\n");
 
   // send modified values through network
-  knowledge_.send_modifieds ();
+  send_modifieds_ ();
 
   return return_value;
 }
@@ -620,8 +941,88 @@ gams::controllers::BaseController::save_checkpoint (void)
     filename << checkpoint_prefix << checkpoint_count_ << ".kb";
     checkpoint_settings.filename = filename.str ();
 
+    // check if the user wants the checkpoint written in the background
+    if (CHECKPOINT_ASYNC & settings_.checkpoint_strategy)
+    {
+      // the writer starts from a copy of the whole context
+      const bool first (checkpoint_writer_ == 0);
+
+      if (first)
+      {
+        const std::string local_prefix (
+          "." + self_.agent.prefix + ".checkpoint");
+
+        checkpoints_queued_.set_name (local_prefix + ".queued", knowledge_);
+        checkpoints_written_.set_name (local_prefix + ".written", knowledge_);
+        checkpoints_dropped_.set_name (local_prefix + ".dropped", knowledge_);
+        checkpoints_merged_.set_name (local_prefix + ".merged", knowledge_);
+
+        checkpoint_writer_ = new CheckpointWriter (
+          settings_.checkpoint_queue_length,
+          settings_.checkpoint_overflow_policy);
+      }
+
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::run:" \
+        " queuing checkpoint for %s%d.kb\n",
+        checkpoint_prefix.c_str (), checkpoint_count_);
+
+      // only records changed since the last checkpoint are copied. The
+      // writer thread keeps the accumulated state and does serialization.
+      madara::knowledge::KnowledgeMap changes;
+
+      {
+        madara::knowledge::ThreadSafeContext & context (
+          knowledge_.get_context ());
+        madara::knowledge::ContextGuard guard (context);
+
+        if (first)
+        {
+          changes = context.get_map_unsafe ();
+        }
+        else
+        {
+          // the records pending a send, plus the records knowledge_
+          // .save_checkpoint would write as diffs
+          const madara::knowledge::KnowledgeRecords & modifieds (
+            context.get_modifieds ());
+          const madara::knowledge::KnowledgeRecords & local_modifieds (
+            context.get_local_modified ());
+
+          for (madara::knowledge::KnowledgeRecords::const_iterator i =
+            modifieds.begin (); i != modifieds.end (); ++i)
+          {
+            changes[i->first] = *i->second;
+          }
+
+          for (madara::knowledge::KnowledgeRecords::const_iterator i =
+            local_modifieds.begin (); i != local_modifieds.end (); ++i)
+          {
+            changes[i->first] = *i->second;
+          }
+        }
+
+        context.reset_checkpoint ();
+      }
+
+      int result = checkpoint_writer_->enqueue (checkpoint_settings.filename,
+        changes, (CHECKPOINT_SAVE_DIFFS & settings_.checkpoint_strategy) != 0);
+
+      checkpoints_queued_ = checkpoint_writer_->get_queued ();
+      checkpoints_written_ = checkpoint_writer_->get_written ();
+      checkpoints_dropped_ = checkpoint_writer_->get_dropped ();
+      checkpoints_merged_ = checkpoint_writer_->get_merged ();
+
+      // merged and dropped checkpoints do not use up a file name
+      if (result != CHECKPOINT_QUEUED)
+      {
+        return;
+      }
+    }
+
     // check if the user wants diffs saved
-    if (CHECKPOINT_SAVE_DIFFS & settings_.checkpoint_strategy)
+    else if (CHECKPOINT_SAVE_DIFFS & settings_.checkpoint_strategy)
     {
       madara_logger_ptr_log (gams::loggers::global_logger.get (),
         gams::loggers::LOG_MAJOR,
@@ -667,20 +1068,28 @@ gams::controllers::BaseController::save_checkpoint (void)
 
 }
 
+void
+gams::controllers::BaseController::flush_checkpoints (void)
+{
+  if (checkpoint_writer_)
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_MAJOR,
+      "gams::controllers::BaseController::flush_checkpoints:" \
+      " waiting for queued checkpoints to be written\n");
+
+    checkpoint_writer_->flush ();
+
+    checkpoints_written_ = checkpoint_writer_->get_written ();
+  }
+}
+
 int
 gams::controllers::BaseController::run (double loop_period,
   double max_runtime, double send_period)
 {
   // return value
   int return_value (0);
-  bool first_execute (true);
-
-  // for checking for potential user commands
-  double loop_hz = 1.0 / loop_period;
-  double send_hz = 1.0 / send_period;
-
-  self_.agent.loop_hz = loop_hz;
-  self_.agent.send_hz = send_hz;
 
   // if user specified non-positive, then we are to use loop_period
   if (send_period <= 0)
@@ -688,22 +1097,21 @@ gams::controllers::BaseController::run (double loop_period,
     send_period = loop_period;
   }
 
-  madara::utility::TimeValue current = madara::utility::Clock::now ();
-  madara::utility::Duration loop_window =
-    madara::utility::seconds_to_duration (loop_period);
-  madara::utility::Duration send_window =
-    madara::utility::seconds_to_duration (send_period);
-  madara::utility::TimeValue next_loop = current + loop_window;
-  madara::utility::TimeValue next_send = current + send_window;
-  madara::utility::TimeValue end_time = current +
-    madara::utility::seconds_to_duration (max_runtime);
+  // for checking for potential user commands. 0hz is infinite hertz.
+  self_.agent.loop_hz = loop_period > 0 ? 1.0 / loop_period : 0.0;
+  self_.agent.send_hz = send_period > 0 ? 1.0 / send_period : 0.0;
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::BaseController::run:" \
     " loop_period: %fs, max_runtime: %fs, send_period: %fs\n",
     loop_period, max_runtime, send_period);
-  
+
+  if (loop_period < 0.0)
+  {
+    return return_value;
+  }
+
   save_checkpoint ();
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
@@ -712,137 +1120,509 @@ gams::controllers::BaseController::run (double loop_period,
     " calling system_analyze ()\n");
   return_value |= system_analyze ();
 
-  if (loop_period >= 0.0)
+  configure_loop_thread_ ();
+
+  // simulated time steps the loop without sleeping or waiting for triggers
+  if (settings_.virtual_time && loop_period > 0.0)
   {
-    //unsigned int iterations = 0;
-    while (first_execute || max_runtime < 0 || current < end_time)
-    {
-      // return value should be last return value of mape loop
-      return_value = run_once_ ();
+    gams::time::SynchronousRounds rounds (loop_period, send_period);
+    rounds.add (this);
 
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_MAJOR,
-        "gams::controllers::BaseController::run:" \
-        " calling system_analyze ()\n");
-      return_value |= system_analyze ();
+    return rounds.run (max_runtime);
+  }
 
-      if (CHECKPOINT_EVERY_LOOP & settings_.checkpoint_strategy)
-      {
-        save_checkpoint ();
-      }
+  if (settings_.wait_for_triggers && loop_period > 0.0)
+  {
+    TriggerWatcher watcher (knowledge_);
+    init_triggers_ (watcher);
 
-      current = madara::utility::Clock::now ();
+    return run_loop_ (loop_period, max_runtime, send_period, &watcher);
+  }
 
-      // run will always try to send at least once
-      if (first_execute || current > next_send)
-      {
-        madara_logger_ptr_log (gams::loggers::global_logger.get (),
-          gams::loggers::LOG_MAJOR,
-          "gams::controllers::BaseController::run:" \
-          " sending updates\n");
+  return run_loop_ (loop_period, max_runtime, send_period, 0);
+}
+
+void
+gams::controllers::BaseController::configure_loop_thread_ (void)
+{
+  if (settings_.loop_priority >= 0)
+  {
+#ifndef _WIN32
+    sched_param param;
+    param.sched_priority = settings_.loop_priority;
+
+    int result = pthread_setschedparam (pthread_self (), SCHED_FIFO, &param);
+
+    if (result != 0)
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_ERROR,
+        "gams::controllers::BaseController::configure_loop_thread_:" \
+        " unable to set real-time priority %d (error %d). Check"
+        " permissions (e.g., CAP_SYS_NICE or rtprio limits).\n",
+        settings_.loop_priority, result);
+    }
+    else
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::configure_loop_thread_:" \
+        " running with SCHED_FIFO priority %d\n",
+        settings_.loop_priority);
+    }
+#else
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_WARNING,
+      "gams::controllers::BaseController::configure_loop_thread_:" \
+      " real-time priorities are not supported on this platform\n");
+#endif
+  }
+
+  if (settings_.loop_cpu >= 0)
+  {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO (&cpus);
+    CPU_SET (settings_.loop_cpu, &cpus);
+
+    int result = pthread_setaffinity_np (
+      pthread_self (), sizeof (cpu_set_t), &cpus);
+
+    if (result != 0)
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_ERROR,
+        "gams::controllers::BaseController::configure_loop_thread_:" \
+        " unable to pin controller to cpu %d (error %d)\n",
+        settings_.loop_cpu, result);
+    }
+    else
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::configure_loop_thread_:" \
+        " pinned controller to cpu %d\n",
+        settings_.loop_cpu);
+    }
+#else
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_WARNING,
+      "gams::controllers::BaseController::configure_loop_thread_:" \
+      " cpu affinity is not supported on this platform\n");
+#endif
+  }
+}
+
+int
+gams::controllers::BaseController::run_cycle_ (void)
+{
+  // concurrent accents are analyzed and planned while run_once_ releases
+  // the context. Only the controller's own loops do this, since callers
+  // of run_once may hold the context themselves.
+  parallel_accents_ = prepare_accent_pool_ ();
+
+  // return value should be last return value of mape loop
+  int return_value = run_once_ ();
+
+  parallel_accents_ = false;
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::controllers::BaseController::run_cycle_:" \
+    " calling system_analyze ()\n");
+  return_value |= system_analyze ();
+
+  return return_value;
+}
+
+int
+gams::controllers::BaseController::run_loop_ (double loop_period,
+  double max_runtime, double send_period, TriggerWatcher * triggers)
+{
+  // return value
+  int return_value (0);
+  bool first_execute (true);
+
+  // overruns, jitter and deadlines only apply to the release grid of a
+  // scheduler policy
+  const bool scheduled =
+    !triggers && settings_.scheduler_policy != SCHEDULE_DEFAULT;
+
+  // for checking for potential user commands
+  double loop_hz = self_.agent.loop_hz.to_double ();
+  double send_hz = self_.agent.send_hz.to_double ();
+
+  // the send period currently in use, which grows under load
+  double adapted_send_period = send_period;
+
+  if (loop_overruns_.get_name () == "")
+  {
+    const std::string local_prefix ("." + self_.agent.prefix + ".loop");
+
+    loop_overruns_.set_name (local_prefix + ".overruns", knowledge_);
+    loop_skipped_.set_name (local_prefix + ".skipped", knowledge_);
+    loop_jitter_.set_name (local_prefix + ".jitter", knowledge_);
+    loop_max_jitter_.set_name (local_prefix + ".max_jitter", knowledge_);
+    loop_cycle_time_.set_name (local_prefix + ".cycle_time", knowledge_);
+    loop_send_hz_.set_name (local_prefix + ".send_hz", knowledge_);
+    loop_wakeups_.set_name (local_prefix + ".wakeups", knowledge_);
+    loop_timeouts_.set_name (local_prefix + ".timeouts", knowledge_);
+  }
+
+  Integer overruns (0), skipped (0), wakeups (0), timeouts (0);
+  Integer overruns_at_last_send (0);
+  int catch_up (0);
+  double max_jitter (0);
+
+  const madara::utility::Duration zero (madara::utility::Duration::zero ());
 
-        if (CHECKPOINT_EVERY_SEND & settings_.checkpoint_strategy)
+  madara::utility::TimeValue current = madara::utility::Clock::now ();
+  madara::utility::Duration loop_window =
+    madara::utility::seconds_to_duration (loop_period);
+  madara::utility::Duration send_window =
+    madara::utility::seconds_to_duration (send_period);
+  madara::utility::Duration wait_window =
+    madara::utility::seconds_to_duration (settings_.max_trigger_wait > 0 ?
+      settings_.max_trigger_wait : loop_period);
+  madara::utility::TimeValue release = current;
+  madara::utility::TimeValue next_send = current;
+  madara::utility::TimeValue end_time = current +
+    madara::utility::seconds_to_duration (max_runtime);
+
+  if (triggers)
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_MAJOR,
+      "gams::controllers::BaseController::run_loop_:" \
+      " waiting on %d triggers for at most %fs\n",
+      (int)triggers->size (),
+      std::chrono::duration<double> (wait_window).count ());
+  }
+  else
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_MAJOR,
+      "gams::controllers::BaseController::run_loop_:" \
+      " scheduler policy %d, deadline policy %d, adaptive send %d\n",
+      settings_.scheduler_policy, settings_.deadline_policy,
+      (int)settings_.adaptive_send);
+  }
+
+  while (first_execute || max_runtime < 0 || current < end_time)
+  {
+    madara::utility::TimeValue cycle_start = madara::utility::Clock::now ();
+
+    // the deadline is the first release after the cycle started, so
+    // cycles that start late to catch up are not overruns themselves
+    madara::utility::TimeValue deadline = release + loop_window;
+
+    while (loop_window > zero && deadline <= cycle_start)
+    {
+      deadline += loop_window;
+    }
+
+    double jitter = std::chrono::duration<double> (
+      cycle_start - release).count ();
+
+    if (jitter > max_jitter)
+    {
+      max_jitter = jitter;
+    }
+
+    return_value = run_cycle_ ();
+
+    current = madara::utility::Clock::now ();
+
+    bool overrun = scheduled && loop_window > zero && current > deadline;
+
+    if (overrun)
+    {
+      ++overruns;
+
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MINOR,
+        "gams::controllers::BaseController::run_loop_:" \
+        " cycle missed its deadline by %fs\n",
+        std::chrono::duration<double> (current - deadline).count ());
+    }
+
+    // with hard deadlines, late cycles shed optional work
+    bool shed = overrun && settings_.deadline_policy == DEADLINE_HARD &&
+      !first_execute;
+
+    if ((CHECKPOINT_EVERY_LOOP & settings_.checkpoint_strategy) && !shed)
+    {
+      save_checkpoint ();
+    }
+
+    // run will always try to send at least once. Deferred sends happen
+    // on the next cycle that meets its deadline, but are never deferred
+    // by more than one send period.
+    if ((first_execute || current >= next_send) &&
+      (!shed || current >= next_send + send_window))
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::run_loop_:" \
+        " sending updates\n");
+
+      if (CHECKPOINT_EVERY_SEND & settings_.checkpoint_strategy)
+      {
+        save_checkpoint ();
+      }
+
+      // send modified values through network
+      send_modifieds_ ();
+
+      if (scheduled && settings_.adaptive_send && send_period > 0)
+      {
+        double previous = adapted_send_period;
+
+        // back off while the loop is overrunning, recover when it is not
+        if (overruns > overruns_at_last_send)
         {
-          save_checkpoint ();
+          adapted_send_period = std::min (adapted_send_period * 2,
+            send_period * 8);
+        }
+        else
+        {
+          adapted_send_period = std::max (adapted_send_period / 2,
+            send_period);
         }
 
-        // send modified values through network
-        knowledge_.send_modifieds ();
-
-        // setup the next send epoch
-        if (send_period > 0)
+        if (adapted_send_period != previous)
         {
-          while (next_send <= current)
-          {
-            next_send += send_window;
-          }
+          madara_logger_ptr_log (gams::loggers::global_logger.get (),
+            gams::loggers::LOG_MAJOR,
+            "gams::controllers::BaseController::run_loop_:" \
+            " adapting send hertz from %.2f to %.2f\n",
+            1 / previous, 1 / adapted_send_period);
+
+          send_window =
+            madara::utility::seconds_to_duration (adapted_send_period);
         }
+
+        overruns_at_last_send = overruns;
+      }
+
+      // setup the next send epoch
+      while (send_window > zero && next_send <= current)
+      {
+        next_send += send_window;
       }
+    }
 
-      current = madara::utility::Clock::now ();
+    madara::utility::TimeValue cycle_end = madara::utility::Clock::now ();
 
-      // check to see if we need to sleep for next loop epoch
-      if (loop_period > 0.0 && (max_runtime < 0 || current < end_time))
+    if (triggers)
+    {
+      // changes made by this cycle should not wake the next one
+      triggers->changed ();
+    }
+
+    // run will always execute at least one time. Update flag for execution.
+    first_execute = false;
+
+    current = madara::utility::Clock::now ();
+
+    if (triggers)
+    {
+      if (max_runtime < 0 || current < end_time)
       {
+        // never wait past a pending send or the end of the run
+        madara::utility::TimeValue wake = current + wait_window;
+
+        if (next_send < wake)
+        {
+          wake = next_send;
+        }
+        if (max_runtime >= 0 && end_time < wake)
+        {
+          wake = end_time;
+        }
+
         madara_logger_ptr_log (gams::loggers::global_logger.get (),
           gams::loggers::LOG_MINOR,
-          "gams::controllers::BaseController::run:" \
-          " sleeping until next epoch\n");
+          "gams::controllers::BaseController::run_loop_:" \
+          " waiting for triggers\n");
 
-        std::this_thread::sleep_until (next_loop);
-
-        current = madara::utility::Clock::now ();
-        while (next_loop <= current)
+        if (triggers->wait (wake))
         {
-          next_loop += loop_window;
+          ++wakeups;
+        }
+        else
+        {
+          ++timeouts;
         }
-      }
 
-      // run will always execute at least one time. Update flag for execution.
-      if (first_execute)
-        first_execute = false;
+        loop_wakeups_ = wakeups;
+        loop_timeouts_ = timeouts;
+      }
 
-      current = madara::utility::Clock::now ();
+      // triggered cycles are released when they are woken
+      release = madara::utility::Clock::now ();
+    }
+    else if (loop_window > zero)
+    {
+      // compute the next release
+      release += loop_window;
 
-      // if send herz difference is more than .001 hz different, change epoch
-      if (!madara::utility::approx_equal (
-        send_hz, self_.agent.send_hz.to_double (), 0.001))
+      if (release <= current)
       {
-        madara_logger_ptr_log (gams::loggers::global_logger.get (),
-          gams::loggers::LOG_MAJOR,
-          "gams::controllers::BaseController::run:" \
-          " Changing send hertz from %.2f to %.2f\n", send_hz,
-          self_.agent.send_hz.to_double ());
-
-        send_hz = self_.agent.send_hz.to_double ();
-        send_period = 1 / send_hz;
+        if (scheduled && settings_.scheduler_policy == SCHEDULE_CATCH_UP &&
+          catch_up < settings_.max_catch_up)
+        {
+          // run the missed release immediately
+          ++catch_up;
+        }
+        else
+        {
+          // drop missed releases and stay on the release grid
+          while (release <= current)
+          {
+            release += loop_window;
+            ++skipped;
+          }
 
-        send_window = madara::utility::seconds_to_duration (send_period);
-        next_send = current + send_window;
+          catch_up = 0;
+        }
+      }
+      else
+      {
+        catch_up = 0;
       }
 
-      // if loop herz difference is more than .001 hz different, change epoch
-      if (!madara::utility::approx_equal (
-        loop_hz, self_.agent.loop_hz.to_double (), 0.001))
+      // check to see if we need to sleep for next loop epoch
+      if (release > current && (max_runtime < 0 || current < end_time))
       {
         madara_logger_ptr_log (gams::loggers::global_logger.get (),
-          gams::loggers::LOG_MAJOR,
-          "gams::controllers::BaseController::run:" \
-          " Changing loop hertz from %.2f to %.2f\n", loop_hz,
-          self_.agent.loop_hz.to_double ());
+          gams::loggers::LOG_MINOR,
+          "gams::controllers::BaseController::run_loop_:" \
+          " sleeping until next release\n");
 
-        loop_hz = self_.agent.loop_hz.to_double ();
-        loop_period = 1 / loop_hz;
-        
-        loop_window = madara::utility::seconds_to_duration (loop_period);
-        next_loop = current + loop_window;
+        std::this_thread::sleep_until (release);
       }
+    }
+    else
+    {
+      // infinite hertz loops are released again immediately
+      release = current;
+    }
+
+    if (scheduled)
+    {
+      loop_overruns_ = overruns;
+      loop_skipped_ = skipped;
+      loop_jitter_ = jitter;
+      loop_max_jitter_ = max_jitter;
+      loop_cycle_time_ = std::chrono::duration<double> (
+        cycle_end - cycle_start).count ();
+      loop_send_hz_ = adapted_send_period > 0 ? 1 / adapted_send_period : 0;
+    }
+
+    current = madara::utility::Clock::now ();
+
+    // if send herz difference is more than .001 hz different, change epoch
+    if (!madara::utility::approx_equal (
+      send_hz, self_.agent.send_hz.to_double (), 0.001))
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::run_loop_:" \
+        " Changing send hertz from %.2f to %.2f\n", send_hz,
+        self_.agent.send_hz.to_double ());
+
+      // non-positive send rates send with every loop
+      send_hz = self_.agent.send_hz.to_double ();
+      send_period = send_hz > 0 ? 1 / send_hz : loop_period;
+      adapted_send_period = send_period;
+
+      send_window = madara::utility::seconds_to_duration (send_period);
+      next_send = current + send_window;
+    }
 
-      // if our loop hertz is not fast enough for sending, change it
-      if (send_hz > loop_hz)
+    // if loop herz difference is more than .001 hz different, change epoch
+    if (!madara::utility::approx_equal (
+      loop_hz, self_.agent.loop_hz.to_double (), 0.001))
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::run_loop_:" \
+        " Changing loop hertz from %.2f to %.2f\n", loop_hz,
+        self_.agent.loop_hz.to_double ());
+
+      // non-positive loop rates run as fast as possible
+      loop_hz = self_.agent.loop_hz.to_double ();
+      loop_period = loop_hz > 0 ? 1 / loop_hz : 0;
+
+      loop_window = madara::utility::seconds_to_duration (loop_period);
+      release = current;
+      catch_up = 0;
+
+      if (settings_.max_trigger_wait <= 0)
       {
-        madara_logger_ptr_log (gams::loggers::global_logger.get (),
-          gams::loggers::LOG_MAJOR,
-          "gams::controllers::BaseController::run:" \
-          " Changing loop hertz from %.2f to %.2f\n", loop_hz,
-          send_hz);
+        wait_window = loop_window;
+      }
+    }
 
-        loop_hz = send_hz;
-        loop_period = 1 / loop_hz;
-        
-        loop_window = madara::utility::seconds_to_duration (loop_period);
-        next_loop = current + loop_window;
+    // if our loop hertz is not fast enough for sending, change it
+    if (loop_hz > 0 && send_hz > loop_hz)
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::run_loop_:" \
+        " Changing loop hertz from %.2f to %.2f\n", loop_hz,
+        send_hz);
+
+      loop_hz = send_hz;
+      loop_period = 1 / loop_hz;
 
-        // update container so others know we are changing rate
-        self_.agent.loop_hz = loop_hz;
+      loop_window = madara::utility::seconds_to_duration (loop_period);
+      release = current;
+      catch_up = 0;
+
+      if (settings_.max_trigger_wait <= 0)
+      {
+        wait_window = loop_window;
       }
 
+      // update container so others know we are changing rate
+      self_.agent.loop_hz = loop_hz;
     }
   }
 
   return return_value;
 }
 
+void
+gams::controllers::BaseController::init_triggers_ (TriggerWatcher & watcher)
+{
+  if (settings_.trigger_variables.size () > 0)
+  {
+    for (size_t i = 0; i < settings_.trigger_variables.size (); ++i)
+    {
+      watcher.add (settings_.trigger_variables[i]);
+    }
+  }
+  else
+  {
+    // commands to this agent and the swarm
+    watcher.add (self_.agent.algorithm.get_name ());
+    watcher.add (self_.agent.algorithm_id.get_name ());
+    watcher.add (swarm_.algorithm.get_name ());
+    watcher.add (swarm_.algorithm_id.get_name ());
+
+    // locations of peers
+    for (size_t i = 0; i < agents_.size (); ++i)
+    {
+      if (agents_[i].prefix != self_.agent.prefix)
+      {
+        watcher.add (agents_[i].prefix + ".location");
+      }
+    }
+  }
+}
+
 void
 gams::controllers::BaseController::init_accent (const std::string & algorithm,
 const madara::knowledge::KnowledgeMap & args)
@@ -879,7 +1659,10 @@ const madara::knowledge::KnowledgeMap & args)
 
     if (new_accent)
     {
+      new_accent->agent_views_ = settings_.lazy_agents ? &agent_views_ : 0;
+      new_accent->swarm_snapshot_ = &swarm_snapshot_;
       accents_.push_back (new_accent);
+      accents_changed_ = true;
     }
     else
     {
@@ -904,6 +1687,7 @@ void gams::controllers::BaseController::clear_accents (void)
   }
 
   accents_.clear ();
+  accents_changed_ = true;
 }
 void
 gams::controllers::BaseController::init_algorithm (
@@ -934,20 +1718,47 @@ const std::string & algorithm, const madara::knowledge::KnowledgeMap & args)
       "gams::controllers::BaseController::init_algorithm:" \
       " deleting old algorithm\n");
 
-    delete algorithm_;
+    retire_algorithm_ ();
 
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::BaseController::init_algorithm:" \
-      " factory is creating algorithm %s\n", algorithm.c_str ());
+    // reuse an instance built earlier with the same name and arguments
+    algorithm_ = algorithm_cache_.take (algorithm, args);
 
-    algorithms::global_algorithm_factory()->set_agents (&agents_);
-    algorithms::global_algorithm_factory()->set_knowledge (&knowledge_);
-    algorithms::global_algorithm_factory()->set_self (&self_);
-    algorithms::global_algorithm_factory()->set_sensors (&sensors_);
-    algorithms::global_algorithm_factory()->set_platform (platform_);
+    // the knowledge it was built from, such as a search area, may differ
+    if (algorithm_ && !algorithm_->reusable ())
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::init_algorithm:" \
+        " cached algorithm %s is stale, discarding it\n", algorithm.c_str ());
+
+      delete algorithm_;
+      algorithm_ = 0;
+    }
+
+    bool cached (algorithm_ != 0);
+
+    if (!cached)
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::BaseController::init_algorithm:" \
+        " factory is creating algorithm %s\n", algorithm.c_str ());
 
-    algorithm_ = algorithms::global_algorithm_factory()->create (algorithm, args);
+      algorithms::global_algorithm_factory()->set_agents (&agents_);
+      algorithms::global_algorithm_factory()->set_knowledge (&knowledge_);
+      algorithms::global_algorithm_factory()->set_self (&self_);
+      algorithms::global_algorithm_factory()->set_sensors (&sensors_);
+      algorithms::global_algorithm_factory()->set_platform (platform_);
+
+      algorithm_ = algorithms::global_algorithm_factory()->create (
+        algorithm, args);
+    }
+
+    if (algorithm_ != 0)
+    {
+      algorithm_name_ = algorithm;
+      algorithm_args_ = args;
+    }
 
     if (algorithm_ == 0)
     {
@@ -1013,10 +1824,38 @@ const std::string & algorithm, const madara::knowledge::KnowledgeMap & args)
 #else
       init_vars (*algorithm_);
 #endif
+
+      if (cached)
+      {
+        madara_logger_ptr_log (gams::loggers::global_logger.get (),
+          gams::loggers::LOG_MAJOR,
+          "gams::controllers::BaseController::init_algorithm:" \
+          " resetting cached algorithm %s\n", algorithm.c_str ());
+
+        algorithm_->reset ();
+      }
     }
   }
 }
 
+void
+gams::controllers::BaseController::retire_algorithm_ (void)
+{
+  // only algorithms that can restore their initial state are kept
+  if (algorithm_ && algorithm_name_ != "" && algorithm_->reusable ())
+  {
+    algorithm_cache_.put (algorithm_name_, algorithm_args_, algorithm_);
+  }
+  else
+  {
+    delete algorithm_;
+  }
+
+  algorithm_ = 0;
+  algorithm_name_ = "";
+  algorithm_args_.clear ();
+}
+
 void
 gams::controllers::BaseController::init_platform (
   const std::string & platform,
@@ -1046,6 +1885,10 @@ gams::controllers::BaseController::init_platform (
       "gams::controllers::BaseController::init_platform:" \
       " deleting old platform\n");
 
+    // the sense thread must not outlive the platform it senses
+    delete sense_thread_;
+    sense_thread_ = 0;
+
     delete platform_;
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
       gams::loggers::LOG_MAJOR,
@@ -1097,7 +1940,7 @@ void gams::controllers::BaseController::init_algorithm (algorithms::BaseAlgorith
     "gams::controllers::BaseController::init_algorithm:" \
     " deleting old algorithm\n");
 
-  delete algorithm_;
+  retire_algorithm_ ();
   algorithm_ = algorithm;
 
   if (algorithm_)
@@ -1126,6 +1969,10 @@ void gams::controllers::BaseController::init_platform (platforms::BasePlatform *
     "gams::controllers::BaseController::init_platform:" \
     " deleting old platform\n");
 
+  // the sense thread must not outlive the platform it senses
+  delete sense_thread_;
+  sense_thread_ = 0;
+
   delete platform_;
   platform_ = platform;
 
@@ -1171,6 +2018,17 @@ gams::controllers::BaseController::configure (
 {
   settings_ = settings;
 
+  algorithm_cache_.set_max_size (settings_.algorithm_cache_size);
+
+  // the pool is recreated on use with the new thread count
+  delete accent_pool_;
+  accent_pool_ = 0;
+
+  if (settings_.virtual_time)
+  {
+    gams::time::VirtualClock::enable ();
+  }
+
   if (settings_.madara_log_level >= 0)
   {
     self_.agent.madara_debug_level = settings_.madara_log_level;
@@ -1192,7 +2050,7 @@ void gams::controllers::BaseController::init_algorithm (jobject algorithm)
     "gams::controllers::BaseController::init_algorithm (java):" \
     " deleting old algorithm\n");
 
-  delete algorithm_;
+  retire_algorithm_ ();
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
@@ -1220,6 +2078,10 @@ void gams::controllers::BaseController::init_platform (jobject platform)
     "gams::controllers::BaseController::init_platform (java):" \
     " deleting old platform\n");
 
+  // the sense thread must not outlive the platform it senses
+  delete sense_thread_;
+  sense_thread_ = 0;
+
   delete platform_;
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
@@ -1299,7 +2161,8 @@ gams::controllers::BaseController::init_vars (
       " %s self, %s group\n",
       self_prefix.c_str (), group->get_prefix ().c_str ());
 
-    variables::init_vars (agents_, knowledge_, *group);
+    variables::init_vars (agent_views_, knowledge_, *group);
+    init_agents_ ();
   }
   else
   {
@@ -1337,7 +2200,8 @@ const Integer & processes)
     " %" PRId64 " id, %" PRId64 " processes\n", id, processes);
 
   // initialize the agents, swarm, and self variables
-  variables::init_vars (agents_, knowledge_, processes);
+  variables::init_vars (agent_views_, knowledge_, processes);
+  init_agents_ ();
   swarm_.init_vars (knowledge_, processes);
   self_.init_vars (knowledge_, id);
 
@@ -1378,10 +2242,12 @@ gams::controllers::BaseController::init_vars (algorithms::BaseAlgorithm & algori
     " initializing algorithm's vars\n");
 
   algorithm.agents_ = &agents_;
+  algorithm.agent_views_ = settings_.lazy_agents ? &agent_views_ : 0;
   algorithm.knowledge_ = &knowledge_;
   algorithm.platform_ = platform_;
   algorithm.self_ = &self_;
   algorithm.sensors_ = &sensors_;
+  algorithm.swarm_snapshot_ = &swarm_snapshot_;
 }
 
 gams::algorithms::BaseAlgorithm *
@@ -55,10 +55,17 @@
 #define   _GAMS_BASE_CONTROLLER_H_
 
 #include "ControllerSettings.h"
+#include "AccentPool.h"
+#include "AlgorithmCache.h"
+#include "CheckpointWriter.h"
+#include "MapeStatistics.h"
+#include "TriggerWatcher.h"
 
 #include "gams/GamsExport.h"
 #include "gams/variables/Agent.h"
 #include "gams/variables/Swarm.h"
+#include "gams/variables/SwarmSnapshot.h"
+#include "gams/variables/AgentView.h"
 #include "gams/variables/Self.h"
 #include "gams/variables/Sensor.h"
 #include "gams/variables/AlgorithmStatus.h"
@@ -67,8 +74,11 @@
 #include "gams/platforms/BasePlatform.h"
 #include "gams/algorithms/AlgorithmFactory.h"
 #include "gams/platforms/PlatformFactory.h"
+#include "gams/platforms/PlatformSenseThread.h"
 #include "gams/groups/GroupBase.h"
 
+#include "madara/knowledge/containers/Integer.h"
+#include "madara/knowledge/containers/Double.h"
 #include "madara/knowledge/containers/String.h"
 #include "madara/knowledge/containers/Vector.h"
 
@@ -78,6 +88,11 @@
 
 namespace gams
 {
+  namespace time
+  {
+    class SynchronousRounds;
+  }
+
   namespace controllers
   {
     /**
@@ -87,6 +102,12 @@ namespace gams
     class GAMS_EXPORT BaseController
     {
     public:
+      /// allow Multicontroller to schedule MAPE cycles of hosted agents
+      friend class Multicontroller;
+
+      /// allow synchronous rounds to step MAPE cycles on virtual time
+      friend class time::SynchronousRounds;
+
       /**
        * Constructor
        * @param   knowledge   The knowledge base to reference and mutate
@@ -343,10 +364,18 @@ namespace gams
       variables::Sensors * get_sensors (void);
 
       /**
-       * Saves a checkpoint according to the configured settings
+       * Saves a checkpoint according to the configured settings. If
+       * CHECKPOINT_ASYNC is set, the checkpoint is handed to a background
+       * writer. The first one copies the whole context, and later ones
+       * only copy the records MADARA tracks as modified since then.
        **/
       void save_checkpoint (void);
 
+      /**
+       * Blocks until all asynchronous checkpoints have been written
+       **/
+      void flush_checkpoints (void);
+
     protected:
 
       /// Accents on the primary algorithm
@@ -361,6 +390,9 @@ namespace gams
       /// Containers for agent-related variables
       variables::Agents agents_;
 
+      /// Lazily bound views of the agents in agents_
+      variables::AgentViews agent_views_;
+
       /// Knowledge base
       madara::knowledge::KnowledgeBase & knowledge_;
 
@@ -379,15 +411,165 @@ namespace gams
       /// Containers for swarm-related variables
       variables::Swarm swarm_;
 
+      /// agent state copied once per cycle for algorithms
+      variables::SwarmSnapshot swarm_snapshot_;
+
       /// Settings for controller management and qos
       ControllerSettings settings_;
 
       /// keeps track of the checkpoints saved in the control loop
       int checkpoint_count_;
+
+      /// background writer for CHECKPOINT_ASYNC (created on first use)
+      CheckpointWriter * checkpoint_writer_;
+
+      /// number of asynchronous checkpoints queued for writing
+      madara::knowledge::containers::Integer checkpoints_queued_;
+
+      /// number of asynchronous checkpoints written to disk
+      madara::knowledge::containers::Integer checkpoints_written_;
+
+      /// number of asynchronous checkpoints dropped due to a full queue
+      madara::knowledge::containers::Integer checkpoints_dropped_;
+
+      /// number of asynchronous checkpoints merged into queued checkpoints
+      madara::knowledge::containers::Integer checkpoints_merged_;
+
+      /// per-phase latency statistics (created on first use if enabled)
+      MapeStatistics * stats_;
+
+      /// senses the platform off the context lock if sense_hertz > 0
+      platforms::PlatformSenseThread * sense_thread_;
+
+      /// runs accents concurrently if accent_threads > 0 (created on use)
+      AccentPool * accent_pool_;
+
+      /// true if accents_ changed since the pool last grouped them
+      bool accents_changed_;
+
+      /// true while a cycle runs the concurrent accents on the pool
+      bool parallel_accents_;
+
+      /**
+       * true if run_once_ holds the context lock for the whole MAPE cycle.
+       * Multicontroller clears it so that hosted agents run their cycles
+       * concurrently, with each knowledge base access locking on its own.
+       **/
+      bool lock_cycle_;
+
+      /// number of cycles that finished after their deadline
+      madara::knowledge::containers::Integer loop_overruns_;
+
+      /// number of releases skipped due to overruns
+      madara::knowledge::containers::Integer loop_skipped_;
+
+      /// delay between the last release and the start of its cycle
+      madara::knowledge::containers::Double loop_jitter_;
+
+      /// maximum delay between a release and the start of its cycle
+      madara::knowledge::containers::Double loop_max_jitter_;
+
+      /// duration of the last cycle, including sends, in seconds
+      madara::knowledge::containers::Double loop_cycle_time_;
+
+      /// the send rate in use, which may be reduced by adaptive_send
+      madara::knowledge::containers::Double loop_send_hz_;
+
+      /// number of loops woken by a trigger variable
+      madara::knowledge::containers::Integer loop_wakeups_;
+
+      /// number of loops run after waiting max_trigger_wait
+      madara::knowledge::containers::Integer loop_timeouts_;
+
+      /// recently used algorithms, reused by repeated commands
+      AlgorithmCache algorithm_cache_;
+
+      /// name of the current algorithm if it was created from a command
+      std::string algorithm_name_;
+
+      /// arguments of the current algorithm if it was created from a command
+      madara::knowledge::KnowledgeMap algorithm_args_;
     private:
 
+      /**
+       * Fills agents_ from agent_views_, binding the agent containers
+       * unless lazy agents are configured
+       **/
+      void init_agents_ (void);
+
+      /**
+       * Packs the algorithm and platform status flags
+       **/
+      void pack_status_ (void);
+
       /// Code shared between run and run_once
       int run_once_ (void);
+
+      /// Sends modified values and records the latency of the send
+      void send_modifieds_ (void);
+
+      /**
+       * Runs a phase of the accents. While the pool is in use, the
+       * concurrent accents only take part in the execute phase, after
+       * the in-order accents.
+       * @param  phase   MAPE_PHASE_ANALYZE, MAPE_PHASE_PLAN or
+       *                 MAPE_PHASE_EXECUTE
+       **/
+      void run_accents_ (int phase);
+
+      /**
+       * Creates the accent pool and regroups the accents if needed
+       * @return true if more than one accent can run concurrently
+       **/
+      bool prepare_accent_pool_ (void);
+
+      /**
+       * Checks if the swarm snapshot must be updated this cycle, i.e., if
+       * trajectories are recorded or a hosted algorithm or accent reads it
+       * @return true if swarm_snapshot_ should be updated
+       **/
+      bool swarm_snapshot_needed_ (void) const;
+
+      /**
+       * Applies the real-time priority and cpu affinity settings to the
+       * calling thread
+       **/
+      void configure_loop_thread_ (void);
+
+      /**
+       * Moves the current algorithm into the algorithm cache, or deletes
+       * it if it cannot be cached
+       **/
+      void retire_algorithm_ (void);
+
+      /**
+       * Adds the configured (or default) trigger variables to a watcher
+       * @param  watcher  the watcher to initialize
+       **/
+      void init_triggers_ (TriggerWatcher & watcher);
+
+      /**
+       * Runs a MAPE cycle, with the concurrent accents analyzed and
+       * planned on the accent pool, followed by system_analyze
+       * @return  the result of the MAPE cycle
+       **/
+      int run_cycle_ (void);
+
+      /**
+       * Runs cycles until max_runtime, sending and checkpointing as
+       * configured. Without triggers, cycles are released on a grid of
+       * loop periods, with the overrun handling of the scheduler policy.
+       * @see run
+       * @param  loop_period  time (in seconds) between loop releases
+       * @param  max_runtime  maximum total runtime to execute the MAPE loops
+       * @param  send_period  time (in seconds) between sending data
+       * @param  triggers     if not null, a cycle is released whenever a
+       *                      trigger variable is updated, or at least
+       *                      every max_trigger_wait seconds
+       * @return  the result of the MAPE loop
+       **/
+      int run_loop_ (double loop_period, double max_runtime,
+        double send_period, TriggerWatcher * triggers);
     };
   }
 }
@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+#include "CheckpointWriter.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "gams/loggers/GlobalLogger.h"
+
+typedef  madara::knowledge::KnowledgeRecord::Integer  Integer;
+
+gams::controllers::CheckpointWriter::CheckpointWriter (
+  size_t max_queue_length, int overflow_policy)
+  : max_queue_length_ (max_queue_length > 0 ? max_queue_length : 1),
+  overflow_policy_ (overflow_policy), terminated_ (false), writing_ (false),
+  queued_ (0), written_ (0), dropped_ (0), merged_ (0)
+{
+  thread_ = std::thread (&CheckpointWriter::run_, this);
+}
+
+gams::controllers::CheckpointWriter::~CheckpointWriter ()
+{
+  {
+    std::lock_guard <std::mutex> guard (lock_);
+    terminated_ = true;
+  }
+
+  changed_.notify_all ();
+  thread_.join ();
+}
+
+int
+gams::controllers::CheckpointWriter::enqueue (const std::string & filename,
+  madara::knowledge::KnowledgeMap & records, bool save_diffs)
+{
+  int result (CHECKPOINT_QUEUED);
+
+  {
+    std::lock_guard <std::mutex> guard (lock_);
+
+    if (queue_.size () >= max_queue_length_)
+    {
+      if (overflow_policy_ == CHECKPOINT_OVERFLOW_MERGE)
+      {
+        // the newer changes overwrite those of the last queued checkpoint,
+        // which keeps its filename
+        Job & last = queue_.back ();
+
+        for (madara::knowledge::KnowledgeMap::iterator i = records.begin ();
+          i != records.end (); ++i)
+        {
+          last.records[i->first] = i->second;
+        }
+
+        last.save_diffs = save_diffs;
+        records.clear ();
+
+        ++merged_;
+        result = CHECKPOINT_MERGED;
+      }
+      else if (overflow_policy_ == CHECKPOINT_OVERFLOW_DROP_OLDEST)
+      {
+        // changes of the dropped checkpoint move to the next one, where
+        // they do not replace newer values
+        madara::knowledge::KnowledgeMap & next = queue_.size () > 1 ?
+          queue_[1].records : records;
+
+        next.insert (queue_.front ().records.begin (),
+          queue_.front ().records.end ());
+
+        queue_.pop_front ();
+        ++dropped_;
+      }
+      else
+      {
+        for (madara::knowledge::KnowledgeMap::iterator i = records.begin ();
+          i != records.end (); ++i)
+        {
+          carried_[i->first] = i->second;
+        }
+
+        records.clear ();
+        ++dropped_;
+        result = CHECKPOINT_DROPPED;
+      }
+    }
+
+    if (result == CHECKPOINT_QUEUED)
+    {
+      records.insert (carried_.begin (), carried_.end ());
+      carried_.clear ();
+
+      queue_.push_back (Job ());
+      queue_.back ().filename = filename;
+      queue_.back ().records.swap (records);
+      queue_.back ().save_diffs = save_diffs;
+
+      ++queued_;
+    }
+  }
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MINOR,
+    "gams::controllers::CheckpointWriter::enqueue:" \
+    " %s checkpoint for %s\n",
+    result == CHECKPOINT_QUEUED ? "queued" :
+      (result == CHECKPOINT_MERGED ? "merged" : "dropped"),
+    filename.c_str ());
+
+  changed_.notify_all ();
+
+  return result;
+}
+
+void
+gams::controllers::CheckpointWriter::flush (void)
+{
+  std::unique_lock <std::mutex> lock (lock_);
+
+  while (!queue_.empty () || writing_)
+  {
+    changed_.wait (lock);
+  }
+}
+
+Integer
+gams::controllers::CheckpointWriter::get_queued (void) const
+{
+  std::lock_guard <std::mutex> guard (lock_);
+  return queued_;
+}
+
+Integer
+gams::controllers::CheckpointWriter::get_written (void) const
+{
+  std::lock_guard <std::mutex> guard (lock_);
+  return written_;
+}
+
+Integer
+gams::controllers::CheckpointWriter::get_dropped (void) const
+{
+  std::lock_guard <std::mutex> guard (lock_);
+  return dropped_;
+}
+
+Integer
+gams::controllers::CheckpointWriter::get_merged (void) const
+{
+  std::lock_guard <std::mutex> guard (lock_);
+  return merged_;
+}
+
+void
+gams::controllers::CheckpointWriter::run_ (void)
+{
+  std::unique_lock <std::mutex> lock (lock_);
+
+  while (true)
+  {
+    while (!terminated_ && queue_.empty ())
+    {
+      changed_.wait (lock);
+    }
+
+    // on termination, the queue is drained before exiting
+    if (queue_.empty ())
+    {
+      break;
+    }
+
+    Job job;
+    job.filename.swap (queue_.front ().filename);
+    job.records.swap (queue_.front ().records);
+    job.save_diffs = queue_.front ().save_diffs;
+    queue_.pop_front ();
+
+    writing_ = true;
+    lock.unlock ();
+
+    write_ (job);
+
+    lock.lock ();
+    writing_ = false;
+    ++written_;
+
+    changed_.notify_all ();
+  }
+}
+
+void
+gams::controllers::CheckpointWriter::write_ (Job & job)
+{
+  // mirror updates are never sent, but must be tracked for checkpoints
+  madara::knowledge::EvalSettings update_settings;
+  update_settings.treat_globals_as_locals = true;
+  update_settings.track_local_changes = true;
+
+  for (madara::knowledge::KnowledgeMap::const_iterator i =
+    job.records.begin (); i != job.records.end (); ++i)
+  {
+    mirror_.set (i->first, i->second, update_settings);
+  }
+
+  madara::knowledge::CheckpointSettings checkpoint_settings;
+  checkpoint_settings.filename = job.filename;
+  checkpoint_settings.reset_checkpoint = true;
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::controllers::CheckpointWriter::write_:" \
+    " saving %s with %d changed records to %s\n",
+    job.save_diffs ? "checkpoint" : "context",
+    (int)job.records.size (), job.filename.c_str ());
+
+  if (job.save_diffs)
+  {
+    mirror_.save_checkpoint (checkpoint_settings);
+  }
+  else
+  {
+    mirror_.save_context (checkpoint_settings);
+  }
+
+#ifndef _WIN32
+  // make sure the checkpoint survives a crash of the agent
+  int fd = ::open (job.filename.c_str (), O_RDONLY);
+
+  if (fd >= 0)
+  {
+    ::fsync (fd);
+    ::close (fd);
+  }
+#endif
+}
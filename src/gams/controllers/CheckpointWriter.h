@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file CheckpointWriter.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a background writer for controller checkpoints
+ **/
+
+#ifndef   _GAMS_CONTROLLERS_CHECKPOINTWRITER_H_
+#define   _GAMS_CONTROLLERS_CHECKPOINTWRITER_H_
+
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "ControllerSettings.h"
+
+#include "gams/GamsExport.h"
+#include "madara/knowledge/KnowledgeBase.h"
+
+namespace gams
+{
+  namespace controllers
+  {
+    /**
+     * Results of handing a checkpoint to the CheckpointWriter
+     **/
+    enum CheckpointEnqueueResults
+    {
+      CHECKPOINT_QUEUED = 0,
+      CHECKPOINT_MERGED = 1,
+      CHECKPOINT_DROPPED = 2
+    };
+
+    /**
+     * Writes checkpoints on a dedicated thread so that disk latency does
+     * not become control loop jitter. The control loop hands over only
+     * the records that changed since its previous checkpoint, and the
+     * writer thread applies them to a private knowledge base, which holds
+     * the accumulated state, serializes it and flushes the file to disk.
+     * Deleted records are not propagated. The changes of a dropped
+     * checkpoint are carried into the next accepted one, so later
+     * checkpoints remain complete.
+     **/
+    class GAMS_EXPORT CheckpointWriter
+    {
+    public:
+      /**
+       * Constructor
+       * @param  max_queue_length  the maximum number of checkpoints waiting
+       *                           to be written (at least 1)
+       * @param  overflow_policy   what to do with a new checkpoint when
+       *                           the queue is full.
+       *                           @see CheckpointOverflowPolicies
+       **/
+      CheckpointWriter (size_t max_queue_length = 4,
+        int overflow_policy = CHECKPOINT_OVERFLOW_MERGE);
+
+      /**
+       * Destructor. Writes any queued checkpoints before returning.
+       **/
+      ~CheckpointWriter ();
+
+      /**
+       * Hands a checkpoint to the writer thread. The records are swapped
+       * out of the provided map, which is left empty for reuse.
+       * @param  filename    the file to save the checkpoint to
+       * @param  records     the records changed since the previous call
+       * @param  save_diffs  if true, only the changed records are appended
+       *                     to the file. Otherwise, the full accumulated
+       *                     context is saved.
+       * @return the result of the operation.
+       *         @see CheckpointEnqueueResults
+       **/
+      int enqueue (const std::string & filename,
+        madara::knowledge::KnowledgeMap & records, bool save_diffs);
+
+      /**
+       * Blocks until all queued checkpoints have been written
+       **/
+      void flush (void);
+
+      /**
+       * Returns the number of checkpoints accepted into the queue
+       * @return the number of queued checkpoints
+       **/
+      madara::knowledge::KnowledgeRecord::Integer get_queued (void) const;
+
+      /**
+       * Returns the number of checkpoints written to disk
+       * @return the number of written checkpoints
+       **/
+      madara::knowledge::KnowledgeRecord::Integer get_written (void) const;
+
+      /**
+       * Returns the number of checkpoints dropped due to a full queue
+       * @return the number of dropped checkpoints
+       **/
+      madara::knowledge::KnowledgeRecord::Integer get_dropped (void) const;
+
+      /**
+       * Returns the number of checkpoints merged into a queued checkpoint
+       * @return the number of merged checkpoints
+       **/
+      madara::knowledge::KnowledgeRecord::Integer get_merged (void) const;
+
+    private:
+
+      /**
+       * A checkpoint waiting to be written
+       **/
+      struct Job
+      {
+        /// the file to write to
+        std::string filename;
+
+        /// the records changed since the previous checkpoint
+        madara::knowledge::KnowledgeMap records;
+
+        /// true if only differences should be appended
+        bool save_diffs;
+      };
+
+      /**
+       * Main function of the writer thread
+       **/
+      void run_ (void);
+
+      /**
+       * Serializes a checkpoint to disk
+       * @param  job   the checkpoint to write
+       **/
+      void write_ (Job & job);
+
+      /// checkpoints waiting to be written
+      std::deque <Job> queue_;
+
+      /// the maximum length of queue_
+      size_t max_queue_length_;
+
+      /// the policy for a full queue
+      int overflow_policy_;
+
+      /// protects the queue, flags and counters
+      mutable std::mutex lock_;
+
+      /// signals changes to the queue
+      std::condition_variable changed_;
+
+      /// true if the writer thread should exit once the queue is empty
+      bool terminated_;
+
+      /// true while the writer thread is writing a checkpoint
+      bool writing_;
+
+      /// number of queued checkpoints
+      madara::knowledge::KnowledgeRecord::Integer queued_;
+
+      /// number of written checkpoints
+      madara::knowledge::KnowledgeRecord::Integer written_;
+
+      /// number of dropped checkpoints
+      madara::knowledge::KnowledgeRecord::Integer dropped_;
+
+      /// number of merged checkpoints
+      madara::knowledge::KnowledgeRecord::Integer merged_;
+
+      /// changes of dropped checkpoints, applied to the next accepted one
+      madara::knowledge::KnowledgeMap carried_;
+
+      /// private knowledge base with the state of the written checkpoints
+      madara::knowledge::KnowledgeBase mirror_;
+
+      /// the writer thread
+      std::thread thread_;
+    };
+  }
+}
+
+#endif // _GAMS_CONTROLLERS_CHECKPOINTWRITER_H_
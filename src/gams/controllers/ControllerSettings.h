@@ -55,6 +55,7 @@
 #define   _GAMS_CONTROLLERS_CONTROLLERSETTINGS_H_
 
 #include <string>
+#include <vector>
 
 #include "gams/GamsExport.h"
 
@@ -70,7 +71,45 @@ namespace gams
       CHECKPOINT_SAVE_DIFFS = 4,
       CHECKPOINT_SAVE_FULL_CONTEXTS = 8,
       CHECKPOINT_SAVE_ONE_FILE = 16,
-      CHECKPOINT_SAVE_DIFFS_IN_ONE_FILE = 20
+      CHECKPOINT_SAVE_DIFFS_IN_ONE_FILE = 20,
+      CHECKPOINT_ASYNC = 32
+    };
+
+    /**
+     * Policies for handling asynchronous checkpoints when the checkpoint
+     * writer's queue is full
+     **/
+    enum CheckpointOverflowPolicies
+    {
+      CHECKPOINT_OVERFLOW_DROP_NEWEST = 0,
+      CHECKPOINT_OVERFLOW_DROP_OLDEST = 1,
+      CHECKPOINT_OVERFLOW_MERGE = 2
+    };
+
+    /**
+     * Policies for scheduling loop releases in BaseController::run
+     **/
+    enum SchedulerPolicies
+    {
+      /// sleep until the next release, silently slipping on overruns
+      SCHEDULE_DEFAULT = 0,
+      /// keep a fixed release grid and skip releases that were missed
+      SCHEDULE_SKIP = 1,
+      /// run missed releases back-to-back, up to max_catch_up cycles
+      SCHEDULE_CATCH_UP = 2
+    };
+
+    /**
+     * Policies for cycles that finish after their deadline (the next
+     * release time) when a scheduler policy other than SCHEDULE_DEFAULT
+     * is used
+     **/
+    enum DeadlinePolicies
+    {
+      /// count the overrun and otherwise proceed normally
+      DEADLINE_SOFT = 0,
+      /// count the overrun and defer sends and checkpoints of late cycles
+      DEADLINE_HARD = 1
     };
 
     /**
@@ -83,41 +122,180 @@ namespace gams
        * Constructor
        **/
       ControllerSettings ()
-        : agent_prefix ("agent.0"), checkpoint_prefix ("checkpoint"),
-          checkpoint_strategy (CHECKPOINT_NONE), gams_log_level (-1), loop_hertz (2.0),
-          madara_log_level (-1), run_time (-1), send_hertz (1.0)
+        : accent_threads (0), adaptive_send (false), agent_prefix ("agent.0"),
+          algorithm_cache_size (0),
+          checkpoint_overflow_policy (CHECKPOINT_OVERFLOW_MERGE),
+          checkpoint_prefix ("checkpoint"), checkpoint_queue_length (4),
+          checkpoint_strategy (CHECKPOINT_NONE),
+          deadline_policy (DEADLINE_SOFT), gams_log_level (-1),
+          lazy_agents (false), loop_cpu (-1), loop_hertz (2.0), loop_priority (-1),
+          madara_log_level (-1), max_catch_up (3), max_trigger_wait (-1),
+          packed_status (false), run_time (-1), scheduler_policy (SCHEDULE_DEFAULT),
+          send_hertz (1.0), sense_hertz (0.0),
+          stats_file_format (0), stats_file_prefix (""), stats_hertz (0.0),
+          trajectory_length (0),
+          virtual_time (false),
+          wait_for_triggers (false)
       {
       }
 
+      /**
+       * the number of worker threads for running accents concurrently.
+       * Only accents that declare non-conflicting access sets have their
+       * analyze and plan phases run concurrently, with the context lock
+       * released after the plan phase. Their execute phases then run in
+       * order within the cycle's execute phase. They only run concurrently
+       * from the controller's own loops and from SynchronousRounds, so
+       * run_once always runs every accent in order.
+       * 0 runs all accents in order on the loop thread.
+       * @see gams::algorithms::BaseAlgorithm::get_access_sets
+       **/
+      size_t accent_threads;
+
+      /**
+       * if true, the send rate is halved (down to 1/8 of send_hertz) while
+       * loop overruns occur and restored once they stop. Requires a
+       * scheduler policy other than SCHEDULE_DEFAULT.
+       **/
+      bool adaptive_send;
+
       /** the default agent prefix (e.g., "agent.bob" or "agent.0"). This is a prefix
         * of what the self_ agent prefix will be in the knowledge base. For instance,
         * agent.0.location, agent.0.algorithm, etc.
         **/
       std::string agent_prefix;
 
+      /**
+       * the number of previously commanded algorithms to keep for reuse
+       * when the same algorithm and arguments are commanded again. Only
+       * algorithms that are BaseAlgorithm::reusable are kept. 0 always
+       * creates a new algorithm.
+       **/
+      size_t algorithm_cache_size;
+
+      /**
+       * the policy for asynchronous checkpoints when the writer queue is
+       * full. @see CheckpointOverflowPolicies
+       **/
+      int checkpoint_overflow_policy;
+
       /**
       * the knowledge checkpointing file system prefix (e.g., "./checkpoint" will
       * save checkpoints to currently directory in files that start with checkpoint
       **/
       std::string checkpoint_prefix;
 
+      /// max checkpoints waiting for the asynchronous checkpoint writer
+      size_t checkpoint_queue_length;
+
       /// the knowledge checkpointing strategy
       int checkpoint_strategy;
 
+      /// the deadline policy. @see DeadlinePolicies
+      int deadline_policy;
+
       /// the gams logging level (negative means don't change)
       int gams_log_level;
 
+      /**
+       * if true, the containers of agents in the swarm are not bound when
+       * the controller initializes its variables. Only agent prefixes are
+       * kept in the agents list, and algorithms must access agent
+       * variables through BaseAlgorithm::get_agent, which binds them on
+       * first use. Must be set before init_vars.
+       * @see gams::variables::AgentView
+       **/
+      bool lazy_agents;
+
+      /// the CPU to pin the thread calling run to (negative means any)
+      int loop_cpu;
+
       /// the hertz rate that a controller should run at
       double loop_hertz;
 
+      /**
+       * the real-time (SCHED_FIFO) priority of the thread calling run.
+       * Negative keeps the default scheduler.
+       **/
+      int loop_priority;
+
       /// the MADARA logging level (negative means don't change)
       int madara_log_level;
 
+      /// max consecutive cycles to run late with SCHEDULE_CATCH_UP
+      int max_catch_up;
+
+      /**
+       * the longest time, in seconds, to wait for a trigger before running
+       * the loop anyway. Non-positive uses the loop period.
+       **/
+      double max_trigger_wait;
+
+      /**
+       * if true, the algorithm and platform status flags are kept local
+       * and published once per cycle as a single packed flags record.
+       * Other agents and tools that read the individual flags of this
+       * agent (e.g., agent.0.algorithm.move.finished) no longer see
+       * changes. They must read the flags record or call unpack on a
+       * status initialized for this agent.
+       * @see gams::variables::AlgorithmStatus::set_packed
+       **/
+      bool packed_status;
+
       /// maximum runtime (-1 means persistent, forever)
       double run_time;
 
+      /// the loop scheduler policy. @see SchedulerPolicies
+      int scheduler_policy;
+
       /// the hertz rate to call send_modifieds at
       double send_hertz;
+
+      /**
+       * the hertz rate to sense the platform at on a separate thread. If
+       * non-positive or unsupported by the platform, sense is called from
+       * monitor with the context locked.
+       **/
+      double sense_hertz;
+
+      /// the format of the statistics dump (0 is CSV, 1 is JSON Lines)
+      int stats_file_format;
+
+      /// prefix of files to dump MAPE statistics to (empty means no dump)
+      std::string stats_file_prefix;
+
+      /// the hertz rate to publish MAPE statistics at (0 disables them)
+      double stats_hertz;
+
+      /**
+       * the number of recent locations to keep per agent in the swarm
+       * snapshot's trajectories, e.g., for Follow's lead argument. 0 keeps
+       * no history.
+       * @see gams::variables::Trajectory
+       **/
+      size_t trajectory_length;
+
+      /**
+       * variables that wake the loop when updated. If empty, the agent's
+       * algorithm, the swarm algorithm and the peer locations are used.
+       **/
+      std::vector <std::string> trigger_variables;
+
+      /**
+       * if true, the controller steps on the virtual clock. Loops do not
+       * sleep, and algorithm timeouts follow simulated time. Sends and
+       * checkpoints follow the send period in simulated time. A
+       * Multicontroller steps all hosted agents in one round per loop
+       * period, in order, on the calling thread.
+       * @see gams::time::SynchronousRounds
+       **/
+      bool virtual_time;
+
+      /**
+       * if true, run waits for an update to a trigger variable (or for
+       * max_trigger_wait) instead of sleeping for a fixed loop period
+       **/
+      bool wait_for_triggers;
     };
   }
 }
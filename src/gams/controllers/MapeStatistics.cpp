@@ -0,0 +1,263 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+#include "MapeStatistics.h"
+
+#include "gams/loggers/GlobalLogger.h"
+
+namespace knowledge = madara::knowledge;
+
+gams::controllers::MapeStatistics::MapeStatistics (
+  knowledge::KnowledgeBase & knowledge,
+  const std::string & agent_prefix, double hertz,
+  const std::string & file_prefix, int file_format)
+  : agent_prefix_ (agent_prefix), file_format_ (file_format),
+  terminated_ (false)
+{
+  for (int i = 0; i < MAPE_PHASE_NUM; ++i)
+  {
+    std::string prefix (".gams.stats." + agent_prefix + "." + phase_name (i));
+
+    p50_[i].set_name (prefix + ".p50", knowledge);
+    p99_[i].set_name (prefix + ".p99", knowledge);
+    max_[i].set_name (prefix + ".max", knowledge);
+    count_[i].set_name (prefix + ".count", knowledge);
+  }
+
+  window_ = madara::utility::seconds_to_duration (
+    hertz > 0 ? 1.0 / hertz : 1.0);
+  next_publish_ = madara::utility::Clock::now () + window_;
+
+  if (file_prefix != "")
+  {
+    std::string filename (file_prefix + "_" + agent_prefix +
+      (file_format_ == STATS_FORMAT_JSON ? ".json" : ".csv"));
+
+    file_.open (filename.c_str (), std::ios::out | std::ios::app);
+
+    if (!file_.is_open ())
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_ERROR,
+        "gams::controllers::MapeStatistics::constructor:" \
+        " unable to open %s. Statistics will not be dumped.\n",
+        filename.c_str ());
+    }
+    else
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::MapeStatistics::constructor:" \
+        " dumping statistics to %s.\n",
+        filename.c_str ());
+
+      // only write the header for new files
+      if (file_format_ != STATS_FORMAT_JSON && file_.tellp () == 0)
+      {
+        file_ << "time,agent,phase,count,p50,p99,max\n";
+      }
+
+      dump_thread_ = std::thread (&MapeStatistics::run_dump_, this);
+    }
+  }
+}
+
+gams::controllers::MapeStatistics::~MapeStatistics ()
+{
+  if (dump_thread_.joinable ())
+  {
+    {
+      std::lock_guard <std::mutex> guard (dump_lock_);
+      terminated_ = true;
+    }
+
+    dump_changed_.notify_all ();
+    dump_thread_.join ();
+  }
+}
+
+const char *
+gams::controllers::MapeStatistics::phase_name (int phase)
+{
+  switch (phase)
+  {
+  case MAPE_PHASE_MONITOR:
+    return "monitor";
+  case MAPE_PHASE_ANALYZE:
+    return "analyze";
+  case MAPE_PHASE_PLAN:
+    return "plan";
+  case MAPE_PHASE_EXECUTE:
+    return "execute";
+  case MAPE_PHASE_SEND:
+    return "send";
+  default:
+    return "unknown";
+  }
+}
+
+void
+gams::controllers::MapeStatistics::publish_if_due (void)
+{
+  madara::utility::TimeValue current = madara::utility::Clock::now ();
+
+  if (current >= next_publish_)
+  {
+    publish ();
+
+    while (next_publish_ <= current)
+    {
+      next_publish_ += window_;
+    }
+  }
+}
+
+void
+gams::controllers::MapeStatistics::publish (void)
+{
+  utility::LatencyHistogram::Summary summaries[MAPE_PHASE_NUM];
+
+  for (int i = 0; i < MAPE_PHASE_NUM; ++i)
+  {
+    summaries[i] = histograms_[i].take ();
+
+    p50_[i] = summaries[i].p50;
+    p99_[i] = summaries[i].p99;
+    max_[i] = summaries[i].max;
+    count_[i] = (knowledge::KnowledgeRecord::Integer)summaries[i].count;
+  }
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_DETAILED,
+    "gams::controllers::MapeStatistics::publish:" \
+    " %s: execute p50=%fs, p99=%fs, max=%fs over %d cycles.\n",
+    agent_prefix_.c_str (),
+    summaries[MAPE_PHASE_EXECUTE].p50, summaries[MAPE_PHASE_EXECUTE].p99,
+    summaries[MAPE_PHASE_EXECUTE].max,
+    (int)summaries[MAPE_PHASE_EXECUTE].count);
+
+  // the file is written by the dump thread
+  if (dump_thread_.joinable ())
+  {
+    {
+      std::lock_guard <std::mutex> guard (dump_lock_);
+
+      pending_.push_back (Window ());
+      pending_.back ().time = madara::utility::get_time () / 1000000000.0;
+
+      for (int i = 0; i < MAPE_PHASE_NUM; ++i)
+      {
+        pending_.back ().summaries[i] = summaries[i];
+      }
+    }
+
+    dump_changed_.notify_one ();
+  }
+}
+
+void
+gams::controllers::MapeStatistics::run_dump_ (void)
+{
+  std::unique_lock <std::mutex> lock (dump_lock_);
+
+  while (true)
+  {
+    while (!terminated_ && pending_.empty ())
+    {
+      dump_changed_.wait (lock);
+    }
+
+    // on termination, pending windows are written before exiting
+    if (pending_.empty ())
+    {
+      break;
+    }
+
+    Window window (pending_.front ());
+    pending_.pop_front ();
+
+    lock.unlock ();
+    dump_ (window);
+    lock.lock ();
+  }
+}
+
+void
+gams::controllers::MapeStatistics::dump_ (const Window & window)
+{
+  const utility::LatencyHistogram::Summary * summaries = window.summaries;
+  double time = window.time;
+
+  file_.precision (9);
+
+  if (file_format_ == STATS_FORMAT_JSON)
+  {
+    file_ << std::fixed << "{\"time\":" << time << ",\"agent\":\"" <<
+      agent_prefix_ << "\"";
+
+    for (int i = 0; i < MAPE_PHASE_NUM; ++i)
+    {
+      file_ << ",\"" << phase_name (i) << "\":{\"count\":" <<
+        summaries[i].count << ",\"p50\":" << summaries[i].p50 <<
+        ",\"p99\":" << summaries[i].p99 << ",\"max\":" <<
+        summaries[i].max << "}";
+    }
+
+    file_ << "}\n";
+  }
+  else
+  {
+    for (int i = 0; i < MAPE_PHASE_NUM; ++i)
+    {
+      file_ << std::fixed << time << "," << agent_prefix_ << "," <<
+        phase_name (i) << "," << summaries[i].count << "," <<
+        summaries[i].p50 << "," << summaries[i].p99 << "," <<
+        summaries[i].max << "\n";
+    }
+  }
+
+  file_.flush ();
+}
@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file MapeStatistics.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains latency statistics for the phases of a MAPE loop
+ **/
+
+#ifndef   _GAMS_CONTROLLERS_MAPESTATISTICS_H_
+#define   _GAMS_CONTROLLERS_MAPESTATISTICS_H_
+
+#include <string>
+#include <fstream>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "gams/GamsExport.h"
+#include "gams/utility/LatencyHistogram.h"
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/containers/Double.h"
+#include "madara/knowledge/containers/Integer.h"
+#include "madara/utility/Utility.h"
+
+namespace gams
+{
+  namespace controllers
+  {
+    /**
+     * Phases of a controller loop that latencies are recorded for
+     **/
+    enum MapePhases
+    {
+      MAPE_PHASE_MONITOR = 0,
+      MAPE_PHASE_ANALYZE = 1,
+      MAPE_PHASE_PLAN = 2,
+      MAPE_PHASE_EXECUTE = 3,
+      MAPE_PHASE_SEND = 4,
+      MAPE_PHASE_NUM = 5
+    };
+
+    /**
+     * Formats for dumping MAPE statistics to a file
+     **/
+    enum StatsFileFormats
+    {
+      STATS_FORMAT_CSV = 0,
+      STATS_FORMAT_JSON = 1
+    };
+
+    /**
+     * Records per-phase latencies of a controller loop and periodically
+     * publishes the p50, p99 and max of each window to the local variables
+     * .gams.stats.{agent_prefix}.{phase}.{p50|p99|max|count}. Windows can
+     * also be appended to a CSV or JSON Lines file, which is written by a
+     * background thread so that disk latency stays out of the control loop.
+     **/
+    class GAMS_EXPORT MapeStatistics
+    {
+    public:
+      /**
+       * Constructor
+       * @param  knowledge     the knowledge base to publish to
+       * @param  agent_prefix  the prefix of the agent (e.g., agent.0)
+       * @param  hertz         the rate at which windows are published
+       * @param  file_prefix   prefix of the file to dump windows to. Empty
+       *                       disables the dump.
+       * @param  file_format   the format of the dump. @see StatsFileFormats
+       **/
+      MapeStatistics (madara::knowledge::KnowledgeBase & knowledge,
+        const std::string & agent_prefix, double hertz,
+        const std::string & file_prefix = "",
+        int file_format = STATS_FORMAT_CSV);
+
+      /**
+       * Destructor. Writes any pending windows before returning.
+       **/
+      ~MapeStatistics ();
+
+      /**
+       * Records the latency of a phase
+       * @param  phase   the phase. @see MapePhases
+       * @param  start   the time the phase started
+       * @param  end     the time the phase ended
+       **/
+      inline void record (int phase,
+        const madara::utility::TimeValue & start,
+        const madara::utility::TimeValue & end)
+      {
+        histograms_[phase].record ((uint64_t)
+          std::chrono::duration_cast<std::chrono::nanoseconds> (
+            end - start).count ());
+      }
+
+      /**
+       * Publishes the current window if the publication period has
+       * elapsed. Should be called with the knowledge base context locked
+       * or from the thread that owns the controller.
+       **/
+      void publish_if_due (void);
+
+      /**
+       * Publishes the current window and starts a new one
+       **/
+      void publish (void);
+
+      /**
+       * Returns the name of a phase as used in variable names
+       * @param  phase   the phase. @see MapePhases
+       * @return the name of the phase
+       **/
+      static const char * phase_name (int phase);
+
+    private:
+
+      /**
+       * A published window waiting to be written to the dump file
+       **/
+      struct Window
+      {
+        /// the time of publication in seconds
+        double time;
+
+        /// the summaries of each phase
+        utility::LatencyHistogram::Summary summaries[MAPE_PHASE_NUM];
+      };
+
+      /**
+       * Main function of the dump thread
+       **/
+      void run_dump_ (void);
+
+      /**
+       * Appends a window to the dump file
+       * @param  window   the window to write
+       **/
+      void dump_ (const Window & window);
+
+      /// the agent the statistics belong to
+      std::string agent_prefix_;
+
+      /// histograms of the current window for each phase
+      utility::LatencyHistogram histograms_[MAPE_PHASE_NUM];
+
+      /// published medians
+      madara::knowledge::containers::Double p50_[MAPE_PHASE_NUM];
+
+      /// published 99th percentiles
+      madara::knowledge::containers::Double p99_[MAPE_PHASE_NUM];
+
+      /// published maximums
+      madara::knowledge::containers::Double max_[MAPE_PHASE_NUM];
+
+      /// published sample counts
+      madara::knowledge::containers::Integer count_[MAPE_PHASE_NUM];
+
+      /// the time between publications
+      madara::utility::Duration window_;
+
+      /// the time of the next publication
+      madara::utility::TimeValue next_publish_;
+
+      /// the dump file, if enabled
+      std::ofstream file_;
+
+      /// the format of the dump file
+      int file_format_;
+
+      /// windows waiting to be written to the dump file
+      std::deque <Window> pending_;
+
+      /// protects pending_ and terminated_
+      std::mutex dump_lock_;
+
+      /// signals changes to pending_
+      std::condition_variable dump_changed_;
+
+      /// true if the dump thread should exit once pending_ is empty
+      bool terminated_;
+
+      /// the dump thread, if the dump is enabled
+      std::thread dump_thread_;
+    };
+  }
+}
+
+#endif // _GAMS_CONTROLLERS_MAPESTATISTICS_H_
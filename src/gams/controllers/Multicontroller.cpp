@@ -3,26 +3,26 @@
  *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions are met:
- *
+ * 
  * 1. Redistributions of source code must retain the above copyright notice,
  *    this list of conditions and the following acknowledgments and disclaimers.
- *
+ * 
  * 2. Redistributions in binary form must reproduce the above copyright notice,
  *    this list of conditions and the following disclaimer in the documentation
  *    and/or other materials provided with the distribution.
- *
+ * 
  * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
  *    Engineering Institute" shall not be used to endorse or promote products
  *    derived from this software without prior written permission. For written
  *    permission, please contact permission@sei.cmu.edu.
- *
+ * 
  * 4. Products derived from this software may not be called "SEI" nor may "SEI"
  *    appear in their names without prior written permission of
  *    permission@sei.cmu.edu.
- *
+ * 
  * 5. Redistributions of any form whatsoever must retain the following
  *    acknowledgment:
- *
+ * 
  *      This material is based upon work funded and supported by the Department
  *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
  *      University for the operation of the Software Engineering Institute, a
@@ -30,7 +30,7 @@
  *      findings and conclusions or recommendations expressed in this material
  *      are those of the author(s) and do not necessarily reflect the views of
  *      the United States Department of Defense.
- *
+ * 
  *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
  *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
  *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
@@ -39,7 +39,7 @@
  *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
  *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
  *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
- *
+ * 
  *      This material has been approved for public release and unlimited
  *      distribution.
  **/
@@ -48,32 +48,45 @@
 
 #include <iostream>
 #include <sstream>
+#include <chrono>
 
 #include "madara/utility/Utility.h"
 #include "gams/algorithms/AlgorithmFactoryRepository.h"
 #include "gams/platforms/PlatformFactoryRepository.h"
 #include "gams/loggers/GlobalLogger.h"
-#include "madara/utility/EpochEnforcer.h"
-
-// Java-specific header includes
-#ifdef _GAMS_JAVA_
-#include "gams/algorithms/java/JavaAlgorithm.h"
-#include "gams/platforms/java/JavaPlatform.h"
-#include "gams/utility/java/Acquire_VM.h"
-#endif
+#include "gams/time/ModelsOfComputation.h"
 
 typedef  madara::knowledge::KnowledgeRecord::Integer  Integer;
 
-typedef  madara::utility::EpochEnforcer<std::chrono::steady_clock> EpochEnforcer;
+namespace
+{
+  /**
+   * Creates the agent.{id} prefix of a hosted agent
+   * @param  id   the id of the agent
+   * @return the agent prefix
+   **/
+  std::string make_agent_prefix (Integer id)
+  {
+    std::stringstream buffer;
+    buffer << "agent.";
+    buffer << id;
+    return buffer.str ();
+  }
+}
 
 gams::controllers::Multicontroller::Multicontroller (
-  madara::knowledge::KnowledgeBase & knowledge)
-  : algorithm_ (0), knowledge_ (knowledge), platform_ (0)
+  madara::knowledge::KnowledgeBase & knowledge,
+  size_t num_controllers,
+  const ControllerSettings & settings)
+  : knowledge_ (knowledge), settings_ (settings), first_id_ (0),
+  num_threads_ (0), terminated_ (false), return_value_ (0)
 {
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::Multicontroller::constructor:" \
-    " default constructor called.\n");
+    " creating %d controllers.\n", (int)num_controllers);
+
+  resize (num_controllers);
 }
 
 gams::controllers::Multicontroller::~Multicontroller ()
@@ -81,24 +94,77 @@ gams::controllers::Multicontroller::~Multicontroller ()
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::Multicontroller::destructor:" \
-    " deleting algorithm.\n");
-  delete algorithm_;
+    " deleting controllers.\n");
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::destructor:" \
-    " deleting platform.\n");
-  delete platform_;
+  for (size_t i = 0; i < controllers_.size (); ++i)
+  {
+    delete controllers_[i];
+  }
+}
 
+void
+gams::controllers::Multicontroller::resize (size_t num_controllers)
+{
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::destructor:" \
-    " deleting accents.\n");
-  for (algorithms::Algorithms::iterator i = accents_.begin ();
-    i != accents_.end (); ++i)
+    "gams::controllers::Multicontroller::resize:" \
+    " resizing from %d to %d controllers.\n",
+    (int)controllers_.size (), (int)num_controllers);
+
+  for (size_t i = num_controllers; i < controllers_.size (); ++i)
   {
-    delete *i;
+    delete controllers_[i];
   }
+
+  size_t old_size = controllers_.size ();
+
+  controllers_.resize (num_controllers, 0);
+  schedules_.resize (num_controllers);
+
+  for (size_t i = old_size; i < num_controllers; ++i)
+  {
+    ControllerSettings settings (settings_);
+    settings.agent_prefix = make_agent_prefix (first_id_ + (Integer)i);
+
+    controllers_[i] = new BaseController (knowledge_, settings);
+
+    // hosted agents run concurrently, so they do not lock whole cycles
+    controllers_[i]->lock_cycle_ = false;
+
+    bind_identity_ (i);
+    init_schedule_vars_ (i);
+  }
+}
+
+size_t
+gams::controllers::Multicontroller::get_num_controllers (void) const
+{
+  return controllers_.size ();
+}
+
+gams::controllers::BaseController *
+gams::controllers::Multicontroller::get_controller (size_t controller_index)
+{
+  BaseController * result (0);
+
+  if (controller_index < controllers_.size ())
+  {
+    result = controllers_[controller_index];
+  }
+
+  return result;
+}
+
+void
+gams::controllers::Multicontroller::set_num_threads (size_t num_threads)
+{
+  num_threads_ = num_threads;
+}
+
+size_t
+gams::controllers::Multicontroller::get_num_threads (void) const
+{
+  return num_threads_;
 }
 
 void gams::controllers::Multicontroller::add_platform_factory (
@@ -115,712 +181,576 @@ void gams::controllers::Multicontroller::add_algorithm_factory (
   gams::algorithms::global_algorithm_factory()->add (aliases, factory);
 }
 
-int
-gams::controllers::Multicontroller::monitor (void)
+void
+gams::controllers::Multicontroller::init_schedule_vars_ (
+  size_t controller_index)
 {
-  int result (0);
+  const std::string local_prefix (
+    "." + controllers_[controller_index]->self_.agent.prefix + ".loop");
 
-  if (platform_)
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::monitor:" \
-      " calling platform_->sense ()\n");
+  schedules_[controller_index].overruns_var.set_name (
+    local_prefix + ".overruns", knowledge_);
+  schedules_[controller_index].cycle_time_var.set_name (
+    local_prefix + ".cycle_time", knowledge_);
+}
 
-    result = platform_->sense ();
-  }
-  else
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_WARNING,
-      "gams::controllers::Multicontroller::monitor:" \
-      " Platform undefined. Unable to call platform_->sense ()\n");
-  }
+void
+gams::controllers::Multicontroller::bind_identity_ (size_t controller_index)
+{
+  variables::Self & self = controllers_[controller_index]->self_;
 
-  return result;
+  // .id and .prefix are global to the knowledge base, so each hosted
+  // agent keeps its identity in local variables under its own prefix
+  const std::string local_prefix ("." + self.agent.prefix);
+
+  self.id.set_name (local_prefix + ".id", knowledge_);
+  self.id = first_id_ + (Integer)controller_index;
+  self.prefix.set_name (local_prefix + ".prefix", knowledge_);
+  self.prefix = self.agent.prefix;
 }
 
 int
-gams::controllers::Multicontroller::system_analyze (void)
+gams::controllers::Multicontroller::run_agent_ (size_t controller_index,
+  bool concurrent_accents)
 {
-  int return_value (0);
-  //bool error (false);
+  BaseController * controller = controllers_[controller_index];
+
+  if (concurrent_accents)
+  {
+    controller->parallel_accents_ = controller->prepare_accent_pool_ ();
+  }
 
   /**
-   * Note that certain agent variables like command are kept local only.
-   * @see gams::variables::Agent::init_vars
-   * @see gams::variables::Swarm::init_vars
+   * The MAPE cycle runs without the context lock, so the platform I/O and
+   * algorithm work of agents on different workers overlap. Each knowledge
+   * base access in the cycle locks the context on its own.
    **/
+  int result = controller->run_once_ ();
+
+  controller->parallel_accents_ = false;
+
+  /**
+   * Agents share the global algorithm and platform factories, so any
+   * algorithm changes made by system_analyze happen under the context lock
+   **/
+  madara::knowledge::ContextGuard guard (knowledge_);
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::system_analyze:" \
-    " checking agent and swarm commands\n");
+    "gams::controllers::Multicontroller::run_agent_:" \
+    " calling system_analyze () on %s\n",
+    controller->self_.agent.prefix.c_str ());
+
+  result |= controller->system_analyze ();
 
-  if (self_.agent.algorithm != "")
+  if (CHECKPOINT_EVERY_LOOP & controller->settings_.checkpoint_strategy)
   {
-    std::string prefix(self_.agent.algorithm.get_name() + ".");
-    madara::knowledge::KnowledgeMap args(knowledge_.to_map_stripped(prefix));
+    controller->save_checkpoint ();
+  }
 
-    self_.agent.algorithm_args.sync_keys();
+  return result;
+}
 
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::system_analyze:" \
-      " Processing agent command: %s\n", (*self_.agent.algorithm).c_str());
+void
+gams::controllers::Multicontroller::send_modifieds_ (void)
+{
+  for (size_t i = 0; i < controllers_.size (); ++i)
+  {
+    if (CHECKPOINT_EVERY_SEND &
+      controllers_[i]->settings_.checkpoint_strategy)
+    {
+      madara::knowledge::ContextGuard guard (knowledge_);
+      controllers_[i]->save_checkpoint ();
+    }
+  }
 
-    init_algorithm (self_.agent.algorithm.to_string (), args);
+  // send modified values of all agents through network. The shared
+  // send is recorded in the statistics of the first hosted agent.
+  if (controllers_.size () > 0)
+    controllers_[0]->send_modifieds_ ();
+  else
+    knowledge_.send_modifieds ();
+}
 
-    self_.agent.last_algorithm = self_.agent.algorithm.to_string ();
+void
+gams::controllers::Multicontroller::run_worker_ (void)
+{
+  std::unique_lock <std::mutex> lock (schedule_lock_);
 
-    // reset the command
-    self_.agent.algorithm = "";
-    self_.agent.last_algorithm_args.clear(true);
-    self_.agent.algorithm_args.exchange(self_.agent.last_algorithm_args,
-                                      true, true);
-  }
-  else if (swarm_.algorithm != "")
+  while (!terminated_)
   {
-    std::string prefix(swarm_.algorithm.get_name() + ".");
-    madara::knowledge::KnowledgeMap args(knowledge_.to_map_stripped(prefix));
+    // find the idle agent with the earliest release time
+    size_t next = schedules_.size ();
 
-    swarm_.algorithm_args.sync_keys();
+    for (size_t i = 0; i < schedules_.size (); ++i)
+    {
+      if (!schedules_[i].busy && (next == schedules_.size () ||
+        schedules_[i].next_loop < schedules_[next].next_loop))
+      {
+        next = i;
+      }
+    }
 
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::system_analyze:" \
-      " Processing swarm command: %s\n", (*swarm_.algorithm).c_str());
+    if (next == schedules_.size ())
+    {
+      // all agents are being executed by other workers
+      schedule_changed_.wait (lock);
+      continue;
+    }
 
-    init_algorithm (swarm_.algorithm.to_string (), args);
+    AgentSchedule & schedule = schedules_[next];
 
-    self_.agent.last_algorithm = swarm_.algorithm.to_string ();
+    if (madara::utility::Clock::now () < schedule.next_loop)
+    {
+      // other agents may be released or finish while we wait
+      schedule_changed_.wait_until (lock, schedule.next_loop);
+      continue;
+    }
 
-    // reset the command
-    swarm_.algorithm = "";
-    self_.agent.last_algorithm_args.clear(true);
-    swarm_.algorithm_args.exchange(self_.agent.last_algorithm_args,
-                                 true, true);
-  }
+    schedule.busy = true;
+    lock.unlock ();
 
-  if (self_.agent.madara_debug_level !=
-    (Integer)madara::logger::global_logger->get_level ())
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::system_analyze:" \
-      " Settings MADARA debug level to %d\n", (int)*self_.agent.madara_debug_level);
+    madara::utility::TimeValue start = madara::utility::Clock::now ();
 
-    madara::logger::global_logger->set_level ((int)*self_.agent.madara_debug_level);
-  }
+    int result = run_agent_ (next, true);
 
-  if (self_.agent.gams_debug_level !=
-    (Integer)gams::loggers::global_logger->get_level ())
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::system_analyze:" \
-      " Settings GAMS debug level to %d\n", (int)*self_.agent.gams_debug_level);
+    madara::utility::TimeValue end = madara::utility::Clock::now ();
 
-    gams::loggers::global_logger->set_level ((int)*self_.agent.gams_debug_level);
-  }
+    // agents may change their own loop rate through agent.{id}.loop_hz
+    double requested_hz =
+      controllers_[next]->self_.agent.loop_hz.to_double ();
 
-  return return_value;
-}
+    lock.lock ();
 
-int
-gams::controllers::Multicontroller::analyze (void)
-{
-  int return_value (0);
+    return_value_ |= result;
+    ++schedule.loops;
 
-  if (platform_)
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::analyze:" \
-      " calling platform_->analyze ()\n");
+    if (!madara::utility::approx_equal (
+      requested_hz, schedule.loop_hz, 0.001))
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::Multicontroller::run_worker_:" \
+        " %s changing loop hertz from %.2f to %.2f\n",
+        controllers_[next]->self_.agent.prefix.c_str (),
+        schedule.loop_hz, requested_hz);
+
+      schedule.loop_hz = requested_hz;
+      schedule.loop_window = requested_hz > 0 ?
+        madara::utility::seconds_to_duration (1.0 / requested_hz) :
+        madara::utility::Duration::zero ();
+      schedule.next_loop = start;
+    }
 
-    return_value |= platform_->analyze ();
-  }
-  else
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::analyze:" \
-      " Platform undefined. Unable to call platform_->analyze ()\n");
-  }
+    if (schedule.loop_window > madara::utility::Duration::zero ())
+    {
+      schedule.next_loop += schedule.loop_window;
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::analyze:" \
-    " calling system_analyze ()\n");
-  return_value |= system_analyze ();
+      // any release that passed while the cycle ran was missed
+      while (schedule.next_loop < end)
+      {
+        schedule.next_loop += schedule.loop_window;
+        ++schedule.overruns;
+
+        madara_logger_ptr_log (gams::loggers::global_logger.get (),
+          gams::loggers::LOG_MINOR,
+          "gams::controllers::Multicontroller::run_worker_:" \
+          " %s overran its loop period (%d overruns)\n",
+          controllers_[next]->self_.agent.prefix.c_str (),
+          (int)schedule.overruns);
+      }
+    }
+    else
+    {
+      // infinite hertz agents are released again immediately
+      schedule.next_loop = end;
+    }
 
-  if (algorithm_)
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::analyze:" \
-      " calling algorithm_->analyze ()\n");
+    Integer overruns = schedule.overruns;
 
-    return_value |= algorithm_->analyze ();
-  }
-  else
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::analyze:" \
-      " Algorithm undefined. Unable to call algorithm_->analyze ()\n");
-  }
+    lock.unlock ();
 
+    // publishing acquires the context lock, so do it outside the schedule
+    schedule.overruns_var = overruns;
+    schedule.cycle_time_var =
+      std::chrono::duration <double> (end - start).count ();
 
-  if (accents_.size () > 0)
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::analyze:" \
-      " calling analyze on accents\n");
-    for (algorithms::Algorithms::iterator i = accents_.begin ();
-      i != accents_.end (); ++i)
-    {
-      (*i)->analyze ();
-    }
-  }
+    lock.lock ();
 
-  return return_value;
+    schedule.busy = false;
+    schedule_changed_.notify_all ();
+  }
 }
 
 int
-gams::controllers::Multicontroller::plan (void)
+gams::controllers::Multicontroller::run_once (void)
 {
+  // return value
   int return_value (0);
 
-  if (algorithm_)
+  for (size_t i = 0; i < controllers_.size (); ++i)
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::plan:" \
-      " calling algorithm_->plan ()\n");
-
-    return_value |= algorithm_->plan ();
-  }
-  else
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::plan:" \
-      " Algorithm undefined. Unable to call algorithm_->plan ()\n");
+    return_value |= run_agent_ (i);
   }
 
-  if (accents_.size () > 0)
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::plan:" \
-      " calling plan on accents\n");
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::controllers::Multicontroller::run_once:" \
+    " sending updates\n");
 
-    for (algorithms::Algorithms::iterator i = accents_.begin ();
-      i != accents_.end (); ++i)
-    {
-      (*i)->plan ();
-    }
-  }
+  // send modified values through network. The shared send is recorded
+  // in the statistics of the first hosted agent.
+  if (controllers_.size () > 0)
+    controllers_[0]->send_modifieds_ ();
+  else
+    knowledge_.send_modifieds ();
 
   return return_value;
 }
 
 int
-gams::controllers::Multicontroller::execute (void)
+gams::controllers::Multicontroller::run (void)
 {
-  int return_value (0);
-
-  if (algorithm_)
+  // check the debug levels and set accordingly
+  if (settings_.madara_log_level >= 0)
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::execute:" \
-      " calling algorithm_->execute ()\n");
-
-    return_value |= algorithm_->execute ();
+    madara::logger::global_logger->set_level (settings_.madara_log_level);
   }
-  else
+  if (settings_.gams_log_level >= 0)
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_WARNING,
-      "gams::controllers::Multicontroller::execute:" \
-      " Algorithm undefined. Unable to call algorithm_->execute ()\n");
+    gams::loggers::global_logger->set_level (settings_.gams_log_level);
   }
 
-  if (accents_.size () > 0)
-  {
-    for (algorithms::Algorithms::iterator i = accents_.begin ();
-      i != accents_.end (); ++i)
-    {
-      (*i)->execute ();
-    }
-  }
-
-  return return_value;
+  return run_hz (settings_.loop_hertz,
+    settings_.run_time, settings_.send_hertz);
 }
 
 int
-gams::controllers::Multicontroller::run_once_ (void)
+gams::controllers::Multicontroller::run (double loop_period,
+  double max_runtime, double send_period)
 {
-  // return value
-  int return_value (0);
-
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::run:" \
-    " calling monitor ()\n");
-
-  // lock the context from any external updates
-  madara::knowledge::ContextGuard guard (knowledge_);
-
-  return_value |= monitor ();
+  // if user specified non-positive, then we are to use loop_period
+  if (send_period <= 0)
+  {
+    send_period = loop_period;
+  }
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::run:" \
-    " after monitor (), %d modifications to send\n",
-    (int)knowledge_.get_context ().get_modifieds ().size ());
+  double loop_hz = loop_period > 0 ? 1.0 / loop_period : 0.0;
+  double send_hz = send_period > 0 ? 1.0 / send_period : 0.0;
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_DETAILED,
-    "%s\n",
-    knowledge_.debug_modifieds ().c_str ());
+  madara::utility::TimeValue current = madara::utility::Clock::now ();
+  madara::utility::Duration loop_window =
+    madara::utility::seconds_to_duration (loop_period > 0 ? loop_period : 0);
+  madara::utility::Duration send_window =
+    madara::utility::seconds_to_duration (send_period > 0 ? send_period : 0);
+  madara::utility::TimeValue next_send = current + send_window;
+  madara::utility::TimeValue end_time = current +
+    madara::utility::seconds_to_duration (max_runtime);
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::Multicontroller::run:" \
-    " calling analyze ()\n");
+    " %d agents, loop_period: %fs, max_runtime: %fs, send_period: %fs\n",
+    (int)controllers_.size (), loop_period, max_runtime, send_period);
 
-  return_value |= analyze ();
+  if (controllers_.size () == 0)
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_WARNING,
+      "gams::controllers::Multicontroller::run:" \
+      " no controllers to run\n");
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::run:" \
-    " after analyze (), %d modifications to send\n",
-    (int)knowledge_.get_context ().get_modifieds ().size ());
+    return 0;
+  }
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_DETAILED,
-    "%s\n",
-    knowledge_.debug_modifieds ().c_str ());
+  return_value_ = 0;
+  terminated_ = false;
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::run:" \
-    " calling plan ()\n");
+  for (size_t i = 0; i < controllers_.size (); ++i)
+  {
+    BaseController * controller = controllers_[i];
 
-  return_value |= plan ();
+    madara::knowledge::ContextGuard guard (knowledge_);
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::run:" \
-    " after plan (), %d modifications to send\n",
-    (int)knowledge_.get_context ().get_modifieds ().size ());
+    controller->self_.agent.loop_hz = loop_hz;
+    controller->self_.agent.send_hz = send_hz;
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_DETAILED,
-    "%s\n",
-    knowledge_.debug_modifieds ().c_str ());
+    controller->save_checkpoint ();
+    return_value_ |= controller->system_analyze ();
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::run:" \
-    " calling execute ()\n");
+    schedules_[i].loop_hz = loop_hz;
+    schedules_[i].loop_window = loop_window;
+    schedules_[i].next_loop = current;
+    schedules_[i].busy = false;
+    schedules_[i].loops = 0;
+    schedules_[i].overruns = 0;
+  }
 
-  return_value |= execute ();
+  // simulated time steps every agent once per round on the calling thread
+  if (settings_.virtual_time && loop_period > 0.0)
+  {
+    gams::time::SynchronousRounds rounds (loop_period, send_period);
+    rounds.add (this);
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::run:" \
-    " after execute (), %d modifications to send\n",
-    (int)knowledge_.get_context ().get_modifieds ().size ());
+    return_value_ = rounds.run (max_runtime);
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_DETAILED,
-    "%s\n",
-    knowledge_.debug_modifieds ().c_str ());
+    return return_value_;
+  }
 
-  return return_value;
-}
+  // determine the size of the worker pool
+  size_t num_workers = num_threads_;
 
-int
-gams::controllers::Multicontroller::run_once (void)
-{
-  // return value
-  int return_value (run_once_ ());
+  if (num_workers == 0)
+  {
+    num_workers = std::thread::hardware_concurrency ();
+  }
+  if (num_workers == 0)
+  {
+    num_workers = 1;
+  }
+  if (num_workers > controllers_.size ())
+  {
+    num_workers = controllers_.size ();
+  }
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::Multicontroller::run:" \
-    " sending updates\n");
-
-  // send modified values through network
-  knowledge_.send_modifieds ();
+    " starting %d worker threads\n", (int)num_workers);
 
-  return return_value;
-}
+  std::vector <std::thread> workers;
+  workers.reserve (num_workers);
 
-int
-gams::controllers::Multicontroller::run (double ,
-  double , double )
-{
-  return 0;
-}
-
-void
-gams::controllers::Multicontroller::init_accent (const std::string & algorithm,
-const madara::knowledge::KnowledgeMap & args)
-{
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_accent:" \
-    " initializing accent %s\n", algorithm.c_str ());
-
-  if (algorithm == "")
+  for (size_t i = 0; i < num_workers; ++i)
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_ERROR,
-      "gams::controllers::Multicontroller::init_accent:" \
-      " ERROR: accent name is null\n");
+    workers.push_back (std::thread (&Multicontroller::run_worker_, this));
   }
-  else
-  {
-    // create new accent pointer and algorithm factory
-    algorithms::BaseAlgorithm * new_accent (0);
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_accent:" \
-      " factory is creating accent %s\n", algorithm.c_str ());
 
-    new_accent = algorithms::global_algorithm_factory()->create (algorithm, args);
+  // the calling thread is responsible for sending and for termination
+  bool first_send (true);
+  std::unique_lock <std::mutex> lock (schedule_lock_);
+
+  while (true)
+  {
+    current = madara::utility::Clock::now ();
 
-    if (new_accent)
+    // run will always execute every agent at least one time
+    bool all_executed (true);
+    for (size_t i = 0; i < schedules_.size () && all_executed; ++i)
     {
-      accents_.push_back (new_accent);
+      all_executed = schedules_[i].loops > 0;
     }
-    else
-    {
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_ERROR,
-        "gams::controllers::Multicontroller::init_accent:" \
-        " ERROR: created accent is null.\n");
-    }
-  }
-}
 
-void gams::controllers::Multicontroller::clear_accents (void)
-{
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::clear_accents:" \
-    " deleting and clearing all accents\n");
+    bool finished = max_runtime >= 0 && current >= end_time && all_executed;
 
-  for (unsigned int i = 0; i < accents_.size (); ++i)
-  {
-    delete accents_[i];
-  }
+    if (first_send || send_period <= 0 || current >= next_send || finished)
+    {
+      lock.unlock ();
 
-  accents_.clear ();
-}
-void
-gams::controllers::Multicontroller::init_algorithm (
-const std::string & algorithm, const madara::knowledge::KnowledgeMap & args)
-{
-  // initialize the algorithm
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::controllers::Multicontroller::run:" \
+        " sending updates\n");
 
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_algorithm:" \
-    " initializing algorithm %s\n", algorithm.c_str ());
+      send_modifieds_ ();
 
-  if (algorithm == "")
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "Algorithm is empty.\n\n" \
-      "SUPPORTED ALGORITHMS:\n" \
-      "  bridge | bridging\n" \
-      "  random area coverage\n" \
-      "  priotized area coverage\n"
-      );
-  }
-  else
-  {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_algorithm:" \
-      " deleting old algorithm\n");
+      first_send = false;
 
-    delete algorithm_;
+      // setup the next send epoch
+      if (send_period > 0)
+      {
+        while (next_send <= current)
+        {
+          next_send += send_window;
+        }
+      }
 
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_algorithm:" \
-      " factory is creating algorithm %s\n", algorithm.c_str ());
+      lock.lock ();
+    }
 
-    algorithm_ = algorithms::global_algorithm_factory()->create (
-      algorithm, args);
+    if (finished)
+    {
+      break;
+    }
 
-    if (algorithm_ == 0)
+    if ((max_runtime >= 0 && current >= end_time) ||
+      (max_runtime < 0 && send_period <= 0))
     {
-      // the user is going to expect this kind of error to be printed immediately
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_MAJOR,
-        "gams::controllers::Multicontroller::init_algorithm:" \
-        " failed to create algorithm\n");
+      // wait for agents to finish cycles (either their first cycle before
+      // termination or any cycle if we are sending as fast as possible)
+      schedule_changed_.wait (lock);
     }
     else
     {
-#ifdef _GAMS_JAVA_
-      algorithms::JavaAlgorithm * jalg =
-        dynamic_cast <algorithms::JavaAlgorithm *> (algorithm_);
-
-      if (jalg)
-      {
-        // Acquire the Java virtual machine
-        gams::utility::java::Acquire_VM jvm;
-
-        jclass controller_class = gams::utility::java::find_class (
-          jvm.env, "ai/gams/controllers/Multicontroller");
-        jobject alg = jalg->get_java_instance ();
-        jclass alg_class = jvm.env->GetObjectClass (alg);
-        
-        jmethodID init_call = jvm.env->GetMethodID (alg_class,
-          "init", "(Lai/gams/controllers/Multicontroller;)V");
-        jmethodID controllerFromPointerCall = jvm.env->GetStaticMethodID (
-          controller_class,
-          "fromPointer", "(JZ)Lai/gams/controllers/Multicontroller;");
-
-        if (init_call && controllerFromPointerCall)
-        {
-          madara_logger_ptr_log (gams::loggers::global_logger.get (),
-            gams::loggers::LOG_MAJOR,
-            "gams::controllers::Multicontroller::init_algorithm:" \
-            " Calling BaseAlgorithm init method.\n");
-          jobject controller = jvm.env->CallStaticObjectMethod (controller_class,
-            controllerFromPointerCall, (jlong)this, (jboolean)false); 
-
-          jvm.env->CallVoidMethod (
-            alg, init_call, controller);
-
-          jvm.env->DeleteLocalRef (controller);
-        }
-        else
-        {
-          madara_logger_ptr_log (gams::loggers::global_logger.get (),
-            gams::loggers::LOG_ERROR,
-            "gams::controllers::Multicontroller::init_algorithm:" \
-            " ERROR. Could not locate init and fromPointer calls in "
-            "Multicontroller. Unable to initialize algorithm.\n");
-        }
+      madara::utility::TimeValue wake_time =
+        send_period > 0 ? next_send : end_time;
 
-        jvm.env->DeleteLocalRef (alg_class);
-        jvm.env->DeleteLocalRef (alg);
-        jvm.env->DeleteWeakGlobalRef (controller_class);
-      }
-      else
+      if (max_runtime >= 0 && end_time < wake_time)
       {
-        init_vars (*algorithm_);
+        wake_time = end_time;
       }
-#else
-      init_vars (*algorithm_);
-#endif
+
+      schedule_changed_.wait_until (lock, wake_time);
     }
   }
-}
 
-void
-gams::controllers::Multicontroller::init_platform (
-  const std::string & platform,
-  const madara::knowledge::KnowledgeMap & args)
-{
-  // initialize the platform
+  terminated_ = true;
+  schedule_changed_.notify_all ();
+  lock.unlock ();
+
+  for (size_t i = 0; i < workers.size (); ++i)
+  {
+    workers[i].join ();
+  }
 
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_platform:" \
-    " initializing platform %s\n", platform.c_str ());
+    "gams::controllers::Multicontroller::run:" \
+    " all workers have finished\n");
+
+  return return_value_;
+}
 
-  if (platform == "")
+void
+gams::controllers::Multicontroller::init_accent (
+  const std::string & algorithm,
+  const madara::knowledge::KnowledgeMap & args,
+  int controller_index)
+{
+  if (controller_index < 0)
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_ERROR,
-      "Platform is empty.\n\n" \
-      "SUPPORTED PLATFORMS:\n" \
-      "  drone-rk\n" \
-      "  vrep\n" \
-      );
+    for (size_t i = 0; i < controllers_.size (); ++i)
+    {
+      controllers_[i]->init_accent (algorithm, args);
+    }
+  }
+  else if ((size_t)controller_index < controllers_.size ())
+  {
+    controllers_[controller_index]->init_accent (algorithm, args);
   }
   else
   {
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_platform:" \
-      " deleting old platform\n");
-
-    delete platform_;
-    platforms::PlatformFactoryRepository factory (&knowledge_, &sensors_, &platforms_, &self_);
-
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_platform:" \
-      " factory is creating platform %s\n", platform.c_str ());
-
-    platform_ = factory.create (platform, args);
-
-    init_vars (*platform_);
+      gams::loggers::LOG_ERROR,
+      "gams::controllers::Multicontroller::init_accent:" \
+      " ERROR: controller index %d is out of bounds\n", controller_index);
+  }
+}
 
-    if (algorithm_)
+void gams::controllers::Multicontroller::clear_accents (int controller_index)
+{
+  if (controller_index < 0)
+  {
+    for (size_t i = 0; i < controllers_.size (); ++i)
     {
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_MAJOR,
-        "gams::controllers::Multicontroller::init_platform:" \
-        " algorithm is already initialized. Updating to new platform\n");
-
-      algorithm_->set_platform (platform_);
+      controllers_[i]->clear_accents ();
     }
   }
+  else if ((size_t)controller_index < controllers_.size ())
+  {
+    controllers_[controller_index]->clear_accents ();
+  }
+  else
+  {
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_ERROR,
+      "gams::controllers::Multicontroller::clear_accents:" \
+      " ERROR: controller index %d is out of bounds\n", controller_index);
+  }
 }
 
-void gams::controllers::Multicontroller::init_algorithm (algorithms::BaseAlgorithm * algorithm)
+void
+gams::controllers::Multicontroller::init_algorithm (
+  const std::string & algorithm,
+  const madara::knowledge::KnowledgeMap & args,
+  int controller_index)
 {
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_algorithm:" \
-    " deleting old algorithm\n");
-
-  delete algorithm_;
-  algorithm_ = algorithm;
-
-  if (algorithm_)
+  if (controller_index < 0)
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_algorithm:" \
-      " initializing vars in algorithm\n");
-
-    init_vars (*algorithm_);
+    for (size_t i = 0; i < controllers_.size (); ++i)
+    {
+      controllers_[i]->init_algorithm (algorithm, args);
+    }
+  }
+  else if ((size_t)controller_index < controllers_.size ())
+  {
+    controllers_[controller_index]->init_algorithm (algorithm, args);
   }
   else
   {
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
+      gams::loggers::LOG_ERROR,
       "gams::controllers::Multicontroller::init_algorithm:" \
-      " algorithm was reset to none\n");
+      " ERROR: controller index %d is out of bounds\n", controller_index);
   }
 }
 
-
-void gams::controllers::Multicontroller::init_platform (platforms::BasePlatform * platform)
+void
+gams::controllers::Multicontroller::init_algorithm (
+  algorithms::BaseAlgorithm * algorithm, size_t controller_index)
 {
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_platform:" \
-    " deleting old platform\n");
-
-  delete platform_;
-  platform_ = platform;
-
-  if (platform_)
+  if (controller_index < controllers_.size ())
+  {
+    controllers_[controller_index]->init_algorithm (algorithm);
+  }
+  else
   {
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_platform:" \
-      " initializing vars in platform\n");
+      gams::loggers::LOG_ERROR,
+      "gams::controllers::Multicontroller::init_algorithm:" \
+      " ERROR: controller index %d is out of bounds. Deleting algorithm\n",
+      (int)controller_index);
 
-    init_vars (*platform_);
+    delete algorithm;
+  }
+}
 
-    if (algorithm_)
+void
+gams::controllers::Multicontroller::init_platform (
+  const std::string & platform,
+  const madara::knowledge::KnowledgeMap & args,
+  int controller_index)
+{
+  if (controller_index < 0)
+  {
+    for (size_t i = 0; i < controllers_.size (); ++i)
     {
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_MAJOR,
-        "gams::controllers::Multicontroller::init_platform:" \
-        " algorithm is already initialized. Updating to new platform\n");
-
-      algorithm_->set_platform (platform_);
+      controllers_[i]->init_platform (platform, args);
     }
   }
+  else if ((size_t)controller_index < controllers_.size ())
+  {
+    controllers_[controller_index]->init_platform (platform, args);
+  }
   else
   {
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
+      gams::loggers::LOG_ERROR,
       "gams::controllers::Multicontroller::init_platform:" \
-      " platform was reset to none\n");
+      " ERROR: controller index %d is out of bounds\n", controller_index);
   }
 }
 
-#ifdef _GAMS_JAVA_
-
-void gams::controllers::Multicontroller::init_algorithm (jobject algorithm)
+void
+gams::controllers::Multicontroller::init_platform (
+  platforms::BasePlatform * platform, size_t controller_index)
 {
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_algorithm (java):" \
-    " deleting old algorithm\n");
-
-  delete algorithm_;
-
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_algorithm (java):" \
-    " creating new Java algorithm\n");
-
-  algorithm_ = new gams::algorithms::JavaAlgorithm (algorithm);
-
-  if (algorithm_)
+  if (controller_index < controllers_.size ())
   {
-    madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_algorithm (java):" \
-      " initializing vars for algorithm\n");
-
-    init_vars (*algorithm_);
+    controllers_[controller_index]->init_platform (platform);
   }
-}
-
-
-void gams::controllers::Multicontroller::init_platform (jobject platform)
-{
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_platform (java):" \
-    " deleting old platform\n");
-
-  delete platform_;
-
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_platform (java):" \
-    " creating new Java platform\n");
-
-  platform_ = new gams::platforms::JavaPlatform (platform);
-
-  if (platform_)
+  else
   {
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
-      gams::loggers::LOG_MAJOR,
-      "gams::controllers::Multicontroller::init_platform (java):" \
-      " initializing vars for platform\n");
-
-    init_vars (*platform_);
-
-    if (algorithm_)
-    {
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_MAJOR,
-        "gams::controllers::Multicontroller::init_platform (java):" \
-        " Algorithm exists. Updating its platform.\n");
+      gams::loggers::LOG_ERROR,
+      "gams::controllers::Multicontroller::init_platform:" \
+      " ERROR: controller index %d is out of bounds. Deleting platform\n",
+      (int)controller_index);
 
-      algorithm_->set_platform (platform_);
-    }
+    delete platform;
   }
 }
 
-#endif
-
 void
 gams::controllers::Multicontroller::init_vars (
 const Integer & id,
@@ -829,51 +759,75 @@ const Integer & processes)
   madara_logger_ptr_log (gams::loggers::global_logger.get (),
     gams::loggers::LOG_MAJOR,
     "gams::controllers::Multicontroller::init_vars:" \
-    " %" PRId64 " id, %" PRId64 " processes\n", id, processes);
+    " %" PRId64 " first id, %" PRId64 " processes\n", id, processes);
 
-  // initialize the agents, swarm, and self variables
-  variables::init_vars (agents_, knowledge_, processes);
-  swarm_.init_vars (knowledge_, processes);
-  self_.init_vars (knowledge_, id);
-}
+  first_id_ = id;
 
-void
-gams::controllers::Multicontroller::init_vars (platforms::BasePlatform & platform)
-{
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_vars:" \
-    " initializing platform's vars\n");
+  for (size_t i = 0; i < controllers_.size (); ++i)
+  {
+    ControllerSettings settings (settings_);
+    settings.agent_prefix = make_agent_prefix (id + (Integer)i);
 
-  platform.knowledge_ = &knowledge_;
-  platform.self_ = &self_;
-  platform.sensors_ = &sensors_;
+    controllers_[i]->configure (settings);
+    controllers_[i]->init_vars (id + (Integer)i, processes);
+    bind_identity_ (i);
+    init_schedule_vars_ (i);
+  }
 }
 
-
 void
-gams::controllers::Multicontroller::init_vars (algorithms::BaseAlgorithm & algorithm)
+gams::controllers::Multicontroller::configure (
+  const ControllerSettings & settings)
 {
-  madara_logger_ptr_log (gams::loggers::global_logger.get (),
-    gams::loggers::LOG_MAJOR,
-    "gams::controllers::Multicontroller::init_vars:" \
-    " initializing algorithm's vars\n");
+  settings_ = settings;
+
+  for (size_t i = 0; i < controllers_.size (); ++i)
+  {
+    ControllerSettings agent_settings (settings_);
+    agent_settings.agent_prefix = controllers_[i]->self_.agent.prefix;
 
-  algorithm.agents_ = &agents_;
-  algorithm.knowledge_ = &knowledge_;
-  algorithm.platform_ = platform_;
-  algorithm.self_ = &self_;
-  algorithm.sensors_ = &sensors_;
+    controllers_[i]->configure (agent_settings);
+  }
 }
 
 gams::algorithms::BaseAlgorithm *
-gams::controllers::Multicontroller::get_algorithm (void)
+gams::controllers::Multicontroller::get_algorithm (size_t controller_index)
 {
-  return algorithm_;
+  algorithms::BaseAlgorithm * result (0);
+
+  if (controller_index < controllers_.size ())
+  {
+    result = controllers_[controller_index]->get_algorithm ();
+  }
+
+  return result;
 }
 
 gams::platforms::BasePlatform *
-gams::controllers::Multicontroller::get_platform (void)
+gams::controllers::Multicontroller::get_platform (size_t controller_index)
 {
-  return platform_;
+  platforms::BasePlatform * result (0);
+
+  if (controller_index < controllers_.size ())
+  {
+    result = controllers_[controller_index]->get_platform ();
+  }
+
+  return result;
+}
+
+Integer
+gams::controllers::Multicontroller::get_overruns (
+  size_t controller_index) const
+{
+  Integer result (0);
+
+  std::lock_guard <std::mutex> guard (schedule_lock_);
+
+  if (controller_index < schedules_.size ())
+  {
+    result = schedules_[controller_index].overruns;
+  }
+
+  return result;
 }
@@ -54,40 +54,72 @@
 #ifndef   _GAMS_CONTROLLERS_MULTICONTROLLER_H_
 #define   _GAMS_CONTROLLERS_MULTICONTROLLER_H_
 
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "ControllerSettings.h"
+#include "BaseController.h"
+
 #include "gams/GamsExport.h"
-#include "gams/variables/Agent.h"
-#include "gams/variables/Swarm.h"
-#include "gams/variables/Self.h"
-#include "gams/variables/Sensor.h"
-#include "gams/variables/AlgorithmStatus.h"
-#include "gams/variables/PlatformStatus.h"
 #include "gams/algorithms/BaseAlgorithm.h"
 #include "gams/platforms/BasePlatform.h"
 #include "gams/algorithms/AlgorithmFactory.h"
 #include "gams/platforms/PlatformFactory.h"
 
-#include "madara/knowledge/containers/String.h"
-#include "madara/knowledge/containers/Vector.h"
-
-#ifdef _GAMS_JAVA_
-#include <jni.h>
-#endif
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/containers/Integer.h"
+#include "madara/knowledge/containers/Double.h"
+#include "madara/utility/Utility.h"
 
 namespace gams
 {
+  namespace time
+  {
+    class SynchronousRounds;
+  }
+
   namespace controllers
   {
     /**
-     * A controller that has the capability of starting many different threads
+     * A controller that hosts many agents within a single process. Each
+     * agent is driven by its own BaseController, but all agents share
+     * one knowledge base and therefore one set of transports. Agent MAPE
+     * cycles are dispatched onto a pool of worker threads, and each agent
+     * keeps its own loop rate (agent.{id}.loop_hz). Cycles that miss their
+     * next release time are counted as overruns in the local variable
+     * .agent.{id}.loop.overruns.
+     *
+     * Hosted agents run their MAPE cycles without holding the context
+     * lock, so agents on different workers run concurrently. Each
+     * knowledge base access locks the context on its own, and
+     * system_analyze and checkpoints run under the context lock.
+     *
+     * The self-referencing .id and .prefix variables are global to a
+     * knowledge base, so the self_.id and self_.prefix containers of each
+     * hosted agent are bound to the local variables .agent.{id}.id and
+     * .agent.{id}.prefix instead. Algorithms should use these containers,
+     * not .id and .prefix, to identify the agent they are running for.
      **/
     class GAMS_EXPORT Multicontroller
     {
     public:
+      /// allow synchronous rounds to step hosted agents on virtual time
+      friend class time::SynchronousRounds;
+
       /**
        * Constructor
-       * @param   knowledge   The knowledge base to reference and mutate
+       * @param   knowledge        The knowledge base to reference and mutate
+       * @param   num_controllers  the number of agents to host
+       * @param   settings         an initial configuration for the
+       *                           controllers. The agent_prefix is ignored
+       *                           in favor of agent.{index}
        **/
-      Multicontroller (madara::knowledge::KnowledgeBase & knowledge);
+      Multicontroller (madara::knowledge::KnowledgeBase & knowledge,
+        size_t num_controllers = 1,
+        const ControllerSettings & settings = ControllerSettings ());
 
       /**
        * Destructor
@@ -95,41 +127,45 @@ namespace gams
       virtual ~Multicontroller ();
 
       /**
-      * Defines the monitor function (the M of MAPE). This function should
-      * return a 0 unless the MAPE loop should stop.
-      **/
-      virtual int monitor (void);
+       * Resizes the number of hosted agents. New controllers are created
+       * with the agent.{first_id + index} prefix. Should not be called
+       * while the controller is running.
+       * @param  num_controllers   the new number of controllers
+       **/
+      void resize (size_t num_controllers);
 
       /**
-      * Analyzes the system to determine if platform or algorithm changes
-      * are necessary. This function should
-      * return a 0 unless the MAPE loop should stop.
-      **/
-      virtual int system_analyze (void);
+       * Returns the number of hosted agents
+       * @return  the number of controllers
+       **/
+      size_t get_num_controllers (void) const;
 
       /**
-      * Defines the analyze function (the A of MAPE). This function should
-      * return a 0 unless the MAPE loop should stop.
-      **/
-      virtual int analyze (void);
+       * Returns the controller for a hosted agent
+       * @param  controller_index  the index of the hosted agent
+       * @return the controller or 0 if the index is out of bounds
+       **/
+      BaseController * get_controller (size_t controller_index);
 
       /**
-      * Defines the plan function (the P of MAPE). This function should
-      * return a 0 unless the MAPE loop should stop.
-      **/
-      virtual int plan (void);
+       * Sets the number of worker threads used to execute agent MAPE
+       * cycles. 0 selects one thread per hardware thread, bounded by the
+       * number of hosted agents.
+       * @param  num_threads   the number of worker threads
+       **/
+      void set_num_threads (size_t num_threads);
 
       /**
-      * Defines the execute function (the E of MAPE). This function should
-      * return a 0 unless the MAPE loop should stop.
-      **/
-      virtual int execute (void);
+       * Returns the configured number of worker threads
+       * @return  the number of worker threads (0 means automatic)
+       **/
+      size_t get_num_threads (void) const;
 
       /**
-       * Runs a single iteration of the MAPE loop
+       * Runs a single iteration of the MAPE loop for every agent
        * Always sends updates after the iteration.
        *
-       * @return  the result of the MAPE loop iteration
+       * @return  the result of the MAPE loop iterations
        **/
       int run_once (void);
 
@@ -147,7 +183,7 @@ namespace gams
       int run (double loop_period = 0.0,
         double max_runtime = -1,
         double send_period = -1.0);
-      
+
       /**
        * Runs iterations of the MAPE loop with specified hertz
        * @param  loop_hz  the intended hz at which the loop should execute.
@@ -181,18 +217,29 @@ namespace gams
         return run (loop_rate, max_runtime, send_rate);
       }
 
+      /**
+       * Runs iterations of the MAPE loop with configured settings
+       * @return  the result of the MAPE loop
+       **/
+      int run (void);
+
       /**
        * Adds an accent algorithm
        * @param  algorithm   the name of the accent algorithm to add
        * @param  args        vector of knowledge record arguments
+       * @param  controller_index  the agent to add the accent to. -1
+       *                           adds the accent to all agents
        **/
       void init_accent (const std::string & algorithm,
-        const madara::knowledge::KnowledgeMap & args = madara::knowledge::KnowledgeMap ());
+        const madara::knowledge::KnowledgeMap & args =
+          madara::knowledge::KnowledgeMap (),
+        int controller_index = -1);
 
       /**
        * Clears all accent algorithms
+       * @param  controller_index  the agent to clear. -1 clears all agents
        **/
-      void clear_accents (void);
+      void clear_accents (int controller_index = -1);
 
       /**
        * Adds an aliased platform factory. This factory will be
@@ -205,7 +252,7 @@ namespace gams
       void add_platform_factory (
         const std::vector <std::string> & aliases,
         platforms::PlatformFactory * factory);
-      
+
       /**
        * Adds an aliased algorithm factory. This factory will be
        * initialized with all appropriate variables in the
@@ -222,121 +269,180 @@ namespace gams
        * Initializes an algorithm
        * @param  algorithm   the name of the algorithm to run
        * @param  args        vector of knowledge record arguments
+       * @param  controller_index  the agent to initialize. -1 initializes
+       *                           the algorithm on all agents
        **/
       void init_algorithm (const std::string & algorithm,
-        const madara::knowledge::KnowledgeMap & args = madara::knowledge::KnowledgeMap ());
- 
+        const madara::knowledge::KnowledgeMap & args =
+          madara::knowledge::KnowledgeMap (),
+        int controller_index = -1);
+
       /**
-       * Initializes the controller with a user-provided algorithm. This
+       * Initializes an agent with a user-provided algorithm. This
        * algorithm's memory will be maintained by the controller. DO NOT
        * DELETE THIS POINTER.
-       * @param  algorithm   the algorithm to use
+       * @param  algorithm         the algorithm to use
+       * @param  controller_index  the agent to initialize
        **/
-      void init_algorithm (algorithms::BaseAlgorithm * algorithm);
+      void init_algorithm (algorithms::BaseAlgorithm * algorithm,
+        size_t controller_index);
 
       /**
        * Initializes the platform
        * @param  platform   the name of the platform the controller is using
        * @param  args        vector of knowledge record arguments
+       * @param  controller_index  the agent to initialize. -1 initializes
+       *                           the platform on all agents
        **/
       void init_platform (const std::string & platform,
         const madara::knowledge::KnowledgeMap & args =
-          madara::knowledge::KnowledgeMap ());
-       
+          madara::knowledge::KnowledgeMap (),
+        int controller_index = -1);
+
       /**
-       * Initializes the controller with a user-provided platform. This
+       * Initializes an agent with a user-provided platform. This
        * platform's memory will be maintained by the controller. DO NOT
        * DELETE THIS POINTER.
-       * @param  platform   the platform to use
+       * @param  platform          the platform to use
+       * @param  controller_index  the agent to initialize
        **/
-      void init_platform (platforms::BasePlatform * platform);
-           
-#ifdef _GAMS_JAVA_
-      /**
-       * Initializes a Java-based algorithm
-       * @param  algorithm  the java-based algorithm to use
-       **/
-      void init_algorithm (jobject algorithm);
-      
-      /**
-       * Initializes a Java-based platform
-       * @param  platform  the java-based platform to use
-       **/
-      void init_platform (jobject platform);
-#endif
+      void init_platform (platforms::BasePlatform * platform,
+        size_t controller_index);
 
       /**
-       * Initializes global variable containers
-       * @param   id         node identifier
+       * Initializes global variable containers. Hosted agents receive
+       * consecutive ids starting from id.
+       * @param   id         node identifier of the first hosted agent
        * @param   processes  processes
        **/
       void init_vars (const madara::knowledge::KnowledgeRecord::Integer & id = 0,
         const madara::knowledge::KnowledgeRecord::Integer & processes = -1);
-      
-      /**
-       * Initializes containers and knowledge base in a platform
-       * This is usually the first thing a developer should do with
-       * a user-defined platform.
-       * @param   platform   the platform to initialize
-       **/
-      void init_vars (platforms::BasePlatform & platform);
-      
+
       /**
-       * Initializes containers and knowledge base in an algorithm.
-       * This is usually the first thing a developer should do with
-       * a user-defined algorithm.
-       * @param   algorithm   the algorithm to initialize
+       * Configures the controllers with initialization settings
+       * @param  settings  the settings to apply to all hosted agents
        **/
-      void init_vars (algorithms::BaseAlgorithm & algorithm);
+      void configure (const ControllerSettings & settings);
 
       /**
-       * Gets the current algorithm
+       * Gets the current algorithm of an agent
+       * @param  controller_index  the index of the hosted agent
        * @return the algorithm
        **/
-      algorithms::BaseAlgorithm * get_algorithm (void);
-      
+      algorithms::BaseAlgorithm * get_algorithm (size_t controller_index = 0);
+
       /**
-       * Gets the current platform
+       * Gets the current platform of an agent
+       * @param  controller_index  the index of the hosted agent
        * @return the platform
        **/
-      platforms::BasePlatform * get_platform (void);
+      platforms::BasePlatform * get_platform (size_t controller_index = 0);
+
+      /**
+       * Returns the number of overruns counted for an agent since the
+       * controller was last started
+       * @param  controller_index  the index of the hosted agent
+       * @return the number of missed loop releases
+       **/
+      madara::knowledge::KnowledgeRecord::Integer get_overruns (
+        size_t controller_index) const;
 
     protected:
 
-      /// Accents on the primary algorithm
-      algorithms::Algorithms accents_;
+      /**
+       * Scheduling information for a hosted agent
+       **/
+      struct AgentSchedule
+      {
+        /// the next time the agent's MAPE cycle should be released
+        madara::utility::TimeValue next_loop;
+
+        /// the time between releases
+        madara::utility::Duration loop_window;
+
+        /// the loop rate that loop_window was computed from
+        double loop_hz;
+
+        /// true if a worker is currently executing the agent
+        bool busy;
+
+        /// number of cycles executed since run started
+        madara::knowledge::KnowledgeRecord::Integer loops;
+
+        /// number of missed releases since run started
+        madara::knowledge::KnowledgeRecord::Integer overruns;
+
+        /// local variable for publishing overruns
+        madara::knowledge::containers::Integer overruns_var;
+
+        /// local variable for publishing the last cycle time in seconds
+        madara::knowledge::containers::Double cycle_time_var;
+      };
+
+      /**
+       * Executes a single MAPE cycle and system analysis for an agent
+       * @param  controller_index  the index of the hosted agent
+       * @param  concurrent_accents  if true, the agent's accent pool is
+       *                    used. Only valid if the caller does not hold
+       *                    the context lock.
+       * @return the result of the MAPE cycle
+       **/
+      int run_agent_ (size_t controller_index,
+        bool concurrent_accents = false);
+
+      /**
+       * Saves the send checkpoints of the hosted agents and sends the
+       * modifications of all of them
+       **/
+      void send_modifieds_ (void);
+
+      /**
+       * Binds the self_.id and self_.prefix containers of a hosted agent
+       * to local variables under its own prefix
+       * @param  controller_index  the index of the hosted agent
+       **/
+      void bind_identity_ (size_t controller_index);
+
+      /**
+       * Main function of a worker thread
+       **/
+      void run_worker_ (void);
+
+      /**
+       * Initializes the overrun and cycle time variables of an agent
+       * @param  controller_index  the index of the hosted agent
+       **/
+      void init_schedule_vars_ (size_t controller_index);
 
-      /// Algorithm to perform
-      algorithms::BaseAlgorithm * algorithm_;
+      /// Controllers for the hosted agents
+      std::vector <BaseController *> controllers_;
 
-      /// Containers for algorithm information
-      variables::Algorithms algorithms_;
-      
-      /// Containers for agent-related variables
-      variables::Agents agents_;
+      /// Scheduling information for each hosted agent
+      std::vector <AgentSchedule> schedules_;
 
-      /// Knowledge base
+      /// Knowledge base shared by all hosted agents
       madara::knowledge::KnowledgeBase & knowledge_;
 
-      /// Platform on which the controller is running
-      platforms::BasePlatform * platform_;
+      /// Settings for controller management and qos
+      ControllerSettings settings_;
 
-      /// Containers for platform information
-      variables::Platforms platforms_;
+      /// the id of the first hosted agent
+      madara::knowledge::KnowledgeRecord::Integer first_id_;
 
-      /// Containers for self-referencing variables
-      variables::Self self_;
+      /// the number of worker threads (0 is automatic)
+      size_t num_threads_;
 
-      /// Containers for sensor information
-      variables::Sensors sensors_;
+      /// protects schedules_, terminated_ and return_value_
+      mutable std::mutex schedule_lock_;
 
-      /// Containers for swarm-related variables
-      variables::Swarm swarm_;
+      /// signals workers when an agent becomes available or on termination
+      std::condition_variable schedule_changed_;
 
-    private:
+      /// true if workers should exit
+      bool terminated_;
 
-      /// Code shared between run and run_once
-      int run_once_ (void);
+      /// the aggregated result of the agent MAPE cycles
+      int return_value_;
     };
   }
 }
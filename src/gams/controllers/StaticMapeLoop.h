@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file StaticMapeLoop.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a MAPE loop whose phases are bound at compile time
+ **/
+
+#ifndef   _GAMS_CONTROLLERS_STATICMAPELOOP_H_
+#define   _GAMS_CONTROLLERS_STATICMAPELOOP_H_
+
+#include <string>
+#include <thread>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/ContextGuard.h"
+#include "madara/utility/Utility.h"
+
+namespace gams
+{
+  namespace controllers
+  {
+    /**
+     * A MAPE phase that does nothing. Useful for omitting phases of a
+     * StaticMapeLoop.
+     **/
+    struct NullPhase
+    {
+      /**
+       * Does nothing
+       * @return 0, so the loop continues
+       **/
+      inline int operator() (madara::knowledge::KnowledgeBase &)
+      {
+        return 0;
+      }
+    };
+
+    /**
+     * A MAPE loop with phases bound at compile time. Each phase is a
+     * functor with the signature int (madara::knowledge::KnowledgeBase &),
+     * so calls are inlined rather than dispatched through KaRL functions
+     * as in MapeLoop. Like MapeLoop, a phase should return 0 unless the
+     * loop should stop.
+     *
+     * An optional KaRL expression can be evaluated after the execute phase
+     * of each cycle for custom logic that is easier to express in KaRL.
+     **/
+    template <typename Monitor, typename Analyze = NullPhase,
+      typename Plan = NullPhase, typename Execute = NullPhase>
+    class StaticMapeLoop
+    {
+    public:
+      /**
+       * Constructor
+       * @param   knowledge   The knowledge base to reference and mutate
+       * @param   monitor     the monitor phase
+       * @param   analyze     the analyze phase
+       * @param   plan        the plan phase
+       * @param   execute     the execute phase
+       **/
+      StaticMapeLoop (madara::knowledge::KnowledgeBase & knowledge,
+        const Monitor & monitor = Monitor (),
+        const Analyze & analyze = Analyze (),
+        const Plan & plan = Plan (),
+        const Execute & execute = Execute ())
+        : knowledge_ (knowledge), monitor_ (monitor), analyze_ (analyze),
+        plan_ (plan), execute_ (execute), has_expression_ (false)
+      {
+      }
+
+      /**
+       * Defines a KaRL expression to evaluate after the execute phase.
+       * An empty expression removes it.
+       * @param  expression   the KaRL logic to evaluate each cycle
+       **/
+      void define_expression (const std::string & expression)
+      {
+        has_expression_ = expression != "";
+
+        if (has_expression_)
+        {
+          expression_ = knowledge_.compile (expression);
+        }
+      }
+
+      /**
+       * Runs a single MAPE cycle and sends modified values
+       * @return  non-zero if a phase or the expression requested a stop
+       **/
+      madara::knowledge::KnowledgeRecord run_once (void)
+      {
+        madara::knowledge::KnowledgeRecord result;
+
+        {
+          madara::knowledge::ContextGuard guard (knowledge_);
+
+          int phases = monitor_ (knowledge_);
+          phases |= analyze_ (knowledge_);
+          phases |= plan_ (knowledge_);
+          phases |= execute_ (knowledge_);
+
+          result = madara::knowledge::KnowledgeRecord (
+            madara::knowledge::KnowledgeRecord::Integer (phases));
+
+          if (has_expression_)
+          {
+            madara::knowledge::EvalSettings settings;
+            settings.delay_sending_modifieds = true;
+
+            madara::knowledge::KnowledgeRecord value =
+              knowledge_.evaluate (expression_, settings);
+
+            if (!phases)
+            {
+              result = value;
+            }
+          }
+        }
+
+        knowledge_.send_modifieds ();
+
+        return result;
+      }
+
+      /**
+       * Runs the MAPE loop until a cycle returns non-zero or the maximum
+       * runtime is reached
+       * @param  period       time between executions of the loop
+       * @param  max_runtime  maximum runtime within the MAPE loop
+       * @return  the result of the last MAPE cycle
+       **/
+      madara::knowledge::KnowledgeRecord run (double period = 0.5,
+        double max_runtime = -1)
+      {
+        madara::utility::TimeValue current = madara::utility::Clock::now ();
+        madara::utility::Duration window =
+          madara::utility::seconds_to_duration (period);
+        madara::utility::TimeValue next_loop = current;
+        madara::utility::TimeValue end_time = current +
+          madara::utility::seconds_to_duration (max_runtime);
+
+        madara::knowledge::KnowledgeRecord result = run_once ();
+
+        while (!result.is_true ())
+        {
+          current = madara::utility::Clock::now ();
+
+          if (max_runtime >= 0 && current >= end_time)
+          {
+            break;
+          }
+
+          if (period > 0)
+          {
+            next_loop += window;
+
+            if (next_loop > current)
+            {
+              std::this_thread::sleep_until (next_loop);
+            }
+            else
+            {
+              next_loop = current;
+            }
+          }
+
+          result = run_once ();
+        }
+
+        return result;
+      }
+
+      /**
+       * Returns the monitor phase
+       * @return the monitor functor
+       **/
+      Monitor & get_monitor (void)
+      {
+        return monitor_;
+      }
+
+      /**
+       * Returns the analyze phase
+       * @return the analyze functor
+       **/
+      Analyze & get_analyze (void)
+      {
+        return analyze_;
+      }
+
+      /**
+       * Returns the plan phase
+       * @return the plan functor
+       **/
+      Plan & get_plan (void)
+      {
+        return plan_;
+      }
+
+      /**
+       * Returns the execute phase
+       * @return the execute functor
+       **/
+      Execute & get_execute (void)
+      {
+        return execute_;
+      }
+
+    protected:
+
+      /// knowledge base
+      madara::knowledge::KnowledgeBase & knowledge_;
+
+      /// the monitor phase
+      Monitor monitor_;
+
+      /// the analyze phase
+      Analyze analyze_;
+
+      /// the plan phase
+      Plan plan_;
+
+      /// the execute phase
+      Execute execute_;
+
+      /// true if expression_ should be evaluated each cycle
+      bool has_expression_;
+
+      /// optional KaRL logic evaluated after the execute phase
+      madara::knowledge::CompiledExpression expression_;
+    };
+  }
+}
+
+#endif // _GAMS_CONTROLLERS_STATICMAPELOOP_H_
@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+#include "TriggerWatcher.h"
+
+#include "madara/knowledge/ContextGuard.h"
+#include "gams/loggers/GlobalLogger.h"
+
+gams::controllers::TriggerWatcher::TriggerWatcher (
+  madara::knowledge::KnowledgeBase & knowledge)
+  : knowledge_ (knowledge), alarm_set_ (false), terminated_ (false),
+  wakeups_ (0)
+{
+}
+
+gams::controllers::TriggerWatcher::~TriggerWatcher ()
+{
+  if (alarm_thread_.joinable ())
+  {
+    {
+      std::lock_guard <std::mutex> lock (alarm_mutex_);
+      terminated_ = true;
+    }
+
+    alarm_changed_.notify_one ();
+    alarm_thread_.join ();
+  }
+}
+
+void
+gams::controllers::TriggerWatcher::add (const std::string & name)
+{
+  madara::knowledge::VariableReference ref = knowledge_.get_ref (name);
+
+  refs_.push_back (ref);
+  clocks_.push_back (knowledge_.get (ref).clock);
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MINOR,
+    "gams::controllers::TriggerWatcher::add:" \
+    " watching %s\n", name.c_str ());
+}
+
+size_t
+gams::controllers::TriggerWatcher::size (void) const
+{
+  return refs_.size ();
+}
+
+bool
+gams::controllers::TriggerWatcher::changed (void)
+{
+  bool result (false);
+
+  madara::knowledge::ContextGuard guard (knowledge_);
+
+  for (size_t i = 0; i < refs_.size (); ++i)
+  {
+    uint64_t clock = knowledge_.get (refs_[i]).clock;
+
+    if (clock != clocks_[i])
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MINOR,
+        "gams::controllers::TriggerWatcher::changed:" \
+        " %s was updated\n", refs_[i].get_name ());
+
+      clocks_[i] = clock;
+      result = true;
+    }
+  }
+
+  return result;
+}
+
+bool
+gams::controllers::TriggerWatcher::wait (
+  const madara::utility::TimeValue & deadline)
+{
+  madara::knowledge::ThreadSafeContext & context = knowledge_.get_context ();
+
+  // holding the context between the check and the wait means no update or
+  // alarm can be signalled in between and be missed
+  madara::knowledge::ContextGuard guard (knowledge_);
+
+  bool result = changed ();
+
+  if (!result && madara::utility::Clock::now () < deadline)
+  {
+    set_alarm_ (deadline);
+
+    do
+    {
+      // releases the context until any variable changes or the alarm rings
+      context.wait_for_change (true);
+      ++wakeups_;
+
+      result = changed ();
+    }
+    while (!result && madara::utility::Clock::now () < deadline);
+
+    clear_alarm_ ();
+  }
+
+  return result;
+}
+
+size_t
+gams::controllers::TriggerWatcher::get_wakeups (void) const
+{
+  return wakeups_;
+}
+
+void
+gams::controllers::TriggerWatcher::set_alarm_ (
+  const madara::utility::TimeValue & deadline)
+{
+  {
+    std::lock_guard <std::mutex> lock (alarm_mutex_);
+    alarm_ = deadline;
+    alarm_set_ = true;
+
+    if (!alarm_thread_.joinable ())
+    {
+      alarm_thread_ = std::thread (&TriggerWatcher::run_alarm_, this);
+    }
+  }
+
+  alarm_changed_.notify_one ();
+}
+
+void
+gams::controllers::TriggerWatcher::clear_alarm_ (void)
+{
+  std::lock_guard <std::mutex> lock (alarm_mutex_);
+  alarm_set_ = false;
+}
+
+void
+gams::controllers::TriggerWatcher::run_alarm_ (void)
+{
+  std::unique_lock <std::mutex> lock (alarm_mutex_);
+
+  while (!terminated_)
+  {
+    if (!alarm_set_)
+    {
+      alarm_changed_.wait (lock);
+    }
+    else if (madara::utility::Clock::now () < alarm_)
+    {
+      alarm_changed_.wait_until (lock, alarm_);
+    }
+    else
+    {
+      alarm_set_ = false;
+
+      // never take the context while holding the alarm, since wait holds
+      // the context while setting the alarm
+      lock.unlock ();
+
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_DETAILED,
+        "gams::controllers::TriggerWatcher::run_alarm_:" \
+        " deadline reached, waking waiters\n");
+
+      knowledge_.get_context ().signal ();
+
+      lock.lock ();
+    }
+  }
+}
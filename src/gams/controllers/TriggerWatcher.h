@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file TriggerWatcher.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a watcher that waits for changes to trigger variables
+ **/
+
+#ifndef   _GAMS_CONTROLLERS_TRIGGERWATCHER_H_
+#define   _GAMS_CONTROLLERS_TRIGGERWATCHER_H_
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "gams/GamsExport.h"
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/VariableReference.h"
+#include "madara/utility/Utility.h"
+
+namespace gams
+{
+  namespace controllers
+  {
+    /**
+     * Watches a set of knowledge base variables and waits until one of
+     * them is updated, either locally or by a transport. Updates are
+     * detected from the Lamport clocks of the records, so a write of the
+     * same value still counts as a trigger.
+     *
+     * Waiting blocks on the knowledge base's change notification, so an
+     * idle watcher only wakes when something in the knowledge base is
+     * updated or its deadline passes. Deadlines are delivered by an alarm
+     * thread that is started on the first wait.
+     **/
+    class GAMS_EXPORT TriggerWatcher
+    {
+    public:
+      /**
+       * Constructor
+       * @param  knowledge   the knowledge base containing the triggers
+       **/
+      TriggerWatcher (madara::knowledge::KnowledgeBase & knowledge);
+
+      /**
+       * Destructor. Stops the alarm thread.
+       **/
+      ~TriggerWatcher ();
+
+      /**
+       * Adds a trigger variable
+       * @param  name   the name of the variable
+       **/
+      void add (const std::string & name);
+
+      /**
+       * Returns the number of trigger variables
+       * @return the number of triggers
+       **/
+      size_t size (void) const;
+
+      /**
+       * Checks if any trigger changed since the last call to changed or
+       * wait, and remembers the current clocks
+       * @return true if a trigger changed
+       **/
+      bool changed (void);
+
+      /**
+       * Waits until a trigger changes or a deadline passes. The knowledge
+       * base must not be locked by the caller.
+       * @param  deadline   the latest time to return
+       * @return true if a trigger changed, false on timeout
+       **/
+      bool wait (const madara::utility::TimeValue & deadline);
+
+      /**
+       * Returns the number of times wait has been woken up to check the
+       * triggers, whether by a knowledge base change or a deadline
+       * @return the number of wakeups
+       **/
+      size_t get_wakeups (void) const;
+
+    private:
+
+      // watchers own a thread and may not be copied
+      TriggerWatcher (const TriggerWatcher &);
+      TriggerWatcher & operator= (const TriggerWatcher &);
+
+      /**
+       * Schedules a wakeup of the knowledge base's waiters
+       * @param  deadline   the time to wake the waiters at
+       **/
+      void set_alarm_ (const madara::utility::TimeValue & deadline);
+
+      /**
+       * Cancels a scheduled wakeup
+       **/
+      void clear_alarm_ (void);
+
+      /**
+       * Signals the knowledge base whenever a scheduled wakeup is due
+       **/
+      void run_alarm_ (void);
+
+      /// the knowledge base containing the triggers
+      madara::knowledge::KnowledgeBase & knowledge_;
+
+      /// protects the alarm
+      std::mutex alarm_mutex_;
+
+      /// notifies the alarm thread of a new or cancelled alarm
+      std::condition_variable alarm_changed_;
+
+      /// the time of the scheduled wakeup
+      madara::utility::TimeValue alarm_;
+
+      /// true if a wakeup is scheduled
+      bool alarm_set_;
+
+      /// true when the alarm thread should exit
+      bool terminated_;
+
+      /// the thread delivering deadlines
+      std::thread alarm_thread_;
+
+      /// number of wakeups while waiting
+      size_t wakeups_;
+
+      /// references to the trigger variables
+      std::vector <madara::knowledge::VariableReference> refs_;
+
+      /// the last seen clock of each trigger
+      std::vector <uint64_t> clocks_;
+    };
+  }
+}
+
+#endif // _GAMS_CONTROLLERS_TRIGGERWATCHER_H_
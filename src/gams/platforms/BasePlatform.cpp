@@ -259,6 +259,66 @@ gams::platforms::BasePlatform::pause_move (void)
   status_.paused_moving = 1;
 }
 
+bool
+gams::platforms::BasePlatform::sense_sample (PlatformSample &)
+{
+  return false;
+}
+
+bool
+gams::platforms::BasePlatform::supports_sense_sample (void) const
+{
+  return false;
+}
+
+void
+gams::platforms::BasePlatform::apply_sample (const PlatformSample & sample)
+{
+  if (sample.has_location)
+  {
+    self_->agent.location.set (0, sample.location[0]);
+    self_->agent.location.set (1, sample.location[1]);
+    self_->agent.location.set (2, sample.location[2]);
+  }
+
+  if (sample.has_orientation)
+  {
+    self_->agent.orientation.set (0, sample.orientation[0]);
+    self_->agent.orientation.set (1, sample.orientation[1]);
+    self_->agent.orientation.set (2, sample.orientation[2]);
+  }
+
+  if (sample.status_mask)
+  {
+    struct StatusFlag
+    {
+      int flag;
+      madara::knowledge::containers::Integer * container;
+    };
+
+    StatusFlag flags [] = {
+      { OK, &status_.ok },
+      { WAITING, &status_.waiting },
+      { DEADLOCKED, &status_.deadlocked },
+      { FAILED, &status_.failed },
+      { MOVING, &status_.moving },
+      { REDUCED_SENSING_AVAILABLE, &status_.reduced_sensing },
+      { REDUCED_MOVEMENT_AVAILABLE, &status_.reduced_movement },
+      { COMMUNICATION_AVAILABLE, &status_.communication_available },
+      { SENSORS_AVAILABLE, &status_.sensors_available },
+      { MOVEMENT_AVAILABLE, &status_.movement_available }
+    };
+
+    for (size_t i = 0; i < sizeof (flags) / sizeof (StatusFlag); ++i)
+    {
+      if (sample.status_mask & flags[i].flag)
+      {
+        *flags[i].container = (sample.status & flags[i].flag) ? 1 : 0;
+      }
+    }
+  }
+}
+
 void
 gams::platforms::BasePlatform::set_knowledge (
   madara::knowledge::KnowledgeBase * rhs)
@@ -105,6 +105,43 @@ namespace gams
       PLATFORM_ARRIVED = 2
     };
 
+    /**
+     * A snapshot of platform state taken without accessing the knowledge
+     * base. Values are stored in the layout of the agent's location and
+     * orientation containers.
+     **/
+    struct GAMS_EXPORT PlatformSample
+    {
+      /**
+       * Constructor
+       **/
+      PlatformSample ()
+        : has_location (false), has_orientation (false),
+          status (0), status_mask (0)
+      {
+        location[0] = location[1] = location[2] = 0;
+        orientation[0] = orientation[1] = orientation[2] = 0;
+      }
+
+      /// the location, as written to agent.{id}.location
+      double location[3];
+
+      /// true if location was sensed
+      bool has_location;
+
+      /// the orientation, as written to agent.{id}.orientation
+      double orientation[3];
+
+      /// true if orientation was sensed
+      bool has_orientation;
+
+      /// status flags. @see PlatformAnalyzeStatus
+      int status;
+
+      /// the flags in status that were sensed
+      int status_mask;
+    };
+
     /// Interface for defining a bounds checker for Positions
     class GAMS_EXPORT PositionBounds {
     public:
@@ -426,6 +463,29 @@ namespace gams
        **/
       virtual int sense (void) = 0;
 
+      /**
+       * Polls position, orientation and status into a sample without
+       * accessing the knowledge base. Platforms that support this may be
+       * sensed from a PlatformSenseThread, so implementations must be safe
+       * to call concurrently with move, orient and analyze.
+       * @param  sample   the sample to fill
+       * @return true if the sample was filled
+       **/
+      virtual bool sense_sample (PlatformSample & sample);
+
+      /**
+       * Checks if the platform implements sense_sample
+       * @return true if the platform may be sensed from another thread
+       **/
+      virtual bool supports_sense_sample (void) const;
+
+      /**
+       * Writes a sample into the self and platform status variables. This
+       * is O(1) and should be called with the knowledge base locked.
+       * @param  sample   the sample to apply
+       **/
+      void apply_sample (const PlatformSample & sample);
+
       /**
        * Sets the knowledge base to use for the platform
        * @param  rhs  the new knowledge base to use
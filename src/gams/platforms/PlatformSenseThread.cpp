@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+#include "PlatformSenseThread.h"
+
+#include "gams/loggers/GlobalLogger.h"
+#include "madara/utility/Utility.h"
+
+gams::platforms::PlatformSenseThread::PlatformSenseThread (
+  BasePlatform & platform, double hertz)
+  : platform_ (platform), period_ (hertz > 0 ? 1.0 / hertz : 0.0),
+  samples_ (0), terminated_ (false)
+{
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::platforms::PlatformSenseThread::constructor:" \
+    " sensing %s at %f hz\n", platform_.get_id ().c_str (), hertz);
+
+  thread_ = std::thread (&PlatformSenseThread::run_, this);
+}
+
+gams::platforms::PlatformSenseThread::~PlatformSenseThread ()
+{
+  {
+    std::lock_guard <std::mutex> guard (lock_);
+    terminated_ = true;
+  }
+
+  changed_.notify_all ();
+
+  if (thread_.joinable ())
+  {
+    thread_.join ();
+  }
+}
+
+bool
+gams::platforms::PlatformSenseThread::take (PlatformSample & sample)
+{
+  return latest_.read (sample);
+}
+
+size_t
+gams::platforms::PlatformSenseThread::get_samples (void) const
+{
+  return samples_.load (std::memory_order_relaxed);
+}
+
+void
+gams::platforms::PlatformSenseThread::run_ (void)
+{
+  madara::utility::Duration window =
+    madara::utility::seconds_to_duration (period_);
+  madara::utility::TimeValue next_sense = madara::utility::Clock::now ();
+
+  std::unique_lock <std::mutex> lock (lock_);
+
+  while (!terminated_)
+  {
+    lock.unlock ();
+
+    PlatformSample sample;
+    bool sensed (false);
+
+    try {
+      sensed = platform_.sense_sample (sample);
+    } catch (std::exception & e) {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::platforms::PlatformSenseThread::run_:" \
+        " exception in platform_.sense_sample (): %s\n", e.what ());
+    }
+
+    if (sensed)
+    {
+      latest_.write (sample);
+      samples_.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    lock.lock ();
+
+    if (period_ > 0)
+    {
+      madara::utility::TimeValue current = madara::utility::Clock::now ();
+
+      while (next_sense <= current)
+      {
+        next_sense += window;
+      }
+
+      changed_.wait_until (lock, next_sense,
+        [this] { return terminated_; });
+    }
+  }
+}
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file PlatformSenseThread.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a thread that senses a platform at its own rate
+ **/
+
+#ifndef   _GAMS_PLATFORMS_PLATFORMSENSETHREAD_H_
+#define   _GAMS_PLATFORMS_PLATFORMSENSETHREAD_H_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "gams/GamsExport.h"
+#include "gams/platforms/BasePlatform.h"
+#include "gams/utility/LatestValue.h"
+
+namespace gams
+{
+  namespace platforms
+  {
+    /**
+     * Calls BasePlatform::sense_sample on a dedicated thread and hands the
+     * latest sample to the controller through a lock-free slot. This keeps
+     * blocking platform I/O from holding the knowledge base lock.
+     **/
+    class GAMS_EXPORT PlatformSenseThread
+    {
+    public:
+      /**
+       * Constructor. Starts the sense thread.
+       * @param  platform  the platform to sense. Must outlive this object.
+       * @param  hertz     the rate to sense at. Non-positive senses as
+       *                   fast as possible.
+       **/
+      PlatformSenseThread (BasePlatform & platform, double hertz);
+
+      /**
+       * Destructor. Stops and joins the sense thread.
+       **/
+      ~PlatformSenseThread ();
+
+      /**
+       * Takes the latest sample if a new one is available. Must only be
+       * called from one thread (the controller thread).
+       * @param  sample   filled with the latest sample
+       * @return true if a new sample was taken
+       **/
+      bool take (PlatformSample & sample);
+
+      /**
+       * Returns the number of samples sensed by the thread
+       * @return the number of successful sense_sample calls
+       **/
+      size_t get_samples (void) const;
+
+    private:
+
+      /**
+       * Main function of the sense thread
+       **/
+      void run_ (void);
+
+      /// the platform being sensed
+      BasePlatform & platform_;
+
+      /// time between senses in seconds
+      double period_;
+
+      /// the latest sample
+      utility::LatestValue <PlatformSample> latest_;
+
+      /// number of samples sensed
+      std::atomic <size_t> samples_;
+
+      /// protects terminated_
+      std::mutex lock_;
+
+      /// signals termination
+      std::condition_variable changed_;
+
+      /// true if the thread should exit
+      bool terminated_;
+
+      /// the sense thread
+      std::thread thread_;
+    };
+  }
+}
+
+#endif // _GAMS_PLATFORMS_PLATFORMSENSETHREAD_H_
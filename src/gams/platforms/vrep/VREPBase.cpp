@@ -89,6 +89,7 @@ gams::platforms::VREPBase::VREPBase (
     agent_is_ready_ (false),
     vrep_is_ready_ (false),
     sim_is_running_ (false),
+    sense_ready_ (false),
     model_file_ (model_file),
     is_client_side_ (is_client_side),
     begin_sim_ ("begin_sim", *knowledge),
@@ -133,6 +134,15 @@ gams::platforms::VREPBase::VREPBase (
       // establish sensor
       variables::Sensor* coverage_sensor =
         new variables::Sensor ("coverage", knowledge, 2.5, origin);
+
+      // delta mode is opt-in, since dynamic_simulation measures coverage
+      // by resetting cells to 0, which max merged deltas never apply.
+      // Coverage values are clocks, so the latest coverage of a cell wins.
+      if (knowledge->get (".vrep_coverage_deltas").is_true ())
+      {
+        coverage_sensor->set_delta_mode (self->agent.prefix,
+          variables::Sensor::MERGE_MAX, 50);
+      }
       (*sensors)["coverage"] = coverage_sensor;
     }
     (*sensors_)["coverage"] = (*sensors)["coverage"];
@@ -259,55 +269,18 @@ gams::platforms::VREPBase::sense (void)
 {
   if (get_ready ())
   {
-    // get position
-    simxFloat curr_arr[3];
-    simxFloat curr_orientation[3];
-    VREP_LOCK
-    {
-      simxGetObjectPosition (client_id_, node_id_, -1, curr_arr,
-                                     simx_opmode_oneshot_wait);
-
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_DETAILED,
-        "gams::algorithms::platforms::VREPBase:" \
-        " vrep position: %f,%f,%f\n", curr_arr[0], curr_arr[1], curr_arr[2]);
-
-      simxGetObjectOrientation (client_id_, node_id_, -1, curr_orientation,
-        simx_opmode_oneshot_wait);
-
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_DETAILED,
-        "gams::algorithms::platforms::VREPBase:" \
-        " vrep orientation: %f,%f,%f\n",
-        curr_orientation[0], curr_orientation[1], curr_orientation[2]);
+    sense_ready_ = true;
 
-      pose::Position vrep_loc(get_vrep_frame (), curr_arr);
-      pose::Position loc(pose::gps_frame(), vrep_loc);
+    PlatformSample sample;
+    sense_sample (sample);
 
-      pose::euler::EulerVREP vrep_euler (
-        curr_orientation[0], curr_orientation[1], curr_orientation[2]);
-
-      pose::Orientation vrep_orient (get_vrep_frame (), vrep_euler.to_quat ());
-
-      pose::euler::YawPitchRoll vrep_yawpitchroll (vrep_orient);
-
-      madara_logger_ptr_log (gams::loggers::global_logger.get (),
-        gams::loggers::LOG_DETAILED,
-        "gams::algorithms::platforms::VREPBase:" \
-        " gps position: %f,%f,%f\n", loc.lat (), loc.lng (), loc.alt ());
-
-      // set position in madara
-      loc.to_container (self_->agent.location);
-      self_->agent.orientation.set (2, vrep_yawpitchroll.c ());
-      self_->agent.orientation.set (0, vrep_yawpitchroll.a ());
-      self_->agent.orientation.set (1, vrep_yawpitchroll.b ());
-
-      // now that location is set, make sure movement_available is enabled
-      status_.movement_available = 1;
-    }
+    // set position in madara
+    apply_sample (sample);
   }
   else
   {
+    sense_ready_ = false;
+
     madara_logger_ptr_log (gams::loggers::global_logger.get (),
       gams::loggers::LOG_MAJOR,
       "gams::platforms::VREPBase::sense:" \
@@ -320,15 +293,88 @@ gams::platforms::VREPBase::sense (void)
   return 0;
 }
 
+bool
+gams::platforms::VREPBase::sense_sample (PlatformSample & sample)
+{
+  if (!sense_ready_)
+  {
+    return false;
+  }
+
+  // get position
+  simxFloat curr_arr[3];
+  simxFloat curr_orientation[3];
+  VREP_LOCK
+  {
+    simxGetObjectPosition (client_id_, node_id_, -1, curr_arr,
+                                   simx_opmode_oneshot_wait);
+
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_DETAILED,
+      "gams::algorithms::platforms::VREPBase:" \
+      " vrep position: %f,%f,%f\n", curr_arr[0], curr_arr[1], curr_arr[2]);
+
+    simxGetObjectOrientation (client_id_, node_id_, -1, curr_orientation,
+      simx_opmode_oneshot_wait);
+
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_DETAILED,
+      "gams::algorithms::platforms::VREPBase:" \
+      " vrep orientation: %f,%f,%f\n",
+      curr_orientation[0], curr_orientation[1], curr_orientation[2]);
+  }
+
+  pose::Position vrep_loc(get_vrep_frame (), curr_arr);
+  pose::Position loc(pose::gps_frame(), vrep_loc);
+
+  pose::euler::EulerVREP vrep_euler (
+    curr_orientation[0], curr_orientation[1], curr_orientation[2]);
+
+  pose::Orientation vrep_orient (get_vrep_frame (), vrep_euler.to_quat ());
+
+  pose::euler::YawPitchRoll vrep_yawpitchroll (vrep_orient);
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_DETAILED,
+    "gams::algorithms::platforms::VREPBase:" \
+    " gps position: %f,%f,%f\n", loc.lat (), loc.lng (), loc.alt ());
+
+  sample.location[0] = loc.get (0);
+  sample.location[1] = loc.get (1);
+  sample.location[2] = loc.get (2);
+  sample.has_location = true;
+
+  sample.orientation[0] = vrep_yawpitchroll.a ();
+  sample.orientation[1] = vrep_yawpitchroll.b ();
+  sample.orientation[2] = vrep_yawpitchroll.c ();
+  sample.has_orientation = true;
+
+  // now that location is set, make sure movement_available is enabled
+  sample.status = MOVEMENT_AVAILABLE;
+  sample.status_mask = MOVEMENT_AVAILABLE;
+
+  return true;
+}
+
+bool
+gams::platforms::VREPBase::supports_sense_sample (void) const
+{
+  return true;
+}
+
 int
 gams::platforms::VREPBase::analyze (void)
 {
-  if (get_ready ())
+  // readiness depends on the knowledge base, so it is checked here for
+  // sense threads that cannot access it
+  sense_ready_ = get_ready ();
+
+  if (sense_ready_)
   {
     // set position on coverage map
     pose::Position pos = get_location ();
-    (*sensors_)["coverage"]->set_value (
-      pos, knowledge_->get_context ().get_clock ());
+    variables::Sensor * coverage = (*sensors_)["coverage"];
+    coverage->set_value (pos, knowledge_->get_context ().get_clock ());
   }
   else
   {
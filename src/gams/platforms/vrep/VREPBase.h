@@ -70,6 +70,8 @@
 
 #include "gams/loggers/GlobalLogger.h"
 
+#include <atomic>
+
 #ifdef __GNUC__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
@@ -130,6 +132,20 @@ namespace gams
        **/
       virtual int sense (void);
 
+      /**
+       * Polls position and orientation from VREP into a sample. Returns
+       * false until sense or analyze has found the simulation to be ready.
+       * @param  sample   the sample to fill
+       * @return true if the sample was filled
+       **/
+      virtual bool sense_sample (PlatformSample & sample);
+
+      /**
+       * VREP platforms may be sensed from another thread
+       * @return true
+       **/
+      virtual bool supports_sense_sample (void) const;
+
       /**
        * Analyzes platform information
        * @return bitmask status of the platform. @see Status.
@@ -321,6 +337,9 @@ namespace gams
       /// tracks if the sim has started
       bool sim_is_running_;
 
+      /// tracks if the agent may be sensed from another thread
+      std::atomic <bool> sense_ready_;
+
       /**
       * VREP model file name
       **/
@@ -49,9 +49,160 @@
 #include "UTMFrame.h"
 #include "geodetic_utils/geodetic_conv.h"
 
+#include <atomic>
+#include <vector>
+
 namespace gams { namespace pose {
   namespace cartesian {
 
+    namespace {
+      /// number of GPS origins each thread keeps converters for
+      const size_t CONVERTER_CACHE_SIZE = 8;
+
+      std::atomic<double> fast_ltp_radius_(0);
+
+      /**
+       * Converter for a GPS origin, plus the curvature radii used by the
+       * local tangent plane approximation
+       **/
+      struct OriginConverter
+      {
+        double lat, lon, alt;
+        geodetic_util::GeodeticConverter conv;
+
+        /// meridian radius of curvature, plus altitude
+        double north_radius;
+
+        /// prime vertical radius of curvature, plus altitude
+        double east_radius;
+
+        /// cosine and tangent of the origin latitude
+        double cos_lat;
+        double tan_lat;
+
+        OriginConverter(double lat, double lon, double alt)
+          : lat(lat), lon(lon), alt(alt), conv(lat, lon, alt)
+        {
+          using namespace geodetic_util;
+
+          double phi = DEG_TO_RAD(lat);
+          double sin_phi = sin(phi);
+          double w = 1 - kFirstEccentricitySquared * sin_phi * sin_phi;
+
+          north_radius = kSemimajorAxis * (1 - kFirstEccentricitySquared) /
+                         (w * sqrt(w)) + alt;
+          east_radius = kSemimajorAxis / sqrt(w) + alt;
+          cos_lat = cos(phi);
+          tan_lat = tan(phi);
+        }
+
+        /// Local tangent plane approximation of ned2Geodetic
+        void fast_ned_to_gps(double &x, double &y, double &z) const
+        {
+          double north = x, east = y, down = z;
+          double dlat = north / north_radius -
+            east * east * tan_lat / (2 * north_radius * east_radius);
+          x = lat + RAD_TO_DEG(dlat);
+          y = lon + RAD_TO_DEG(east / (east_radius * cos_lat) *
+                               (1 + tan_lat * dlat));
+          z = alt - down + north * north / (2 * north_radius) +
+                           east * east / (2 * east_radius);
+        }
+
+        /// Local tangent plane approximation of geodetic2Ned
+        void fast_gps_to_ned(double &x, double &y, double &z) const
+        {
+          double dlon = y - lon;
+          if (dlon > 180)
+            dlon -= 360;
+          else if (dlon < -180)
+            dlon += 360;
+
+          double dlat = DEG_TO_RAD(x - lat);
+          double east = DEG_TO_RAD(dlon) * east_radius * cos_lat *
+                        (1 - tan_lat * dlat);
+          double north = dlat * north_radius +
+            east * east * tan_lat / (2 * east_radius);
+          double up = z - alt;
+          x = north;
+          y = east;
+          z = north * north / (2 * north_radius) +
+              east * east / (2 * east_radius) - up;
+        }
+
+        void ned_to_gps(double &x, double &y, double &z, double radius) const
+        {
+          if (x * x + y * y <= radius * radius) {
+            fast_ned_to_gps(x, y, z);
+          } else {
+            double lat, lon, alt;
+            conv.ned2Geodetic(x, y, z, &lat, &lon, &alt);
+            x = lat;
+            y = lon;
+            z = alt;
+          }
+        }
+
+        void gps_to_ned(double &x, double &y, double &z, double radius) const
+        {
+          if (radius > 0) {
+            double north = x, east = y, down = z;
+            fast_gps_to_ned(north, east, down);
+
+            if (north * north + east * east <= radius * radius) {
+              x = north;
+              y = east;
+              z = down;
+              return;
+            }
+          }
+
+          double north, east, down;
+          conv.geodetic2Ned(x, y, z, &north, &east, &down);
+          x = north;
+          y = east;
+          z = down;
+        }
+      };
+
+      /**
+       * Get the converter for a GPS origin. A frame version's origin never
+       * changes, so this amounts to one converter per frame version, with
+       * no locking since each thread keeps its own.
+       **/
+      const OriginConverter &get_converter(double lat, double lon, double alt)
+      {
+        static thread_local std::vector<OriginConverter> cache;
+        static thread_local size_t next = 0;
+
+        for (const OriginConverter &cur : cache) {
+          if (cur.lat == lat && cur.lon == lon && cur.alt == alt) {
+            return cur;
+          }
+        }
+
+        if (cache.size() < CONVERTER_CACHE_SIZE) {
+          cache.emplace_back(lat, lon, alt);
+          return cache.back();
+        }
+
+        OriginConverter &ret = cache[next];
+        ret = OriginConverter(lat, lon, alt);
+        next = (next + 1) % CONVERTER_CACHE_SIZE;
+        return ret;
+      }
+    }
+
+    double fast_ltp_radius(double meters)
+    {
+      return fast_ltp_radius_.exchange(meters);
+    }
+
+    double fast_ltp_radius()
+    {
+      return fast_ltp_radius_;
+    }
+
     double calc_distance(
                       const ReferenceFrameType * /*self*/,
                       double x1, double y1, double z1,
@@ -84,18 +235,7 @@ namespace gams { namespace pose {
         simple_rotate::orient_linear_vec(x, y, z, orx, ory, orz);
 
         if (fixed) {
-          geodetic_util::GeodeticConverter conv(ox, oy, oz);
-
-          double lat, lon, alt;
-          conv.ned2Geodetic(x, y, z, &lat, &lon, &alt);
-
-          std::cerr << ox << " " << oy << " " << oz << " :: " <<
-                       x << " " << y << " " << z << " -> " <<
-                       lat << " " << lon << " " << alt << std::endl;
-
-          x = lat;
-          y = lon;
-          z = alt;
+          get_converter(ox, oy, oz).ned_to_gps(x, y, z, fast_ltp_radius_);
         }
 
         self->normalize_linear(self, x, y, z);
@@ -139,18 +279,7 @@ namespace gams { namespace pose {
         self->normalize_linear(self, x, y, z);
 
         if (fixed) {
-          geodetic_util::GeodeticConverter conv(ox, oy, oz);
-
-          double north, east, down;
-          conv.geodetic2Ned(x, y, z, &north, &east, &down);
-
-          std::cerr << ox << " " << oy << " " << oz << " :: " <<
-                       x << " " << y << " " << z << " -> " <<
-                       north << " " << east << " " << down << std::endl;
-
-          x = north;
-          y = east;
-          z = down;
+          get_converter(ox, oy, oz).gps_to_ned(x, y, z, fast_ltp_radius_);
         }
 
         simple_rotate::orient_linear_vec(x, y, z, orx, ory, orz, true);
@@ -173,6 +302,82 @@ namespace gams { namespace pose {
       }
     }
 
+    void transform_linear_batch_to_origin(
+                      const ReferenceFrameType *origin,
+                      const ReferenceFrameType *self,
+                      double ox, double oy, double oz,
+                      double orx, double ory, double orz,
+                      double *x, double *y, double *z, size_t count,
+                      bool fixed)
+    {
+      if (origin->type_id == self->type_id) {
+        impl::ChainTransform hop;
+        hop.to_origin(ox, oy, oz, orx, ory, orz);
+        hop.apply_linear(x, y, z, count, fixed);
+      } else if (origin->type_id == GPS->type_id) {
+        impl::ChainTransform hop;
+        hop.to_origin(0, 0, 0, orx, ory, orz);
+        hop.apply_linear(x, y, z, count, false);
+
+        if (fixed) {
+          const OriginConverter &conv = get_converter(ox, oy, oz);
+          double radius = fast_ltp_radius_;
+
+          if (radius > 0) {
+            for (size_t i = 0; i < count; ++i) {
+              conv.ned_to_gps(x[i], y[i], z[i], radius);
+            }
+          } else {
+            conv.conv.ned2GeodeticBatch(x, y, z, count);
+          }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+          self->normalize_linear(self, x[i], y[i], z[i]);
+        }
+      } else {
+        throw undefined_transform(self, origin, true);
+      }
+    }
+
+    void transform_linear_batch_from_origin(
+                      const ReferenceFrameType *origin,
+                      const ReferenceFrameType *self,
+                      double ox, double oy, double oz,
+                      double orx, double ory, double orz,
+                      double *x, double *y, double *z, size_t count,
+                      bool fixed)
+    {
+      if (origin->type_id == self->type_id) {
+        impl::ChainTransform hop;
+        hop.from_origin(ox, oy, oz, orx, ory, orz);
+        hop.apply_linear(x, y, z, count, fixed);
+      } else if (origin->type_id == GPS->type_id) {
+        for (size_t i = 0; i < count; ++i) {
+          self->normalize_linear(self, x[i], y[i], z[i]);
+        }
+
+        if (fixed) {
+          const OriginConverter &conv = get_converter(ox, oy, oz);
+          double radius = fast_ltp_radius_;
+
+          if (radius > 0) {
+            for (size_t i = 0; i < count; ++i) {
+              conv.gps_to_ned(x[i], y[i], z[i], radius);
+            }
+          } else {
+            conv.conv.geodetic2NedBatch(x, y, z, count);
+          }
+        }
+
+        impl::ChainTransform hop;
+        hop.from_origin(0, 0, 0, orx, ory, orz);
+        hop.apply_linear(x, y, z, count, false);
+      } else {
+        throw undefined_transform(self, origin, false);
+      }
+    }
+
     const ReferenceFrameType CartesianImpl = {
       1, "Cartesian",
       transform_linear_to_origin,
@@ -186,6 +391,8 @@ namespace gams { namespace pose {
       simple_rotate::transform_pose_to_origin,
       simple_rotate::transform_pose_from_origin,
       default_normalize_pose,
+      transform_linear_batch_to_origin,
+      transform_linear_batch_from_origin,
     };
   } // End namespace cartesian
 
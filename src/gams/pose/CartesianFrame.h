@@ -75,6 +75,30 @@ namespace gams
      * Conversions to/from a parent GPS frame are supported.
      **/
     namespace cartesian {
+      /**
+       * Set the distance, in meters from a Cartesian frame's GPS origin,
+       * within which conversions to and from that GPS frame use a local
+       * tangent plane approximation, corrected for earth curvature,
+       * instead of the exact ECEF conversion. Beyond it, the exact
+       * conversion is always used.
+       *
+       * Error grows with the cube of the distance. Compared to the exact
+       * conversion, it stays under 5mm within 1km, and under 5cm within
+       * 5km up to 75 degrees latitude.
+       *
+       * @param meters the radius. 0 (the default) disables the
+       *        approximation.
+       * @return the previous radius
+       **/
+      GAMS_EXPORT double fast_ltp_radius(double meters);
+
+      /**
+       * Get the radius within which the local tangent plane
+       * approximation is used
+       *
+       * @return the radius, in meters. 0 if disabled.
+       **/
+      GAMS_EXPORT double fast_ltp_radius();
     }
 
     /**
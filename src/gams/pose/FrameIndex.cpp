@@ -0,0 +1,380 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file FrameIndex.cpp
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains an in-memory, time-indexed copy of saved frames
+ **/
+
+#include "gams/pose/FrameIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+
+using madara::knowledge::KnowledgeBase;
+using madara::knowledge::KnowledgeRecord;
+using madara::knowledge::KnowledgeMap;
+using madara::knowledge::ContextGuard;
+
+namespace gams { namespace pose {
+
+namespace {
+  using IndexKey = std::pair<const void *, std::string>;
+
+  std::mutex indexes_lock;
+
+  std::map<IndexKey, std::shared_ptr<FrameIndex>> indexes;
+
+  // lets find() skip the registry lock while nothing is indexed
+  std::atomic<size_t> indexes_count(0);
+
+  IndexKey make_index_key(KnowledgeBase &kb, const std::string &prefix)
+  {
+    return IndexKey(&kb.get_context(), prefix);
+  }
+
+  bool timestamp_less(const FrameIndex::Record &rec, uint64_t timestamp)
+  {
+    return rec.timestamp < timestamp;
+  }
+
+  bool complete(const FrameIndex::Record &rec)
+  {
+    return !rec.origin.empty();
+  }
+}
+
+void FrameIndex::enable(KnowledgeBase &kb,
+    const FrameEvalSettings &settings, size_t capacity)
+{
+  auto index = std::make_shared<FrameIndex>(settings.prefix(), capacity);
+  index->scan(kb);
+
+  std::lock_guard<std::mutex> guard(indexes_lock);
+  indexes[make_index_key(kb, settings.prefix())] = std::move(index);
+  indexes_count = indexes.size();
+}
+
+void FrameIndex::disable(KnowledgeBase &kb, const FrameEvalSettings &settings)
+{
+  std::lock_guard<std::mutex> guard(indexes_lock);
+  indexes.erase(make_index_key(kb, settings.prefix()));
+  indexes_count = indexes.size();
+}
+
+std::shared_ptr<FrameIndex> FrameIndex::find(
+    KnowledgeBase &kb, const std::string &prefix)
+{
+  if (indexes_count == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> guard(indexes_lock);
+  auto find = indexes.find(make_index_key(kb, prefix));
+  if (find == indexes.end()) {
+    return nullptr;
+  }
+  return find->second;
+}
+
+bool FrameIndex::parse(const std::string &key, std::string &id,
+    uint64_t &timestamp, std::string *field) const
+{
+  // keys look like <prefix>.<id>.<timestamp>[.<field>]
+  size_t start = prefix_.size() + 1;
+  if (key.size() <= start ||
+      key.compare(0, prefix_.size(), prefix_) != 0 ||
+      key[prefix_.size()] != '.') {
+    return false;
+  }
+
+  size_t end = key.size();
+  if (field) {
+    size_t dot = key.rfind('.');
+    if (dot == std::string::npos || dot < start) {
+      return false;
+    }
+    field->assign(key, dot + 1, std::string::npos);
+    end = dot;
+  }
+
+  size_t dot = key.rfind('.', end - 1);
+  if (dot == std::string::npos || dot <= start) {
+    return false;
+  }
+
+  const char *stamp = key.c_str() + dot + 1;
+  size_t stamp_len = end - dot - 1;
+  if (stamp_len == 3 && key.compare(dot + 1, 3, "inf") == 0) {
+    timestamp = -1;
+  } else if (stamp_len == 16) {
+    char *stamp_end;
+    timestamp = strtoull(stamp, &stamp_end, 16);
+    if (stamp_end != stamp + 16) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  id.assign(key, start, dot - start);
+  return true;
+}
+
+FrameIndex::Record &FrameIndex::insert(const std::string &id,
+    uint64_t timestamp)
+{
+  Ring &ring = rings_[id];
+  auto &records = ring.records;
+
+  auto iter = std::lower_bound(records.begin(), records.end(),
+      timestamp, timestamp_less);
+  if (iter != records.end() && iter->timestamp == timestamp) {
+    return *iter;
+  }
+
+  if (records.size() >= capacity_) {
+    ring.truncated = true;
+
+    // older than every version kept in a full ring; don't keep it
+    if (iter == records.begin()) {
+      discarded_ = Record();
+      return discarded_;
+    }
+    records.pop_front();
+    iter = std::lower_bound(records.begin(), records.end(),
+        timestamp, timestamp_less);
+  }
+
+  // versions are usually saved in order, so this is normally an append
+  iter = records.emplace(iter);
+  iter->timestamp = timestamp;
+  return *iter;
+}
+
+void FrameIndex::record(const std::string &key,
+    const ReferenceFrameVersion &frame)
+{
+  std::string id;
+  uint64_t timestamp;
+  if (!parse(key, id, timestamp, nullptr)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+
+  Record &rec = insert(id, timestamp);
+
+  // mirror what save_as writes; fields it skips keep their old values
+  if (frame.type() != Cartesian) {
+    rec.type = frame.name();
+  }
+
+  const ReferenceFrame &parent = frame.origin_frame();
+  if (parent.valid()) {
+    rec.parent = parent.id();
+  }
+
+  const Pose &origin = frame.origin();
+  rec.origin.assign({origin.x(), origin.y(), origin.z(),
+                     origin.rx(), origin.ry(), origin.rz()});
+}
+
+bool FrameIndex::record(const std::string &key, const KnowledgeRecord &value)
+{
+  std::string id;
+  std::string field;
+  uint64_t timestamp;
+  if (!parse(key, id, timestamp, &field)) {
+    return false;
+  }
+
+  if (field != "origin" && field != "parent" && field != "type") {
+    return field == "toi";
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+
+  Record &rec = insert(id, timestamp);
+
+  if (field == "origin") {
+    rec.origin = value.to_doubles();
+  } else if (field == "parent") {
+    rec.parent = value.to_string();
+  } else {
+    rec.type = value.to_string();
+  }
+  return true;
+}
+
+void FrameIndex::expire(const std::string &id, uint64_t time)
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  auto find = rings_.find(id);
+  if (find == rings_.end()) {
+    return;
+  }
+
+  auto &records = find->second.records;
+  auto end = std::lower_bound(records.begin(), records.end(),
+      time, timestamp_less);
+  records.erase(records.begin(), end);
+}
+
+FrameIndex::Lookup FrameIndex::get(const std::string &id,
+    uint64_t timestamp, Record &out) const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  auto find = rings_.find(id);
+  if (find == rings_.end()) {
+    return ABSENT;
+  }
+
+  const Ring &ring = find->second;
+  const auto &records = ring.records;
+
+  auto iter = std::lower_bound(records.begin(), records.end(),
+      timestamp, timestamp_less);
+  if (iter != records.end() && iter->timestamp == timestamp &&
+      complete(*iter)) {
+    out = *iter;
+    return FOUND;
+  }
+
+  if (ring.truncated && iter == records.begin()) {
+    return UNKNOWN;
+  }
+  return ABSENT;
+}
+
+FrameIndex::Lookup FrameIndex::neighbors(const std::string &id,
+    uint64_t timestamp, std::pair<uint64_t, uint64_t> &out) const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  out = std::make_pair((uint64_t)-1, (uint64_t)-1);
+
+  auto find = rings_.find(id);
+  if (find == rings_.end()) {
+    return FOUND;
+  }
+
+  const Ring &ring = find->second;
+  const auto &records = ring.records;
+
+  auto iter = std::lower_bound(records.begin(), records.end(),
+      timestamp, timestamp_less);
+  if (iter != records.end() && iter->timestamp == timestamp &&
+      complete(*iter)) {
+    out = std::make_pair(timestamp, timestamp);
+    return FOUND;
+  }
+
+  for (auto next = iter; next != records.end(); ++next) {
+    if (next->timestamp != timestamp && complete(*next)) {
+      out.second = next->timestamp;
+      break;
+    }
+  }
+
+  for (auto prev = iter; prev != records.begin();) {
+    --prev;
+    if (complete(*prev)) {
+      out.first = prev->timestamp;
+      return FOUND;
+    }
+  }
+
+  return ring.truncated ? UNKNOWN : FOUND;
+}
+
+size_t FrameIndex::size(const std::string &id) const
+{
+  std::lock_guard<std::mutex> guard(lock_);
+
+  auto find = rings_.find(id);
+  if (find == rings_.end()) {
+    return 0;
+  }
+  return find->second.records.size();
+}
+
+void FrameIndex::scan(KnowledgeBase &kb)
+{
+  std::string start = prefix_ + ".";
+
+  ContextGuard guard(kb);
+  KnowledgeMap &map = kb.get_context().get_map_unsafe();
+
+  for (auto iter = map.lower_bound(start); iter != map.end(); ++iter) {
+    if (iter->first.compare(0, start.size(), start) != 0) {
+      break;
+    }
+    record(iter->first, iter->second);
+  }
+}
+
+void FrameIndexFilter::filter(KnowledgeMap &records,
+    const madara::transport::TransportContext &,
+    madara::knowledge::Variables &)
+{
+  auto index = FrameIndex::find(kb_, prefix_);
+  if (!index) {
+    return;
+  }
+
+  for (const auto &update : records) {
+    index->record(update.first, update.second);
+  }
+}
+
+} }
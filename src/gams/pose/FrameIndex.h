@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file FrameIndex.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains an in-memory, time-indexed copy of saved frames
+ **/
+
+#ifndef _GAMS_POSE_FRAME_INDEX_H_
+#define _GAMS_POSE_FRAME_INDEX_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ReferenceFrame.h"
+#include "madara/filters/AggregateFilter.h"
+
+namespace gams { namespace pose {
+
+/**
+ * An in-memory, time-indexed copy of the frames saved in a KnowledgeBase
+ * under one prefix. Each frame ID keeps a ring of its most recent
+ * versions, sorted by timestamp. While an index is enabled,
+ * ReferenceFrame::load and its relatives find saved frames and
+ * interpolation neighbors by binary search, without building keys or
+ * walking the KnowledgeBase.
+ *
+ * ReferenceFrame::save and frame expiry keep the index up to date.
+ * Frames from other agents are recorded by a FrameIndexFilter, which must
+ * be added as a receive filter on each transport. If frames are changed
+ * in the KnowledgeBase any other way (e.g., loading a checkpoint), call
+ * enable() again to rebuild the index.
+ *
+ * Lookups older than the oldest version kept in a full ring fall back to
+ * searching the KnowledgeBase.
+ **/
+class GAMS_EXPORT FrameIndex
+{
+public:
+  /// Default maximum number of versions kept for each frame ID
+  static const size_t DEFAULT_CAPACITY = 1024;
+
+  /**
+   * Build an index of the frames saved in a KnowledgeBase, and use it for
+   * loading frames from then on. If already enabled, the index is rebuilt.
+   * Disable the index before the KnowledgeBase is destroyed.
+   *
+   * @param kb the KnowledgeBase to index
+   * @param settings frames saved under settings.prefix() are indexed
+   * @param capacity maximum number of versions kept for each frame ID
+   **/
+  static void enable(madara::knowledge::KnowledgeBase &kb,
+      const FrameEvalSettings &settings = FrameEvalSettings::DEFAULT,
+      size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Stop indexing frames of a KnowledgeBase, and discard its index.
+   *
+   * @param kb the indexed KnowledgeBase
+   * @param settings the settings passed to enable()
+   **/
+  static void disable(madara::knowledge::KnowledgeBase &kb,
+      const FrameEvalSettings &settings = FrameEvalSettings::DEFAULT);
+
+  /**
+   * Returns the index of a KnowledgeBase and prefix, or nullptr if not
+   * enabled.
+   **/
+  static std::shared_ptr<FrameIndex> find(
+      madara::knowledge::KnowledgeBase &kb, const std::string &prefix);
+
+  /// A saved frame version, as stored in the KnowledgeBase
+  struct Record
+  {
+    uint64_t timestamp = -1;
+    std::string type;
+    std::string parent;
+    std::vector<double> origin;
+  };
+
+  /// Result of a lookup
+  enum Lookup {
+    /// The index answered the lookup
+    FOUND,
+
+    /// The frame is not saved
+    ABSENT,
+
+    /// The index cannot tell; search the KnowledgeBase instead
+    UNKNOWN,
+  };
+
+  /// Public by necessity. Use enable instead.
+  FrameIndex(std::string prefix, size_t capacity)
+    : prefix_(std::move(prefix)), capacity_(capacity > 0 ? capacity : 1) {}
+
+  /// Returns the prefix this index covers
+  const std::string &prefix() const { return prefix_; }
+
+  /**
+   * Record a saved frame.
+   *
+   * @param key the key the frame was saved as, as used by save_as
+   * @param frame the saved frame
+   **/
+  void record(const std::string &key, const ReferenceFrameVersion &frame);
+
+  /**
+   * Record a KnowledgeBase update. Keys that are not part of a frame
+   * saved under this prefix are ignored.
+   *
+   * @param key the updated variable
+   * @param value its new value
+   * @return true if the key belongs to a saved frame
+   **/
+  bool record(const std::string &key,
+      const madara::knowledge::KnowledgeRecord &value);
+
+  /// Forget versions of a frame older than time, as expiry does
+  void expire(const std::string &id, uint64_t time);
+
+  /**
+   * Find a saved frame version.
+   *
+   * @param id the frame ID
+   * @param timestamp the exact timestamp; -1 for the timeless version
+   * @param out set to the saved frame, if FOUND
+   **/
+  Lookup get(const std::string &id, uint64_t timestamp, Record &out) const;
+
+  /**
+   * Find the saved versions of a frame nearest to a timestamp. If a
+   * version exists at timestamp, both are timestamp. Otherwise, the first
+   * is the newest older version and the second is the oldest newer one;
+   * either is -1 if there is none.
+   *
+   * @param id the frame ID
+   * @param timestamp the timestamp to search around
+   * @param out set to the neighboring timestamps, if FOUND
+   * @return FOUND or UNKNOWN
+   **/
+  Lookup neighbors(const std::string &id, uint64_t timestamp,
+      std::pair<uint64_t, uint64_t> &out) const;
+
+  /// Returns the number of versions indexed for a frame ID
+  size_t size(const std::string &id) const;
+
+private:
+  struct Ring
+  {
+    std::deque<Record> records;
+
+    /// true once an old version has been dropped to respect capacity
+    bool truncated = false;
+  };
+
+  bool parse(const std::string &key, std::string &id,
+      uint64_t &timestamp, std::string *field) const;
+
+  Record &insert(const std::string &id, uint64_t timestamp);
+
+  void scan(madara::knowledge::KnowledgeBase &kb);
+
+  std::string prefix_;
+  size_t capacity_;
+
+  std::unordered_map<std::string, Ring> rings_;
+
+  /// receives updates to versions too old to keep
+  Record discarded_;
+
+  mutable std::mutex lock_;
+};
+
+/**
+ * Receive filter which records frames arriving from other agents into the
+ * FrameIndex of a KnowledgeBase, if one is enabled. Add it to the
+ * QoSTransportSettings of each transport with add_receive_filter, after
+ * any filters that may drop or change records.
+ **/
+class GAMS_EXPORT FrameIndexFilter : public madara::filters::AggregateFilter
+{
+public:
+  /**
+   * Constructor
+   *
+   * @param kb the KnowledgeBase the transport updates
+   * @param settings frames saved under settings.prefix() are recorded
+   **/
+  FrameIndexFilter(madara::knowledge::KnowledgeBase kb,
+      const FrameEvalSettings &settings = FrameEvalSettings::DEFAULT)
+    : kb_(std::move(kb)), prefix_(settings.prefix()) {}
+
+  virtual ~FrameIndexFilter() = default;
+
+  /// Records frame updates; records are passed through unchanged
+  virtual void filter(madara::knowledge::KnowledgeMap &records,
+      const madara::transport::TransportContext &transport_context,
+      madara::knowledge::Variables &vars);
+
+private:
+  madara::knowledge::KnowledgeBase kb_;
+  std::string prefix_;
+};
+
+} }
+
+#endif
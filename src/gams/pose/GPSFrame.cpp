@@ -80,6 +80,28 @@ namespace gams
         throw undefined_transform(self, origin, false);
       }
 
+      void transform_linear_batch_to_origin(
+                      const ReferenceFrameType *origin,
+                      const ReferenceFrameType *self,
+                      double /*ox*/, double /*oy*/, double /*oz*/,
+                      double /*orx*/, double /*ory*/, double /*orz*/,
+                      double * /*x*/, double * /*y*/, double * /*z*/,
+                      size_t /*count*/, bool /*fixed*/)
+      {
+        throw undefined_transform(self, origin, true);
+      }
+
+      void transform_linear_batch_from_origin(
+                      const ReferenceFrameType *origin,
+                      const ReferenceFrameType *self,
+                      double /*ox*/, double /*oy*/, double /*oz*/,
+                      double /*orx*/, double /*ory*/, double /*orz*/,
+                      double * /*x*/, double * /*y*/, double * /*z*/,
+                      size_t /*count*/, bool /*fixed*/)
+      {
+        throw undefined_transform(self, origin, false);
+      }
+
       double calc_distance(
                 const ReferenceFrameType *,
                 double x1, double y1, double z1,
@@ -120,7 +142,7 @@ namespace gams
 
         double top = sqrt(top_first * top_first + top_second * top_second);
 
-        double bottom = sin_lat1 * cos_lat2 + cos_lat1 * cos_lat2 * cos_delta_lng;
+        double bottom = sin_lat1 * sin_lat2 + cos_lat1 * cos_lat2 * cos_delta_lng;
 
         const double epsilon = 0.000001;
         /**
@@ -171,6 +193,8 @@ namespace gams
         simple_rotate::transform_pose_to_origin,
         simple_rotate::transform_pose_from_origin,
         default_normalize_pose,
+        transform_linear_batch_to_origin,
+        transform_linear_batch_from_origin,
       };
     }
 
@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file PositionArrays.cpp
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains PositionArrays, positions stored as one array per
+ * coordinate, and batch distance calculations over them
+ **/
+
+#include "gams/pose/PositionArrays.h"
+
+#include <cmath>
+
+#include "gams/pose/CartesianFrame.h"
+#include "gams/pose/GPSFrame.h"
+
+namespace gams { namespace pose {
+
+namespace {
+  /**
+   * Great circle distances from one GPS position to many, as in
+   * gps::calc_distance. The difference in y is never taken directly;
+   * its sine and cosine come from the angle difference identities, so
+   * each distance needs no sin or cos.
+   **/
+  void gps_distances(double sin_x1, double cos_x1,
+                     double sin_y1, double cos_y1, double alt1,
+                     const double *sin_x, const double *cos_x,
+                     const double *sin_y, const double *cos_y,
+                     const double *alt, size_t count, double *results)
+  {
+    const double epsilon = 0.000001;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double sin_delta_y = sin_y[i] * cos_y1 - cos_y[i] * sin_y1;
+      const double cos_delta_y = cos_y[i] * cos_y1 + sin_y[i] * sin_y1;
+
+      const double top_first = cos_x[i] * sin_delta_y;
+      const double top_second =
+          cos_x1 * sin_x[i] - sin_x1 * cos_x[i] * cos_delta_y;
+      const double top =
+          std::sqrt(top_first * top_first + top_second * top_second);
+      const double bottom =
+          sin_x1 * sin_x[i] + cos_x1 * cos_x[i] * cos_delta_y;
+
+      const double central_angle =
+          (std::fabs(top) < epsilon && std::fabs(bottom) < epsilon)
+              ? 0 : std::atan2(top, bottom);
+
+      const double alt_diff = alt[i] - alt1;
+      const double low_alt = alt[i] < alt1 ? alt[i] : alt1;
+      const double great_circle_dist = (EARTH_RADIUS + low_alt) * central_angle;
+
+      results[i] = alt_diff == 0 ? great_circle_dist :
+          std::sqrt(great_circle_dist * great_circle_dist +
+                    alt_diff * alt_diff);
+    }
+  }
+
+  /// Euclidean distances from one Cartesian position to many
+  void cartesian_distances(double x1, double y1, double z1,
+                           const double *x, const double *y,
+                           const double *z, size_t count, double *results)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double dx = x[i] - x1;
+      const double dy = y[i] - y1;
+      const double dz = z[i] - z1;
+      results[i] = std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+  }
+}
+
+PositionArrays::PositionArrays(ReferenceFrame frame)
+  : frame_(std::move(frame))
+{
+}
+
+PositionArrays::PositionArrays(ReferenceFrame frame,
+                               const std::vector<Position> &positions)
+  : frame_(std::move(frame))
+{
+  append(positions.data(), positions.size());
+}
+
+PositionArrays::PositionArrays(ReferenceFrame frame,
+                               const double *x, const double *y,
+                               const double *z, size_t count)
+  : frame_(std::move(frame))
+{
+  append(x, y, z, count);
+}
+
+void PositionArrays::append(const Position *positions, size_t count)
+{
+  std::vector<Position> converted(positions, positions + count);
+  frame_.transform_batch(converted);
+
+  const size_t begin = size();
+  x_.reserve(begin + count);
+  y_.reserve(begin + count);
+  z_.reserve(begin + count);
+  for (const Position &position : converted)
+  {
+    x_.push_back(position.x());
+    y_.push_back(position.y());
+    z_.push_back(position.z());
+  }
+
+  derive(begin);
+}
+
+void PositionArrays::append(const double *x, const double *y,
+                            const double *z, size_t count)
+{
+  const size_t begin = size();
+  x_.insert(x_.end(), x, x + count);
+  y_.insert(y_.end(), y, y + count);
+  z_.insert(z_.end(), z, z + count);
+
+  derive(begin);
+}
+
+void PositionArrays::clear()
+{
+  x_.clear();
+  y_.clear();
+  z_.clear();
+  sin_x_.clear();
+  cos_x_.clear();
+  sin_y_.clear();
+  cos_y_.clear();
+  alt_.clear();
+}
+
+void PositionArrays::derive(size_t begin)
+{
+  if (frame_.type() != GPS)
+    return;
+
+  const size_t count = size();
+  sin_x_.resize(count);
+  cos_x_.resize(count);
+  sin_y_.resize(count);
+  cos_y_.resize(count);
+  alt_.resize(count);
+
+  for (size_t i = begin; i < count; ++i)
+  {
+    const double x = DEG_TO_RAD(x_[i]);
+    const double y = DEG_TO_RAD(y_[i]);
+    sin_x_[i] = std::sin(x);
+    cos_x_[i] = std::cos(x);
+    sin_y_[i] = std::sin(y);
+    cos_y_[i] = std::cos(y);
+    alt_[i] = -z_[i];
+  }
+}
+
+void PositionArrays::distances_from(const PositionArrays &from_arrays,
+                                    size_t from_index,
+                                    double *results) const
+{
+  const size_t i = from_index;
+  const size_t count = size();
+  const ReferenceFrameType *type = frame_.type();
+
+  if (type == GPS)
+  {
+    gps_distances(from_arrays.sin_x_[i], from_arrays.cos_x_[i],
+                  from_arrays.sin_y_[i], from_arrays.cos_y_[i],
+                  from_arrays.alt_[i],
+                  sin_x_.data(), cos_x_.data(), sin_y_.data(),
+                  cos_y_.data(), alt_.data(), count, results);
+  }
+  else if (type == Cartesian)
+  {
+    cartesian_distances(from_arrays.x_[i], from_arrays.y_[i],
+                        from_arrays.z_[i], x_.data(), y_.data(),
+                        z_.data(), count, results);
+  }
+  else
+  {
+    for (size_t j = 0; j < count; ++j)
+    {
+      results[j] = type->calc_distance(type,
+          from_arrays.x_[i], from_arrays.y_[i], from_arrays.z_[i],
+          x_[j], y_[j], z_[j]);
+    }
+  }
+}
+
+void PositionArrays::distances_from(const Position &from,
+                                    double *results) const
+{
+  PositionArrays from_arrays(frame_);
+  from_arrays.push_back(from);
+  distances_from(from_arrays, 0, results);
+}
+
+std::vector<double> PositionArrays::distances_from(
+    const Position &from) const
+{
+  std::vector<double> results(size());
+  distances_from(from, results.data());
+  return results;
+}
+
+void PositionArrays::distances_from(const PositionArrays &from,
+                                    double *results) const
+{
+  if (from.frame_ != frame_)
+  {
+    std::vector<Position> positions;
+    positions.reserve(from.size());
+    for (size_t i = 0; i < from.size(); ++i)
+    {
+      positions.push_back(from[i]);
+    }
+
+    distances_from(PositionArrays(frame_, positions), results);
+    return;
+  }
+
+  for (size_t i = 0; i < from.size(); ++i)
+  {
+    distances_from(from, i, results + i * size());
+  }
+}
+
+std::vector<double> PositionArrays::distances_from(
+    const PositionArrays &from) const
+{
+  std::vector<double> results(from.size() * size());
+  distances_from(from, results.data());
+  return results;
+}
+
+} }
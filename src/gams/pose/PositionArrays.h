@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file PositionArrays.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains PositionArrays, positions stored as one array per
+ * coordinate, and batch distance calculations over them
+ **/
+
+#ifndef _GAMS_POSE_POSITION_ARRAYS_H_
+#define _GAMS_POSE_POSITION_ARRAYS_H_
+
+#include <vector>
+
+#include "ReferenceFrame.h"
+#include "Position.h"
+
+namespace gams { namespace pose {
+
+/**
+ * Positions in one frame, stored as one array per coordinate, for
+ * calculating many distances at once. Positions are transformed into
+ * the frame as they are added. For GPS frames, the sines and cosines
+ * used by the great circle formula are also computed as positions are
+ * added, rather than once per distance.
+ **/
+class GAMS_EXPORT PositionArrays
+{
+public:
+  /**
+   * Constructor
+   *
+   * @param frame the frame to store positions in
+   **/
+  explicit PositionArrays(ReferenceFrame frame);
+
+  /**
+   * Constructor
+   *
+   * @param frame the frame to store positions in
+   * @param positions positions in any frames
+   **/
+  PositionArrays(ReferenceFrame frame,
+                 const std::vector<Position> &positions);
+
+  /**
+   * Constructor from coordinates already in frame
+   *
+   * @param frame the frame of the coordinates
+   * @param x array of x coordinates
+   * @param y array of y coordinates
+   * @param z array of z coordinates
+   * @param count number of elements in each array
+   **/
+  PositionArrays(ReferenceFrame frame,
+                 const double *x, const double *y, const double *z,
+                 size_t count);
+
+  /**
+   * Adds positions, transforming them into frame()
+   *
+   * @param positions positions in any frames
+   * @param count number of positions
+   **/
+  void append(const Position *positions, size_t count);
+
+  /**
+   * Adds coordinates already in frame()
+   *
+   * @param x array of x coordinates
+   * @param y array of y coordinates
+   * @param z array of z coordinates
+   * @param count number of elements in each array
+   **/
+  void append(const double *x, const double *y, const double *z,
+              size_t count);
+
+  /**
+   * Adds a position, transforming it into frame()
+   **/
+  void push_back(const Position &position)
+  {
+    append(&position, 1);
+  }
+
+  /**
+   * Removes all positions, keeping the frame
+   **/
+  void clear();
+
+  /// The number of positions
+  size_t size() const { return x_.size(); }
+
+  /// The frame positions are stored in
+  const ReferenceFrame &frame() const { return frame_; }
+
+  /// The x coordinates
+  const std::vector<double> &x() const { return x_; }
+
+  /// The y coordinates
+  const std::vector<double> &y() const { return y_; }
+
+  /// The z coordinates
+  const std::vector<double> &z() const { return z_; }
+
+  /**
+   * Gets a position
+   *
+   * @param i index of the position
+   * @return the position, in frame()
+   **/
+  Position operator[](size_t i) const
+  {
+    return Position(frame_, x_[i], y_[i], z_[i]);
+  }
+
+  /**
+   * Calculates the distance from one position to each of these.
+   * Equivalent to calling from.distance_to((*this)[i]) for each, except
+   * that from is transformed into frame() once, and distances are
+   * calculated in frame() even if from's frame and frame() have a lower
+   * common parent.
+   *
+   * @param from the position to measure from
+   * @param results array of size() distances, in meters
+   **/
+  void distances_from(const Position &from, double *results) const;
+
+  /**
+   * Calculates the distance from one position to each of these.
+   *
+   * @param from the position to measure from
+   * @return size() distances, in meters
+   **/
+  std::vector<double> distances_from(const Position &from) const;
+
+  /**
+   * Calculates the distance from each of another set of positions to
+   * each of these. If the frames differ, from is transformed into
+   * frame() first.
+   *
+   * @param from the positions to measure from
+   * @param results array of from.size() * size() distances, in meters.
+   *        The distance from from[i] to (*this)[j] is
+   *        results[i * size() + j]
+   **/
+  void distances_from(const PositionArrays &from, double *results) const;
+
+  /**
+   * Calculates the distance from each of another set of positions to
+   * each of these.
+   *
+   * @param from the positions to measure from
+   * @return from.size() * size() distances, in meters, row-major by from
+   **/
+  std::vector<double> distances_from(const PositionArrays &from) const;
+
+private:
+  /// Computes the per-position terms for positions from begin onward
+  void derive(size_t begin);
+
+  /**
+   * Calculates distances from one position, given in frame()
+   *
+   * @param from_index index of from within from_arrays
+   **/
+  void distances_from(const PositionArrays &from_arrays, size_t from_index,
+                      double *results) const;
+
+  ReferenceFrame frame_;
+  std::vector<double> x_, y_, z_;
+
+  /// For GPS frames: sines and cosines of x and y, and altitude (-z)
+  std::vector<double> sin_x_, cos_x_, sin_y_, cos_y_, alt_;
+};
+
+} }
+
+#endif
@@ -58,8 +58,10 @@
 #include "gams/pose/Linear.h"
 #include "gams/pose/Angular.h"
 #include "gams/pose/Quaternion.h"
+#include "gams/pose/FrameIndex.h"
 
 #include <random>
+#include <atomic>
 
 using madara::knowledge::KnowledgeBase;
 using madara::knowledge::KnowledgeRecord;
@@ -257,6 +259,10 @@ namespace gams
         kb.get_context().delete_variables(range.first, range.second);
       }
 
+      if (auto index = FrameIndex::find(kb, settings.prefix())) {
+        index->expire(id_, time);
+      }
+
       {
         std::lock_guard<std::mutex> guard(versions_lock_);
 
@@ -322,6 +328,11 @@ namespace gams
         key += "toi";
         kb.set(key, madara::utility::get_time(), settings);
 
+        if (auto index = FrameIndex::find(kb, settings.prefix())) {
+          key.resize(pos - 1);
+          index->record(key, *this);
+        }
+
         if (check_consistent()) {
           interpolated_ = false;
           ident().register_version(timestamp(),
@@ -354,6 +365,23 @@ namespace gams
           }
         }
 
+        if (auto index = FrameIndex::find(kb, settings.prefix())) {
+          FrameIndex::Record rec;
+          auto found = index->get(id, timestamp, rec);
+          if (found == FrameIndex::FOUND) {
+            Pose origin(ReferenceFrame{});
+            origin.from_container(rec.origin);
+
+            auto ret = std::make_shared<ReferenceFrameVersion>(
+                rec.type == "GPS" ? GPS : Cartesian, id,
+                std::move(origin), timestamp);
+            return std::make_pair(std::move(ret), std::move(rec.parent));
+          } else if (found == FrameIndex::ABSENT) {
+            return std::make_pair(std::shared_ptr<ReferenceFrameVersion>(),
+                std::string());
+          }
+        }
+
         auto key = settings.prefix();
         impl::make_kb_key(key, id, timestamp);
 
@@ -473,6 +501,13 @@ namespace gams
         static const char suffix[] = ".origin";
         static const size_t suffix_len = sizeof(suffix) - 1;
 
+        if (auto index = FrameIndex::find(kb, settings.prefix())) {
+          std::pair<uint64_t, uint64_t> ret;
+          if (index->neighbors(id, timestamp, ret) == FrameIndex::FOUND) {
+            return ret;
+          }
+        }
+
         auto key = settings.prefix();
 
         impl::make_kb_key(key, id);
@@ -552,6 +587,20 @@ namespace gams
       auto ret = find_nearest_neighbors(kb, id, -1, settings).first;
       LOCAL_DEBUG(std::cerr << "Latest for " << id << " is " << ret << std::endl;)
 
+      if (auto index = FrameIndex::find(kb, settings.prefix())) {
+        FrameIndex::Record rec;
+        auto found = index->get(id, ret, rec);
+        if (found != FrameIndex::UNKNOWN) {
+          if (found == FrameIndex::FOUND && !rec.parent.empty()) {
+            auto p = latest_timestamp(kb, rec.parent);
+            if (p < ret) {
+              return p;
+            }
+          }
+          return ret;
+        }
+      }
+
       auto key = settings.prefix();
       impl::make_kb_key(key, id, ret);
       key += ".parent";
@@ -672,6 +721,380 @@ namespace gams
       return nullptr;
     }
 
+    namespace impl {
+      void ChainTransform::to_origin(const ReferenceFrame &frame)
+      {
+        append(frame.to_origin_transform(), frame.origin_quaternion());
+      }
+
+      void ChainTransform::from_origin(const ReferenceFrame &frame)
+      {
+        // mirrors cartesian::transform_linear_from_origin: the inverse
+        // rotation is applied first, then the origin is subtracted
+        const RigidTransform &hop = frame.to_origin_transform();
+        append(RigidTransform::translation(
+                 -hop.trans(0), -hop.trans(1), -hop.trans(2)) *
+               hop.rotation().inverse(),
+               -frame.origin_quaternion());
+      }
+
+      void ChainTransform::to_origin(const Pose &origin)
+      {
+        to_origin(origin.x(), origin.y(), origin.z(),
+                  origin.rx(), origin.ry(), origin.rz());
+      }
+
+      void ChainTransform::from_origin(const Pose &origin)
+      {
+        from_origin(origin.x(), origin.y(), origin.z(),
+                    origin.rx(), origin.ry(), origin.rz());
+      }
+
+      void ChainTransform::to_origin(double ox, double oy, double oz,
+                                     double orx, double ory, double orz)
+      {
+        Quaternion quat(orx, ory, orz);
+        append(RigidTransform(quat, ox, oy, oz), quat);
+      }
+
+      void ChainTransform::from_origin(double ox, double oy, double oz,
+                                       double orx, double ory, double orz)
+      {
+        // mirrors cartesian::transform_linear_from_origin: the inverse
+        // rotation is applied first, then the origin is subtracted
+        Quaternion quat(orx, ory, orz);
+        quat.conjugate();
+        append(RigidTransform::translation(-ox, -oy, -oz) *
+               RigidTransform(quat), quat);
+      }
+    }
+
+    namespace {
+      struct TransformCacheEntry
+      {
+        const ReferenceFrameVersion *from_key = nullptr;
+        const ReferenceFrameVersion *to_key = nullptr;
+        std::weak_ptr<ReferenceFrameVersion> from;
+        std::weak_ptr<ReferenceFrameVersion> to;
+        bool composed = false;
+        impl::ChainTransform chain;
+      };
+
+      /// number of frame pairs each thread keeps composed transforms for
+      const size_t TRANSFORM_CACHE_SIZE = 16;
+
+      /**
+       * The composed transforms of one thread. Each thread keeps its own,
+       * so lookups take no lock.
+       **/
+      struct TransformCache
+      {
+        std::vector<TransformCacheEntry> entries;
+        size_t next = 0;
+        unsigned int generation = 0;
+      };
+
+      std::atomic<bool> transform_cache_enabled(true);
+
+      /// incremented to drop the entries of every thread
+      std::atomic<unsigned int> transform_cache_generation(0);
+
+      TransformCache &get_transform_cache()
+      {
+        static thread_local TransformCache cache;
+
+        const unsigned int generation = transform_cache_generation;
+        if (cache.generation != generation)
+        {
+          cache.entries.clear();
+          cache.next = 0;
+          cache.generation = generation;
+        }
+        return cache;
+      }
+
+      /// true if weak refers to the same object (and control block) as ptr
+      bool same_version(const std::weak_ptr<ReferenceFrameVersion> &weak,
+                        const std::shared_ptr<ReferenceFrameVersion> &ptr)
+      {
+        return !weak.owner_before(ptr) && !ptr.owner_before(weak);
+      }
+    }
+
+    namespace impl {
+      bool compose_chain(const ReferenceFrame &from, const ReferenceFrame &to,
+                         ChainTransform &chain)
+      {
+        std::vector<const ReferenceFrame *> to_stack;
+        const ReferenceFrame *via = find_common_frame(&from, &to, &to_stack);
+
+        if (via == nullptr || via->type() != Cartesian)
+          return false;
+
+        for (const ReferenceFrame *cur = &from; *cur != *via;
+             cur = &cur->origin().frame())
+        {
+          if (cur->type() != Cartesian)
+            return false;
+          chain.to_origin(*cur);
+        }
+
+        for (auto cur = to_stack.rbegin(); cur != to_stack.rend(); ++cur)
+        {
+          if ((*cur)->type() != Cartesian)
+            return false;
+          chain.from_origin(**cur);
+        }
+
+        return true;
+      }
+    }
+
+    bool ReferenceFrameVersion::find_chain_transform(
+      const ReferenceFrame &from, const ReferenceFrame &to,
+      impl::ChainTransform &chain)
+    {
+      if (!transform_cache_enabled || !from.valid() || !to.valid())
+        return false;
+
+      TransformCache &cache = get_transform_cache();
+      const ReferenceFrameVersion *from_key = from.impl_.get();
+      const ReferenceFrameVersion *to_key = to.impl_.get();
+
+      TransformCacheEntry *entry = nullptr;
+
+      for (TransformCacheEntry &cur : cache.entries)
+      {
+        if (cur.from_key == from_key && cur.to_key == to_key)
+        {
+          // addresses may be reused by new versions once the old expire
+          if (same_version(cur.from, from.impl_) &&
+              same_version(cur.to, to.impl_))
+          {
+            if (cur.composed)
+              chain = cur.chain;
+            return cur.composed;
+          }
+          entry = &cur;
+          break;
+        }
+      }
+
+      if (entry == nullptr)
+      {
+        if (cache.entries.size() < TRANSFORM_CACHE_SIZE)
+        {
+          cache.entries.emplace_back();
+          entry = &cache.entries.back();
+        }
+        else
+        {
+          entry = &cache.entries[cache.next];
+          cache.next = (cache.next + 1) % TRANSFORM_CACHE_SIZE;
+        }
+      }
+
+      entry->from_key = from_key;
+      entry->to_key = to_key;
+      entry->from = from.impl_;
+      entry->to = to.impl_;
+      entry->chain = impl::ChainTransform();
+      entry->composed = impl::compose_chain(from, to, entry->chain);
+
+      if (entry->composed)
+        chain = entry->chain;
+      return entry->composed;
+    }
+
+    bool ReferenceFrameVersion::cache_transforms(bool enabled)
+    {
+      bool ret = transform_cache_enabled.exchange(enabled);
+      if (!enabled)
+        clear_transform_cache();
+      return ret;
+    }
+
+    bool ReferenceFrameVersion::cache_transforms()
+    {
+      return transform_cache_enabled;
+    }
+
+    void ReferenceFrameVersion::clear_transform_cache()
+    {
+      ++transform_cache_generation;
+    }
+
+    size_t ReferenceFrameVersion::transform_cache_size()
+    {
+      return get_transform_cache().entries.size();
+    }
+
+    void ReferenceFrame::transform_batch(const ReferenceFrame &from,
+      double *x, double *y, double *z, size_t count, bool fixed) const
+    {
+      if (count == 0 || from == *this)
+        return;
+
+      impl::ChainTransform chain;
+      if (ReferenceFrameVersion::find_chain_transform(from, *this, chain))
+      {
+        chain.apply_linear(x, y, z, count, fixed);
+        return;
+      }
+
+      std::vector<const ReferenceFrame *> to_stack;
+      const ReferenceFrame *via = find_common_frame(&from, this, &to_stack);
+
+      if (via == nullptr)
+        throw unrelated_frames(from, *this);
+
+      // runs of Cartesian hops are composed and applied together; other
+      // hops go through their frame type's batch transform
+      bool pending = false;
+
+      for (const ReferenceFrame *cur = &from; *cur != *via;
+           cur = &cur->origin().frame())
+      {
+        const Pose &origin = cur->origin();
+        const ReferenceFrameType *s = cur->type();
+        const ReferenceFrameType *o = origin.frame().type();
+
+        if (s == Cartesian && o == Cartesian)
+        {
+          chain.to_origin(*cur);
+          pending = true;
+          continue;
+        }
+
+        if (pending)
+        {
+          chain.apply_linear(x, y, z, count, fixed);
+          chain = impl::ChainTransform();
+          pending = false;
+        }
+
+        s->transform_linear_batch_to_origin(o, s,
+            origin.x(), origin.y(), origin.z(),
+            origin.rx(), origin.ry(), origin.rz(),
+            x, y, z, count, fixed);
+      }
+
+      for (auto cur = to_stack.rbegin(); cur != to_stack.rend(); ++cur)
+      {
+        const Pose &origin = (*cur)->origin();
+        const ReferenceFrameType *c = (*cur)->type();
+        const ReferenceFrameType *p = origin.frame().type();
+
+        if (c == Cartesian && p == Cartesian)
+        {
+          chain.from_origin(**cur);
+          pending = true;
+          continue;
+        }
+
+        if (pending)
+        {
+          chain.apply_linear(x, y, z, count, fixed);
+          chain = impl::ChainTransform();
+          pending = false;
+        }
+
+        c->transform_linear_batch_from_origin(p, c,
+            origin.x(), origin.y(), origin.z(),
+            origin.rx(), origin.ry(), origin.rz(),
+            x, y, z, count, fixed);
+      }
+
+      if (pending)
+        chain.apply_linear(x, y, z, count, fixed);
+    }
+
+    void ReferenceFrame::transform_batch(
+      Position *positions, size_t count) const
+    {
+      std::vector<double> xs, ys, zs;
+
+      for (size_t begin = 0, end; begin < count; begin = end)
+      {
+        // positions usually share a frame; handle each run at once
+        ReferenceFrame from = positions[begin].frame();
+        for (end = begin + 1;
+             end < count && positions[end].frame() == from; ++end) {}
+
+        if (from == *this)
+          continue;
+
+        impl::ChainTransform chain;
+        if (ReferenceFrameVersion::find_chain_transform(from, *this, chain))
+        {
+          for (size_t i = begin; i < end; ++i)
+          {
+            impl::apply_chain(chain, positions[i]);
+          }
+        }
+        else
+        {
+          size_t size = end - begin;
+          xs.resize(size);
+          ys.resize(size);
+          zs.resize(size);
+
+          for (size_t i = 0; i < size; ++i)
+          {
+            xs[i] = positions[begin + i].x();
+            ys[i] = positions[begin + i].y();
+            zs[i] = positions[begin + i].z();
+          }
+
+          transform_batch(from, xs.data(), ys.data(), zs.data(), size);
+
+          for (size_t i = 0; i < size; ++i)
+          {
+            positions[begin + i].x(xs[i]);
+            positions[begin + i].y(ys[i]);
+            positions[begin + i].z(zs[i]);
+          }
+        }
+
+        for (size_t i = begin; i < end; ++i)
+        {
+          positions[i].frame(*this);
+        }
+      }
+    }
+
+    void ReferenceFrame::transform_batch(Pose *poses, size_t count) const
+    {
+      for (size_t begin = 0, end; begin < count; begin = end)
+      {
+        ReferenceFrame from = poses[begin].frame();
+        for (end = begin + 1;
+             end < count && poses[end].frame() == from; ++end) {}
+
+        if (from == *this)
+          continue;
+
+        impl::ChainTransform chain;
+        if (ReferenceFrameVersion::find_chain_transform(from, *this, chain))
+        {
+          for (size_t i = begin; i < end; ++i)
+          {
+            impl::apply_chain(chain, poses[i]);
+            poses[i].frame(*this);
+          }
+        }
+        else
+        {
+          // orientations across non-Cartesian hops are left to the
+          // frame types, one pose at a time
+          for (size_t i = begin; i < end; ++i)
+          {
+            transform(poses[i], *this);
+          }
+        }
+      }
+    }
+
     namespace simple_rotate {
       void orient_linear_vec(
             double &x, double &y, double &z,
@@ -68,6 +68,7 @@
 #include "CartesianFrame.h"
 #include "Pose.h"
 #include "Quaternion.h"
+#include "RigidTransform.h"
 #include "madara/knowledge/EvalSettings.h"
 
 namespace gams { namespace pose {
@@ -248,6 +249,111 @@ namespace impl {
     make_kb_key(prefix, timestamp);
     return prefix;
   }
+
+  /**
+   * Composition of the hops between two frames connected only through
+   * Cartesian frames. Linear coordinates are mapped by linear, without
+   * its translation if they are not fixed; orientations are
+   * right-multiplied by ori, exactly as applying
+   * transform_to_origin/transform_from_origin hop by hop.
+   **/
+  struct GAMS_EXPORT ChainTransform
+  {
+    /// transform applied to linear coordinates
+    RigidTransform linear;
+
+    /// rotation applied to orientations
+    Quaternion ori;
+
+    /// Constructs the identity transform
+    ChainTransform() : ori(0, 0, 0, 1) {}
+
+    /**
+     * Appends the hop from a frame into its parent, using the transform
+     * cached on the frame's version.
+     *
+     * @param frame the child frame
+     **/
+    void to_origin(const ReferenceFrame &frame);
+
+    /**
+     * Appends the hop from a frame's parent into the frame, using the
+     * transform cached on the frame's version.
+     *
+     * @param frame the child frame
+     **/
+    void from_origin(const ReferenceFrame &frame);
+
+    /**
+     * Appends the hop from a child frame into its parent.
+     *
+     * @param origin the child frame's origin, within the parent
+     **/
+    void to_origin(const Pose &origin);
+
+    /**
+     * Appends the hop from a parent frame into its child.
+     *
+     * @param origin the child frame's origin, within the parent
+     **/
+    void from_origin(const Pose &origin);
+
+    /**
+     * Appends the hop from a child frame into its parent, given the
+     * child's origin as individual terms.
+     **/
+    void to_origin(double ox, double oy, double oz,
+                   double orx, double ory, double orz);
+
+    /**
+     * Appends the hop from a parent frame into its child, given the
+     * child's origin as individual terms.
+     **/
+    void from_origin(double ox, double oy, double oz,
+                     double orx, double ory, double orz);
+
+    /**
+     * Transforms arrays of linear coordinates in place.
+     *
+     * @param x array of x coordinates
+     * @param y array of y coordinates
+     * @param z array of z coordinates
+     * @param count number of elements in each array
+     * @param fixed if false (e.g., velocities) translation is not applied
+     **/
+    void apply_linear(double *x, double *y, double *z, size_t count,
+                      bool fixed) const
+    {
+      linear.apply(x, y, z, count, fixed);
+    }
+
+    /**
+     * Transforms linear coordinates in place
+     *
+     * @param fixed if false (e.g., velocities) translation is not applied
+     **/
+    void apply_linear(double &x, double &y, double &z, bool fixed) const
+    {
+      linear.apply(x, y, z, fixed);
+    }
+
+    /**
+     * Transforms an orientation vector in place
+     **/
+    void apply_angular(double &rx, double &ry, double &rz) const
+    {
+      Quaternion quat(rx, ry, rz);
+      quat *= ori;
+      quat.to_angular_vector(rx, ry, rz);
+    }
+
+  private:
+    void append(const RigidTransform &hop, const Quaternion &hop_ori)
+    {
+      linear = hop * linear;
+      ori *= hop_ori;
+    }
+  };
 }
 
 /// Type trait to detect stamped types
@@ -292,6 +398,11 @@ private:
   Pose origin_;
   mutable bool interpolated_ = false;
 
+  /// origin_'s orientation, and the hop into the parent frame; origin_'s
+  /// coordinates must not change after construction
+  Quaternion origin_quat_;
+  RigidTransform to_origin_transform_;
+
 private:
   template<typename T>
   static uint64_t init_timestamp(uint64_t given, const T &p)
@@ -411,7 +522,10 @@ public:
     : ident_(std::move(ident)),
       type_(type),
       timestamp_(init_timestamp(timestamp, origin)),
-      origin_(std::forward<P>(origin)) {}
+      origin_(std::forward<P>(origin)),
+      origin_quat_(origin_.rx(), origin_.ry(), origin_.rz()),
+      to_origin_transform_(origin_quat_,
+          origin_.x(), origin_.y(), origin_.z()) {}
 
   /**
    * Get the ReferenceFrameIdentity object associated with this frame,
@@ -445,7 +559,8 @@ public:
   }
 
   /**
-   * Gets the origin of this Frame
+   * Gets the origin of this Frame. Only its frame may be changed; the
+   * cached transforms are computed from its coordinates on construction.
    *
    * @return the Pose which is the origin within this frame's parent,
    * or, a Pose within this own frame, with all zeros for coordinates,
@@ -455,6 +570,23 @@ public:
     return origin_;
   }
 
+  /**
+   * Gets the orientation of the origin as a quaternion, computed when
+   * this version was created.
+   **/
+  const Quaternion &origin_quaternion() const {
+    return origin_quat_;
+  }
+
+  /**
+   * Gets the transform of linear coordinates from this frame into its
+   * parent, computed when this version was created. The translation is
+   * only meaningful if both frames are Cartesian.
+   **/
+  const RigidTransform &to_origin_transform() const {
+    return to_origin_transform_;
+  }
+
   /**
    * Creates a new ReferenceFrame with modified origin
    *
@@ -936,6 +1068,43 @@ public:
     return ret;
   }
 
+  /**
+   * Get the composed transform between two frames, from the transform
+   * cache if possible. Only paths made up entirely of Cartesian frames
+   * are composed; other paths are remembered as such, so callers fall
+   * back to the hop by hop transform without searching again.
+   *
+   * Entries are keyed by frame version. Since a version's origin, and
+   * thus its whole chain of parents, never changes, frames that get a
+   * new timestamp are new versions and never see stale entries. Each
+   * thread keeps its own small cache of recently used pairs, so lookups
+   * take no lock.
+   *
+   * @param from the frame to transform from
+   * @param to the frame to transform into
+   * @param chain set to the composed transform, if found
+   * @return true if chain was set. False if caching is disabled, the
+   *   frames are unrelated, or the path includes a non-Cartesian frame.
+   **/
+  static bool find_chain_transform(const ReferenceFrame &from,
+      const ReferenceFrame &to, impl::ChainTransform &chain);
+
+  /**
+   * Enable or disable the transform cache
+   *
+   * @return previous setting
+   **/
+  static bool cache_transforms(bool enabled);
+
+  /// Return true if the transform cache is enabled
+  static bool cache_transforms();
+
+  /// Drop all entries in the transform caches of all threads
+  static void clear_transform_cache();
+
+  /// Return the number of entries in the calling thread's transform cache
+  static size_t transform_cache_size();
+
   template<typename CoordType>
   friend class Coordinate;
 
@@ -1104,6 +1273,20 @@ GAMS_EXPORT const ReferenceFrame *find_common_frame(
     const ReferenceFrame *to,
     std::vector<const ReferenceFrame *> *to_stack = nullptr);
 
+namespace impl {
+  /**
+   * Composes the hops between two frames, without the transform cache.
+   *
+   * @param from the frame to transform from
+   * @param to the frame to transform into
+   * @param chain the hops are appended to this
+   * @return false if the frames are unrelated, or the path includes a
+   *   non-Cartesian frame.
+   **/
+  GAMS_EXPORT bool compose_chain(const ReferenceFrame &from,
+      const ReferenceFrame &to, ChainTransform &chain);
+}
+
 /**
  * Thrown when an an attempt is made to transform between frames
  * that do not belong to the same frame tree.
@@ -67,6 +67,34 @@ namespace gams { namespace pose {
 /// Implementation details
 namespace impl
 {
+  template<typename T>
+  inline auto apply_chain(const ChainTransform &chain, T &in) ->
+    typename std::enable_if<T::positional()>::type
+  {
+    chain.apply_linear(in.vec()[0], in.vec()[1], in.vec()[2], T::fixed());
+  }
+
+  template<typename T>
+  inline auto apply_chain(const ChainTransform &chain, T &in) ->
+    typename std::enable_if<T::rotational()>::type
+  {
+    chain.apply_angular(in.vec()[0], in.vec()[1], in.vec()[2]);
+  }
+
+  inline void apply_chain(const ChainTransform &chain, Pose &in)
+  {
+    chain.apply_linear(in.pos_vec()[0], in.pos_vec()[1], in.pos_vec()[2],
+                       true);
+    chain.apply_angular(in.ori_vec()[0], in.ori_vec()[1], in.ori_vec()[2]);
+  }
+
+  inline void apply_chain(const ChainTransform &chain, StampedPose &in)
+  {
+    chain.apply_linear(in.pos_vec()[0], in.pos_vec()[1], in.pos_vec()[2],
+                       true);
+    chain.apply_angular(in.ori_vec()[0], in.ori_vec()[1], in.ori_vec()[2]);
+  }
+
   template<class C, class Func>
   inline void to_origin(C &in, Func func) {
     ReferenceFrame self_frame = in.frame();
@@ -79,6 +107,14 @@ namespace impl
       const ReferenceFrameType *s = self_frame.type();
       const ReferenceFrameType *o = origin_frame.type();
       //std::cerr << "Transform from " << in.frame().id() << " to " << in.frame().origin_frame().id() << std::endl;
+      if (s == Cartesian && o == Cartesian) {
+        // the hop is cached on the frame version, so skip func's
+        // conversions of the origin's orientation
+        ChainTransform hop;
+        hop.to_origin(self_frame);
+        apply_chain(hop, in);
+        return;
+      }
       func(s, o, origin, in);
     }
   }
@@ -189,6 +225,12 @@ namespace impl
       const Pose &to = to_frame.origin();
       const ReferenceFrameType *t = to_frame.type();
       const ReferenceFrameType *f = from_frame.type();
+      if (t == Cartesian && f == Cartesian) {
+        ChainTransform hop;
+        hop.from_origin(to_frame);
+        apply_chain(hop, in);
+        return;
+      }
       func(f, t, to, in);
     }
   }
@@ -445,6 +487,14 @@ inline void transform_other(
               CoordType &in,
               const ReferenceFrame &to_frame)
 {
+  impl::ChainTransform chain;
+  if (ReferenceFrameVersion::find_chain_transform(in.frame(), to_frame, chain))
+  {
+    impl::apply_chain(chain, in);
+    in.frame(to_frame);
+    return;
+  }
+
   std::vector<const ReferenceFrame *> to_stack;
   const ReferenceFrame *transform_via =
                       find_common_frame(&in.frame(), &to_frame, &to_stack);
@@ -643,6 +693,14 @@ inline const Pose &ReferenceFrame::origin() const {
   return impl_->origin();
 }
 
+inline const Quaternion &ReferenceFrame::origin_quaternion() const {
+  return impl_->origin_quaternion();
+}
+
+inline const RigidTransform &ReferenceFrame::to_origin_transform() const {
+  return impl_->to_origin_transform();
+}
+
 inline ReferenceFrame ReferenceFrame::pose(
     const Pose &new_origin) const {
   return impl_->pose(new_origin);
@@ -734,6 +792,28 @@ inline const std::string &ReferenceFrame::default_prefix() {
   return ReferenceFrameIdentity::default_prefix();
 }
 
+inline void ReferenceFrame::transform_batch(
+    std::vector<Position> &positions) const {
+  transform_batch(positions.data(), positions.size());
+}
+
+inline void ReferenceFrame::transform_batch(
+    std::vector<Pose> &poses) const {
+  transform_batch(poses.data(), poses.size());
+}
+
+inline bool ReferenceFrame::cache_transforms(bool enabled) {
+  return ReferenceFrameVersion::cache_transforms(enabled);
+}
+
+inline bool ReferenceFrame::cache_transforms() {
+  return ReferenceFrameVersion::cache_transforms();
+}
+
+inline void ReferenceFrame::clear_transform_cache() {
+  ReferenceFrameVersion::clear_transform_cache();
+}
+
 inline void ReferenceFrame::save(
       madara::knowledge::KnowledgeBase &kb,
       const FrameEvalSettings &settings) const {
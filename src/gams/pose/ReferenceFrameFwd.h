@@ -59,6 +59,7 @@
 #include "madara/knowledge/KnowledgeBase.h"
 #include <stdexcept>
 #include <sstream>
+#include <vector>
 
 namespace gams { namespace pose {
 
@@ -69,6 +70,8 @@ class Pose;
 class Position;
 class Orientation;
 class ReferenceFrame;
+class Quaternion;
+class RigidTransform;
 
 MADARA_MAKE_VAL_SUPPORT_TEST(transform_to, x,
     (x.transform_to(std::declval<ReferenceFrame>())));
@@ -283,6 +286,19 @@ public:
    **/
   const Pose &origin() const;
 
+  /**
+   * Gets the orientation of the origin as a quaternion, cached when this
+   * frame version was created.
+   **/
+  const Quaternion &origin_quaternion() const;
+
+  /**
+   * Gets the transform of linear coordinates from this frame into its
+   * parent, cached when this frame version was created. The translation
+   * is only meaningful if both frames are Cartesian.
+   **/
+  const RigidTransform &to_origin_transform() const;
+
   /**
    * Creates a new ReferenceFrame with modified origin
    *
@@ -461,6 +477,23 @@ public:
   /// @return std::string holding ".gams.frames"
   static const std::string &default_prefix();
 
+  /**
+   * Enable or disable caching of composed transforms. When enabled
+   * (the default), transforms between frames connected only through
+   * Cartesian frames are composed once per pair of frame versions, and
+   * later conversions between them apply the cached result directly.
+   *
+   * @param enabled true to cache composed transforms
+   * @return previous setting
+   **/
+  static bool cache_transforms(bool enabled);
+
+  /// Return true if composed transforms are being cached
+  static bool cache_transforms();
+
+  /// Drop all cached composed transforms
+  static void clear_transform_cache();
+
   /**
    * Test if frame is interpolated.
    *
@@ -596,6 +629,65 @@ public:
   ReferenceFrame interpolate(const ReferenceFrame &other,
       ReferenceFrame parent, uint64_t time) const;
 
+  /**
+   * Transform arrays of linear coordinates from another frame into this
+   * one, in place. The path between the frames is resolved once for the
+   * whole batch; runs of Cartesian hops are applied as a single rotation
+   * and translation, and GPS hops convert all points with one converter.
+   *
+   * @param from the frame the coordinates are currently in
+   * @param x array of x coordinates (latitude, for GPS frames)
+   * @param y array of y coordinates (longitude, for GPS frames)
+   * @param z array of z coordinates (altitude, for GPS frames)
+   * @param count number of elements in each array
+   * @param fixed false for free vectors (e.g., velocities), which are
+   *        rotated but not translated
+   *
+   * @throws unrelated_frames if from has no common parent with this frame
+   **/
+  void transform_batch(const ReferenceFrame &from,
+      double *x, double *y, double *z, size_t count,
+      bool fixed = true) const;
+
+  /**
+   * Transform Positions into this frame, in place. Positions may be in
+   * different frames; each run of Positions sharing a frame is
+   * transformed together.
+   *
+   * @param positions array of Positions to transform
+   * @param count number of Positions in the array
+   *
+   * @throws unrelated_frames if a Position has no common parent with
+   *         this frame
+   **/
+  void transform_batch(Position *positions, size_t count) const;
+
+  /**
+   * Transform Positions into this frame, in place.
+   *
+   * @param positions the Positions to transform
+   **/
+  void transform_batch(std::vector<Position> &positions) const;
+
+  /**
+   * Transform Poses into this frame, in place. Each run of Poses sharing
+   * a frame is transformed together.
+   *
+   * @param poses array of Poses to transform
+   * @param count number of Poses in the array
+   *
+   * @throws unrelated_frames if a Pose has no common parent with
+   *         this frame
+   **/
+  void transform_batch(Pose *poses, size_t count) const;
+
+  /**
+   * Transform Poses into this frame, in place.
+   *
+   * @param poses the Poses to transform
+   **/
+  void transform_batch(std::vector<Pose> &poses) const;
+
   friend class ReferenceFrameVersion;
 };
 
@@ -684,6 +776,22 @@ struct GAMS_EXPORT ReferenceFrameType {
                   const ReferenceFrameType *self,
                   double &x, double &y, double &z,
                   double &rx, double &ry, double &rz);
+
+  void (*transform_linear_batch_to_origin)(
+                  const ReferenceFrameType *origin,
+                  const ReferenceFrameType *self,
+                  double ox, double oy, double oz,
+                  double orx, double ory, double orz,
+                  double *x, double *y, double *z, size_t count,
+                  bool fixed);
+
+  void (*transform_linear_batch_from_origin)(
+                  const ReferenceFrameType *origin,
+                  const ReferenceFrameType *self,
+                  double ox, double oy, double oz,
+                  double orx, double ory, double orz,
+                  double *x, double *y, double *z, size_t count,
+                  bool fixed);
 };
 
 /**
@@ -55,6 +55,8 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <memory>
 
 #include "Region.h"
 #include "madara/utility/Utility.h"
@@ -69,6 +71,200 @@ using std::vector;
 
 typedef  madara::knowledge::KnowledgeRecord::Integer Integer;
 
+/**
+ * Flat copy of the vertices of a region, with values derived from them,
+ * so contains and distance loop over contiguous arrays. For contains,
+ * edge i runs from vertex i - 1 to vertex i; for distance, from vertex i
+ * to vertex i + 1 (both wrapping around).
+ **/
+struct gams::pose::Region::PolygonIndex
+{
+  /**
+   * Constructor
+   * @param  vertices  the vertices of the region
+   **/
+  explicit PolygonIndex (const vector<Position> & vertices);
+
+  /**
+   * Checks if vertices are still the ones this index was built from
+   * @param  vertices  the current vertices of the region
+   * @return true if unchanged
+   **/
+  bool matches (const vector<Position> & vertices) const;
+
+  /**
+   * Checks if a GPS point is in the polygon
+   * @return true if inside, or a vertex
+   **/
+  bool contains (double lng, double lat, double alt) const;
+
+  /**
+   * Gets distance from a point in local_frame to the nearest edge
+   * @return the distance in meters
+   **/
+  double edge_distance (double px, double py) const;
+
+  /// the vertices, as of construction
+  vector<double> lng, lat, alt;
+  vector<ReferenceFrame> frames;
+
+  /// the vertex before each vertex
+  vector<double> prev_lng, prev_lat;
+
+  /// change in latitude per change in longitude of each edge
+  vector<double> slope;
+
+  /// bounding box
+  double min_lat, max_lat, min_lng, max_lng;
+
+  /// equirectangular projection at the south-west corner
+  ReferenceFrame local_frame;
+
+  /// vertices projected into local_frame, with z dropped
+  vector<double> x, y;
+
+  /// vector to the next vertex, and its inverse squared length
+  vector<double> edge_dx, edge_dy, edge_inv_len2;
+};
+
+gams::pose::Region::PolygonIndex::PolygonIndex (
+  const vector<Position> & vertices)
+  : min_lat (DBL_MAX), max_lat (-DBL_MAX),
+    min_lng (DBL_MAX), max_lng (-DBL_MAX)
+{
+  const size_t num = vertices.size ();
+
+  lng.resize (num);
+  lat.resize (num);
+  alt.resize (num);
+  frames.reserve (num);
+  for (size_t i = 0; i < num; ++i)
+  {
+    lng[i] = vertices[i].longitude ();
+    lat[i] = vertices[i].latitude ();
+    alt[i] = vertices[i].altitude ();
+    frames.push_back (vertices[i].frame ());
+
+    min_lat = std::min (min_lat, lat[i]);
+    max_lat = std::max (max_lat, lat[i]);
+    min_lng = std::min (min_lng, lng[i]);
+    max_lng = std::max (max_lng, lng[i]);
+  }
+
+  if (num == 0)
+    return;
+
+  prev_lng.resize (num);
+  prev_lat.resize (num);
+  slope.resize (num);
+  for (size_t i = 0, j = num - 1; i < num; j = i++)
+  {
+    prev_lng[i] = lng[j];
+    prev_lat[i] = lat[j];
+
+    // vertical edges are never crossed by pnpoly's ray, so any slope works
+    const double dlng = lng[j] - lng[i];
+    slope[i] = dlng != 0 ? (lat[j] - lat[i]) / dlng : 0;
+  }
+
+  local_frame = ReferenceFrame (Position (pose::gps_frame (), min_lng, min_lat));
+
+  vector<Position> local_vertices (vertices);
+  local_frame.transform_batch (local_vertices);
+
+  x.resize (num);
+  y.resize (num);
+  for (size_t i = 0; i < num; ++i)
+  {
+    x[i] = local_vertices[i].x ();
+    y[i] = local_vertices[i].y ();
+  }
+
+  edge_dx.resize (num);
+  edge_dy.resize (num);
+  edge_inv_len2.resize (num);
+  for (size_t i = 0; i < num; ++i)
+  {
+    const size_t next = i + 1 < num ? i + 1 : 0;
+    edge_dx[i] = x[next] - x[i];
+    edge_dy[i] = y[next] - y[i];
+
+    const double len2 = edge_dx[i] * edge_dx[i] + edge_dy[i] * edge_dy[i];
+    edge_inv_len2[i] = len2 > 0 ? 1 / len2 : 0;
+  }
+}
+
+bool
+gams::pose::Region::PolygonIndex::matches (
+  const vector<Position> & vertices) const
+{
+  if (vertices.size () != lng.size ())
+    return false;
+
+  for (size_t i = 0; i < vertices.size (); ++i)
+  {
+    if (vertices[i].longitude () != lng[i] ||
+        vertices[i].latitude () != lat[i] ||
+        vertices[i].altitude () != alt[i] ||
+        vertices[i].frame () != frames[i])
+      return false;
+  }
+  return true;
+}
+
+bool
+gams::pose::Region::PolygonIndex::contains (
+  double p_lng, double p_lat, double p_alt) const
+{
+  if (p_lat < min_lat || p_lat > max_lat ||
+      p_lng < min_lng || p_lng > max_lng)
+    return false;
+
+  // pnpoly, from
+  // http://www.ecse.rpi.edu/Homepages/wrf/Research/ShortNotes/pnpoly.html
+  // with the per-edge division precomputed
+  const size_t num = lng.size ();
+  bool ret = false;
+  for (size_t i = 0; i < num; ++i)
+  {
+    const bool straddles = (lng[i] > p_lng) != (prev_lng[i] > p_lng);
+    const bool below = p_lat < slope[i] * (p_lng - lng[i]) + lat[i];
+    ret ^= straddles & below;
+  }
+
+  // check if this is a vertex point
+  if (!ret)
+  {
+    const ReferenceFrame & gps = pose::gps_frame ();
+    for (size_t i = 0; i < num && !ret; ++i)
+      ret = lng[i] == p_lng && lat[i] == p_lat && alt[i] == p_alt &&
+        frames[i] == gps;
+  }
+
+  // TODO: add check for border point
+
+  return ret;
+}
+
+double
+gams::pose::Region::PolygonIndex::edge_distance (double px, double py) const
+{
+  double min_dist2 = DBL_MAX;
+  for (size_t i = 0; i < x.size (); ++i)
+  {
+    // nearest point on the edge, clamped to its end points
+    double t = ((px - x[i]) * edge_dx[i] + (py - y[i]) * edge_dy[i]) *
+      edge_inv_len2[i];
+    t = std::min (std::max (t, 0.0), 1.0);
+
+    const double dx = x[i] + t * edge_dx[i] - px;
+    const double dy = y[i] + t * edge_dy[i] - py;
+    min_dist2 = std::min (min_dist2, dx * dx + dy * dy);
+  }
+
+  return sqrt (min_dist2);
+}
+
 gams::pose::Region::Region (
   const std::vector <Position> & init_vertices, unsigned int type, 
   const std::string& name) :
@@ -94,6 +290,7 @@ gams::pose::Region::operator= (const Region& rhs)
     this->vertices = rhs.vertices;
     this->name_ = rhs.name_;
     this->type_ = rhs.type_;
+    std::atomic_store (&this->index_, std::atomic_load (&rhs.index_));
     calculate_bounding_box ();
   }
 }
@@ -149,41 +346,37 @@ gams::pose::Region::contains (const Position & pos) const
 
   Position p(pose::gps_frame(), pos);
 
-  // check if in bounding box
-  if (p.latitude () < min_lat_ || p.latitude () > max_lat_ ||
-      p.longitude () < min_lon_ || p.longitude () > max_lon_)
-  {
-    return false;
-  }
+  return get_index ()->contains (p.longitude (), p.latitude (), p.altitude ());
+}
 
-  // check if point in polygon code from 
-  // http://www.ecse.rpi.edu/Homepages/wrf/Research/ShortNotes/pnpoly.html
-  size_t i, j;
-  bool ret = false;
-  for (i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+void
+gams::pose::Region::contains (const Position * positions, size_t count,
+  bool * results) const
+{
+  if (vertices.size () < 1)
   {
-    if ( (vertices[i].longitude () > p.longitude ()) !=
-        (vertices[j].longitude () > p.longitude ()))
-    {
-      if (p.latitude () < (vertices[j].latitude () - vertices[i].latitude ()) * (p.longitude () - vertices[i].longitude ()) / 
-                (vertices[j].longitude () - vertices[i].longitude ()) + 
-                 vertices[i].latitude ())
-      {
-        ret = !ret;
-      }
-    }
+    std::fill (results, results + count, false);
+    return;
   }
 
-  // check if this is a vertex point
-  if (!ret)
+  std::shared_ptr<const PolygonIndex> index = get_index ();
+
+  vector<Position> gps_positions (positions, positions + count);
+  pose::gps_frame ().transform_batch (gps_positions);
+
+  for (size_t i = 0; i < count; ++i)
   {
-    for (unsigned int i = 0; i < vertices.size() && !ret; ++i)
-      ret = (vertices[i] == p);
+    const Position & p = gps_positions[i];
+    results[i] = index->contains (p.longitude (), p.latitude (), p.altitude ());
   }
+}
 
-  // TODO: add check for border point
-
-  return ret;
+std::vector <bool>
+gams::pose::Region::contains (const std::vector <Position> & positions) const
+{
+  std::unique_ptr<bool[]> results (new bool[positions.size ()]);
+  contains (positions.data (), positions.size (), results.get ());
+  return std::vector <bool> (results.get (), results.get () + positions.size ());
 }
 
 double
@@ -191,37 +384,19 @@ gams::pose::Region::distance (const Position& p) const
 {
   if (vertices.size() < 1)
     return DBL_MAX;
-  // if point is in region, then the distance is 0
-  if (contains (p))
-    return 0;
-
-  // convert to cartesian coords with equirectangular projection
-  const Position sw (pose::gps_frame(), min_lon_, min_lat_);
-  ReferenceFrame local_frame(sw);
 
-  vector<Position> local_vertices;
-  for (size_t i = 0; i < vertices.size (); ++i)
-  {
-    local_vertices.push_back (vertices[i].transform_to (local_frame));
-    local_vertices.back().z(0);
-  }
-  Position local_p = p.transform_to (local_frame);
-  local_p.z(0);
+  std::shared_ptr<const PolygonIndex> index = get_index ();
 
-  // else we check for distance from each edge
-  double min_dist = DBL_MAX;
-  for (size_t i = 0; i < local_vertices.size (); ++i)
-  {
-    //const size_t i_1 = (i + 1) % local_vertices.size();
-    //double dist = local_vertices[i].distance_to (local_vertices[i_1], local_p);
-
-    // TODO: Calculate distance to edge instead of to vertex
-    double dist = local_vertices[i].distance_to (local_p);
-    if (dist < min_dist)
-      min_dist = dist;
-  }
+  // if point is in region, then the distance is 0
+  Position gps_p (pose::gps_frame (), p);
+  if (index->contains (gps_p.longitude (), gps_p.latitude (),
+        gps_p.altitude ()))
+    return 0;
 
-  return min_dist;
+  // else we check for distance from each edge, in the equirectangular
+  // projection of the index
+  Position local_p = p.transform_to (index->local_frame);
+  return index->edge_distance (local_p.x (), local_p.y ());
 }
 
 gams::pose::Region
@@ -267,26 +442,20 @@ gams::pose::Region::get_area () const
   if (vertices.size() < 3)
     return 0; // degenerate polygon
 
-  // convert to cartesian coords with equirectangular projection
-  const Position sw (pose::gps_frame(), min_lon_, min_lat_);
-  ReferenceFrame local_frame(sw);
-  vector<Position> cart_vertices;
-  for (unsigned int i = 0; i < vertices.size(); ++i)
-  {
-    Position p = vertices[i].transform_to (local_frame);
-    cart_vertices.push_back (p);
-  }
+  // use vertices in the equirectangular projection of the index
+  std::shared_ptr<const PolygonIndex> index = get_index ();
+  const vector<double> & x = index->x;
+  const vector<double> & y = index->y;
 
   // perform calculations with cartesian vertices
   double area = 0.0;
   size_t i, j, k;
-  size_t num_vertices = cart_vertices.size ();
+  size_t num_vertices = x.size ();
   for (i = 1, j = 2, k = 0; i < num_vertices; ++i, ++j, ++k)
   {
-    area += cart_vertices[i].x() *
-      (cart_vertices[j % num_vertices].y() - cart_vertices[k].y());
+    area += x[i] * (y[j % num_vertices] - y[k]);
   }
-  area += cart_vertices[0].x() * (cart_vertices[1].y() - cart_vertices[num_vertices - 1].y());
+  area += x[0] * (y[1] - y[num_vertices - 1]);
   return fabs(area / 2);
 }
 
@@ -308,6 +477,18 @@ gams::pose::Region::to_string (const string & delimiter) const
   return buffer.str ();
 }
 
+std::shared_ptr<const gams::pose::Region::PolygonIndex>
+gams::pose::Region::get_index () const
+{
+  std::shared_ptr<const PolygonIndex> index = std::atomic_load (&index_);
+  if (!index || !index->matches (vertices))
+  {
+    index = std::make_shared<const PolygonIndex> (vertices);
+    std::atomic_store (&index_, index);
+  }
+  return index;
+}
+
 void
 gams::pose::Region::calculate_bounding_box ()
 {
@@ -58,6 +58,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 
 #include "gams/GamsExport.h"
 #include "madara/knowledge/containers/StringVector.h"
@@ -130,10 +131,29 @@ namespace gams
        **/
       bool contains (const Position & position) const;
 
+      /**
+       * Determines which of several positions are in region. Faster than
+       * calling contains on each position.
+       * @param   positions  points to check
+       * @param   count      number of points
+       * @param   results    set to true for each point in region or on
+       *                     border, false otherwise
+       **/
+      void contains (const Position * positions, size_t count,
+        bool * results) const;
+
+      /**
+       * Determines which of several positions are in region
+       * @param   positions  points to check
+       * @return  for each point, true if in region or on border
+       **/
+      std::vector <bool> contains (
+        const std::vector <Position> & positions) const;
+
       /**
        * Gets distance from any point in this region
        * @param   position     point to check
-       * @return 0 if in region, otherwise distance from region
+       * @return 0 if in region, otherwise distance to the nearest edge
        **/
       double distance (const Position & position) const;
 
@@ -156,7 +176,11 @@ namespace gams
        **/
       std::string to_string (const std::string & delimiter = ":") const;
 
-      /// the vertices of the region
+      /**
+       * The vertices of the region. Values derived from these for
+       * contains, distance and get_area are cached, and recomputed when
+       * the vertices are found to have changed.
+       **/
       std::vector <Position> vertices;
 
       /// bounding box
@@ -174,6 +198,18 @@ namespace gams
       unsigned int type_;
 
     private:
+      /// flat copy of the vertices, with per-edge values, in cpp
+      struct PolygonIndex;
+
+      /**
+       * Returns the polygon index, rebuilding it if the vertices changed
+       * @return the current index
+       **/
+      std::shared_ptr<const PolygonIndex> get_index () const;
+
+      /// cached polygon index
+      mutable std::shared_ptr<const PolygonIndex> index_;
+
       /**
        * Check if object is of correct type
        * @param kb        Knowledge Base with object
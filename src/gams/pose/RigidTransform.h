@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file RigidTransform.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the RigidTransform class, a rotation matrix and
+ * translation for applying frame hops without trigonometry
+ **/
+
+#include "ReferenceFrame.h"
+
+#ifndef _GAMS_POSE_RIGID_TRANSFORM_H_
+#define _GAMS_POSE_RIGID_TRANSFORM_H_
+
+#include <cstddef>
+#include "Quaternion.h"
+
+namespace gams
+{
+  namespace pose
+  {
+    /**
+     * Maps linear coordinates p to rot * p + trans. Used internally to
+     * cache frame hops, so applying them is only multiplies and adds.
+     * Not reference-frame aware.
+     **/
+    class RigidTransform
+    {
+    public:
+      /**
+       * Default constructor. Initializes to the identity.
+       **/
+      constexpr RigidTransform()
+        : RigidTransform(1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0) {}
+
+      /**
+       * Primary constructor. Specifies the rotation matrix, by rows,
+       * and the translation explicitly
+       **/
+      constexpr RigidTransform(
+          double r00, double r01, double r02,
+          double r10, double r11, double r12,
+          double r20, double r21, double r22,
+          double tx, double ty, double tz)
+        : rot_{r00, r01, r02, r10, r11, r12, r20, r21, r22},
+          trans_{tx, ty, tz} {}
+
+      /**
+       * Constructor from a unit quaternion, which gives the same rotation
+       * as Quaternion::orient_by, followed by a translation
+       **/
+      constexpr RigidTransform(const Quaternion &quat,
+          double tx = 0, double ty = 0, double tz = 0)
+        : RigidTransform(
+            1 - 2 * (quat.y() * quat.y() + quat.z() * quat.z()),
+            2 * (quat.x() * quat.y() - quat.z() * quat.w()),
+            2 * (quat.x() * quat.z() + quat.y() * quat.w()),
+            2 * (quat.x() * quat.y() + quat.z() * quat.w()),
+            1 - 2 * (quat.x() * quat.x() + quat.z() * quat.z()),
+            2 * (quat.y() * quat.z() - quat.x() * quat.w()),
+            2 * (quat.x() * quat.z() - quat.y() * quat.w()),
+            2 * (quat.y() * quat.z() + quat.x() * quat.w()),
+            1 - 2 * (quat.x() * quat.x() + quat.y() * quat.y()),
+            tx, ty, tz) {}
+
+      /**
+       * Creates a pure translation
+       **/
+      static constexpr RigidTransform translation(
+          double tx, double ty, double tz)
+      {
+        return RigidTransform(1, 0, 0, 0, 1, 0, 0, 0, 1, tx, ty, tz);
+      }
+
+      /** Row i, column j of the rotation matrix */
+      constexpr double rot(int i, int j) const { return rot_[i * 3 + j]; }
+
+      /** Term i of the translation */
+      constexpr double trans(int i) const { return trans_[i]; }
+
+      /**
+       * Composes two transforms: applying the result is the same as
+       * applying rhs, then this.
+       *
+       * @param rhs the transform to apply first
+       * @return the composed transform
+       **/
+      constexpr RigidTransform operator*(const RigidTransform &rhs) const
+      {
+        return RigidTransform(
+            row_col(0, rhs, 0), row_col(0, rhs, 1), row_col(0, rhs, 2),
+            row_col(1, rhs, 0), row_col(1, rhs, 1), row_col(1, rhs, 2),
+            row_col(2, rhs, 0), row_col(2, rhs, 1), row_col(2, rhs, 2),
+            row_trans(0, rhs), row_trans(1, rhs), row_trans(2, rhs));
+      }
+
+      /**
+       * Calculate this * rhs, and store into this.
+       *
+       * @param rhs the transform to apply before this one
+       * @return *this, the result
+       **/
+      RigidTransform &operator*=(const RigidTransform &rhs)
+      {
+        return *this = *this * rhs;
+      }
+
+      /**
+       * Gets the inverse, assuming rot is orthonormal
+       *
+       * @return a transform mapping rot * p + trans back to p
+       **/
+      constexpr RigidTransform inverse() const
+      {
+        return RigidTransform(
+            rot_[0], rot_[3], rot_[6],
+            rot_[1], rot_[4], rot_[7],
+            rot_[2], rot_[5], rot_[8],
+            -(rot_[0] * trans_[0] + rot_[3] * trans_[1] + rot_[6] * trans_[2]),
+            -(rot_[1] * trans_[0] + rot_[4] * trans_[1] + rot_[7] * trans_[2]),
+            -(rot_[2] * trans_[0] + rot_[5] * trans_[1] + rot_[8] * trans_[2]));
+      }
+
+      /**
+       * Gets this transform without its translation
+       **/
+      constexpr RigidTransform rotation() const
+      {
+        return RigidTransform(
+            rot_[0], rot_[1], rot_[2],
+            rot_[3], rot_[4], rot_[5],
+            rot_[6], rot_[7], rot_[8],
+            0, 0, 0);
+      }
+
+      /**
+       * Transforms linear coordinates in place
+       *
+       * @param fixed if false (e.g., velocities) translation is not applied
+       **/
+      void apply(double &x, double &y, double &z, bool fixed = true) const
+      {
+        const double nx = rot_[0] * x + rot_[1] * y + rot_[2] * z;
+        const double ny = rot_[3] * x + rot_[4] * y + rot_[5] * z;
+        const double nz = rot_[6] * x + rot_[7] * y + rot_[8] * z;
+
+        x = fixed ? nx + trans_[0] : nx;
+        y = fixed ? ny + trans_[1] : ny;
+        z = fixed ? nz + trans_[2] : nz;
+      }
+
+      /**
+       * Transforms arrays of linear coordinates in place.
+       *
+       * @param x array of x coordinates
+       * @param y array of y coordinates
+       * @param z array of z coordinates
+       * @param count number of elements in each array
+       * @param fixed if false (e.g., velocities) translation is not applied
+       **/
+      void apply(double *x, double *y, double *z, size_t count,
+                 bool fixed = true) const
+      {
+        // locals keep the loop free of loads through this, so it can be
+        // vectorized across elements
+        const double r00 = rot_[0], r01 = rot_[1], r02 = rot_[2];
+        const double r10 = rot_[3], r11 = rot_[4], r12 = rot_[5];
+        const double r20 = rot_[6], r21 = rot_[7], r22 = rot_[8];
+        const double tx = fixed ? trans_[0] : 0;
+        const double ty = fixed ? trans_[1] : 0;
+        const double tz = fixed ? trans_[2] : 0;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          const double px = x[i], py = y[i], pz = z[i];
+          x[i] = r00 * px + r01 * py + r02 * pz + tx;
+          y[i] = r10 * px + r11 * py + r12 * pz + ty;
+          z[i] = r20 * px + r21 * py + r22 * pz + tz;
+        }
+      }
+
+    private:
+      /// row i of this, times column j of rhs
+      constexpr double row_col(int i, const RigidTransform &rhs, int j) const
+      {
+        return rot_[i * 3] * rhs.rot_[j] +
+               rot_[i * 3 + 1] * rhs.rot_[3 + j] +
+               rot_[i * 3 + 2] * rhs.rot_[6 + j];
+      }
+
+      /// term i of this applied to the translation of rhs
+      constexpr double row_trans(int i, const RigidTransform &rhs) const
+      {
+        return rot_[i * 3] * rhs.trans_[0] +
+               rot_[i * 3 + 1] * rhs.trans_[1] +
+               rot_[i * 3 + 2] * rhs.trans_[2] + trans_[i];
+      }
+
+      /// rotation matrix, row-major
+      double rot_[9];
+
+      /// translation, applied after rotation
+      double trans_[3];
+    };
+  }
+}
+
+#endif
@@ -61,6 +61,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <cfloat>
 
 #include "gams/pose/Region.h"
 #include "gams/loggers/GlobalLogger.h"
@@ -82,6 +83,174 @@ using std::vector;
 namespace mutility = madara::utility;
 typedef madara::knowledge::KnowledgeRecord::Integer Integer;
 
+/**
+ * Uniform grid over the bounding boxes of the regions of a search area.
+ * Each cell lists the regions whose boxes overlap it, highest priority
+ * first, so a lookup only tests the few regions near a point, and can
+ * stop at the first one containing it.
+ **/
+struct gams::pose::SearchArea::RegionGrid
+{
+  /**
+   * Constructor
+   * @param  regions  the regions of the search area
+   **/
+  explicit RegionGrid (const vector<PrioritizedRegion> & regions);
+
+  /**
+   * Finds the cell a GPS point falls in
+   * @param  lng    longitude of the point
+   * @param  lat    latitude of the point
+   * @param  cell   set to the cell index, if found
+   * @return false if the point is outside the grid
+   **/
+  bool cell_of (double lng, double lat, size_t & cell) const;
+
+  /**
+   * Checks if a GPS point is in the box of a region
+   * @param  region index of the region
+   * @return true if inside or on the box
+   **/
+  bool in_box (size_t region, double lng, double lat) const
+  {
+    return lng >= min_lng[region] && lng <= max_lng[region] &&
+           lat >= min_lat[region] && lat <= max_lat[region];
+  }
+
+  /// bounding box of each region
+  vector<double> min_lng, max_lng, min_lat, max_lat;
+
+  /// bounding box of the grid
+  double grid_min_lng, grid_max_lng, grid_min_lat, grid_max_lat;
+
+  /// grid dimensions, and the size of each cell in degrees
+  size_t rows, cols;
+  double cell_lng, cell_lat;
+
+  /// regions overlapping cell c are cell_regions[cell_start[c]] up to
+  /// cell_regions[cell_start[c + 1]], sorted by descending priority
+  vector<size_t> cell_start;
+  vector<size_t> cell_regions;
+};
+
+gams::pose::SearchArea::RegionGrid::RegionGrid (
+  const vector<PrioritizedRegion> & regions)
+  : grid_min_lng (DBL_MAX), grid_max_lng (-DBL_MAX),
+    grid_min_lat (DBL_MAX), grid_max_lat (-DBL_MAX),
+    rows (1), cols (1), cell_lng (0), cell_lat (0)
+{
+  const size_t num = regions.size ();
+
+  min_lng.assign (num, DBL_MAX);
+  max_lng.assign (num, -DBL_MAX);
+  min_lat.assign (num, DBL_MAX);
+  max_lat.assign (num, -DBL_MAX);
+
+  // regions without vertices keep an empty box and are never listed
+  vector<size_t> order;
+  order.reserve (num);
+  for (size_t i = 0; i < num; ++i)
+  {
+    const vector<Position> & vertices = regions[i].vertices;
+    if (vertices.empty ())
+      continue;
+
+    for (const Position & v : vertices)
+    {
+      Position gps_v (pose::gps_frame (), v);
+      min_lng[i] = std::min (min_lng[i], gps_v.longitude ());
+      max_lng[i] = std::max (max_lng[i], gps_v.longitude ());
+      min_lat[i] = std::min (min_lat[i], gps_v.latitude ());
+      max_lat[i] = std::max (max_lat[i], gps_v.latitude ());
+    }
+
+    grid_min_lng = std::min (grid_min_lng, min_lng[i]);
+    grid_max_lng = std::max (grid_max_lng, max_lng[i]);
+    grid_min_lat = std::min (grid_min_lat, min_lat[i]);
+    grid_max_lat = std::max (grid_max_lat, max_lat[i]);
+
+    order.push_back (i);
+  }
+
+  // stable, so equal priorities keep the order they were added in
+  std::stable_sort (order.begin (), order.end (),
+    [&regions] (size_t a, size_t b)
+    { return regions[a].priority > regions[b].priority; });
+
+  if (order.empty ())
+  {
+    cell_start.assign (2, 0);
+    return;
+  }
+
+  // about four cells per region, shaped to the aspect ratio of the area
+  const double width = grid_max_lng - grid_min_lng;
+  const double height = grid_max_lat - grid_min_lat;
+  const double target = (double)std::min<size_t> (4 * order.size (), 4096);
+  if (width > 0 && height > 0)
+  {
+    cols = (size_t)std::max (1.0, std::sqrt (target * width / height));
+    rows = (size_t)std::max (1.0, target / cols);
+    cols = std::min<size_t> (cols, 4096);
+    rows = std::min<size_t> (rows, 4096);
+  }
+  else if (width > 0)
+    cols = (size_t)target;
+  else if (height > 0)
+    rows = (size_t)target;
+
+  cell_lng = width / cols;
+  cell_lat = height / rows;
+
+  // bucket regions by the cells their boxes cover, counting first so the
+  // lists can be laid out contiguously
+  cell_start.assign (rows * cols + 1, 0);
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    vector<size_t> fill;
+    if (pass == 1)
+    {
+      for (size_t c = 0; c < rows * cols; ++c)
+        cell_start[c + 1] += cell_start[c];
+      cell_regions.resize (cell_start.back ());
+      fill.assign (cell_start.begin (), cell_start.end () - 1);
+    }
+
+    for (size_t i : order)
+    {
+      size_t low, high;
+      cell_of (min_lng[i], min_lat[i], low);
+      cell_of (max_lng[i], max_lat[i], high);
+
+      for (size_t r = low / cols; r <= high / cols; ++r)
+      {
+        for (size_t c = low % cols; c <= high % cols; ++c)
+        {
+          const size_t cell = r * cols + c;
+          if (pass == 0)
+            ++cell_start[cell + 1];
+          else
+            cell_regions[fill[cell]++] = i;
+        }
+      }
+    }
+  }
+}
+
+bool
+gams::pose::SearchArea::RegionGrid::cell_of (
+  double lng, double lat, size_t & cell) const
+{
+  if (!(lng >= grid_min_lng && lng <= grid_max_lng &&
+        lat >= grid_min_lat && lat <= grid_max_lat))
+    return false;
+
+  size_t c = cell_lng > 0 ? (size_t)((lng - grid_min_lng) / cell_lng) : 0;
+  size_t r = cell_lat > 0 ? (size_t)((lat - grid_min_lat) / cell_lat) : 0;
+  cell = std::min (r, rows - 1) * cols + std::min (c, cols - 1);
+  return true;
+}
+
 gams::pose::SearchArea::SearchArea () :
   Containerize()
 {
@@ -145,6 +314,7 @@ gams::pose::SearchArea::operator= (const SearchArea & rhs)
     this->min_alt_ = rhs.min_alt_;
     this->max_alt_ = rhs.max_alt_;
     this->name_ = rhs.name_;
+    std::atomic_store (&this->grid_, std::atomic_load (&rhs.grid_));
   }
 }
 
@@ -161,6 +331,8 @@ gams::pose::SearchArea::add_prioritized_region (const PrioritizedRegion& r)
   max_lat_ = (max_lat_ < r.max_lat_) ? r.max_lat_ : max_lat_;
   max_lon_ = (max_lon_ < r.max_lon_) ? r.max_lon_ : max_lon_;
   max_alt_ = (max_alt_ < r.max_alt_) ? r.max_alt_ : max_alt_;
+
+  std::atomic_store (&grid_, std::shared_ptr<const RegionGrid> ());
 }
 
 gams::pose::Region
@@ -339,26 +511,112 @@ gams::pose::SearchArea::get_regions () const
   return regions_;
 }
 
+std::shared_ptr<const gams::pose::SearchArea::RegionGrid>
+gams::pose::SearchArea::get_grid () const
+{
+  std::shared_ptr<const RegionGrid> grid = std::atomic_load (&grid_);
+  if (!grid)
+  {
+    grid = std::make_shared<const RegionGrid> (regions_);
+    std::atomic_store (&grid_, grid);
+  }
+  return grid;
+}
+
 madara::knowledge::KnowledgeRecord::Integer
 gams::pose::SearchArea::get_priority (const Position& pos) const
 {
-  madara::knowledge::KnowledgeRecord::Integer priority = 0;
-  for (vector<PrioritizedRegion>::const_iterator it = regions_.begin ();
-    it != regions_.end (); ++it)
+  std::shared_ptr<const RegionGrid> grid = get_grid ();
+  Position gps_pos (pose::gps_frame (), pos);
+
+  size_t cell;
+  if (!grid->cell_of (gps_pos.longitude (), gps_pos.latitude (), cell))
+    return 0;
+
+  // candidates are in descending priority, so the first match is the max
+  for (size_t j = grid->cell_start[cell]; j < grid->cell_start[cell + 1]; ++j)
+  {
+    const size_t i = grid->cell_regions[j];
+    if (regions_[i].priority <= 0)
+      break;
+
+    if (grid->in_box (i, gps_pos.longitude (), gps_pos.latitude ()) &&
+        regions_[i].contains (gps_pos))
+      return regions_[i].priority;
+  }
+
+  return 0;
+}
+
+std::vector<madara::knowledge::KnowledgeRecord::Integer>
+gams::pose::SearchArea::get_priority_image (size_t rows, size_t cols) const
+{
+  vector<Integer> image (rows * cols, 0);
+  if (rows == 0 || cols == 0)
+    return image;
+
+  std::shared_ptr<const RegionGrid> grid = get_grid ();
+  if (grid->cell_regions.empty ())
+    return image;
+
+  const double pixel_lng = (grid->grid_max_lng - grid->grid_min_lng) / cols;
+  const double pixel_lat = (grid->grid_max_lat - grid->grid_min_lat) / rows;
+
+  // test each region once against the pixel centers inside its box
+  vector<size_t> pixels;
+  vector<Position> centers;
+  for (size_t i = 0; i < regions_.size (); ++i)
   {
-    if (it->contains (pos))
-      priority = max (priority, it->priority);
+    const Integer priority = regions_[i].priority;
+    if (priority <= 0 || regions_[i].vertices.empty ())
+      continue;
+
+    pixels.clear ();
+    centers.clear ();
+    for (size_t r = 0; r < rows; ++r)
+    {
+      const double lat = grid->grid_max_lat - (r + 0.5) * pixel_lat;
+      if (lat < grid->min_lat[i] || lat > grid->max_lat[i])
+        continue;
+
+      for (size_t c = 0; c < cols; ++c)
+      {
+        const double lng = grid->grid_min_lng + (c + 0.5) * pixel_lng;
+        if (lng < grid->min_lng[i] || lng > grid->max_lng[i] ||
+            image[r * cols + c] >= priority)
+          continue;
+
+        pixels.push_back (r * cols + c);
+        centers.push_back (Position (pose::gps_frame (), lng, lat));
+      }
+    }
+
+    const vector<bool> inside = regions_[i].contains (centers);
+    for (size_t k = 0; k < pixels.size (); ++k)
+      if (inside[k])
+        image[pixels[k]] = priority;
   }
 
-  return priority;
+  return image;
 }
 
 bool
 gams::pose::SearchArea::contains (const Position & p) const
 {
-  for (unsigned int i = 0; i < regions_.size(); ++i)
-    if (regions_[i].contains (p))
+  std::shared_ptr<const RegionGrid> grid = get_grid ();
+  Position gps_p (pose::gps_frame (), p);
+
+  size_t cell;
+  if (!grid->cell_of (gps_p.longitude (), gps_p.latitude (), cell))
+    return false;
+
+  for (size_t j = grid->cell_start[cell]; j < grid->cell_start[cell + 1]; ++j)
+  {
+    const size_t i = grid->cell_regions[j];
+    if (grid->in_box (i, gps_p.longitude (), gps_p.latitude ()) &&
+        regions_[i].contains (gps_p))
       return true;
+  }
   return false;
 }
 
@@ -387,6 +645,8 @@ gams::pose::SearchArea::calculate_bounding_box ()
     max_lon_ = (max_lon_ < regions_[i].max_lon_) ? regions_[i].max_lon_ : max_lon_;
     max_alt_ = (max_alt_ < regions_[i].max_alt_) ? regions_[i].max_alt_ : max_alt_;
   }
+
+  std::atomic_store (&grid_, std::shared_ptr<const RegionGrid> ());
 }
 
 bool
@@ -58,6 +58,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 
 #include "gams/pose/PrioritizedRegion.h"
 
@@ -141,6 +142,16 @@ namespace gams
        * @return priority of position
        */
       madara::knowledge::KnowledgeRecord::Integer get_priority (const Position& pos) const;
+
+      /**
+       * Rasterize priorities over the bounding box of the search area,
+       * sampling the center of each cell
+       * @param rows   number of rows, from north to south
+       * @param cols   number of columns, from west to east
+       * @return priorities in row-major order
+       **/
+      std::vector<madara::knowledge::KnowledgeRecord::Integer>
+        get_priority_image (size_t rows, size_t cols) const;
       
       /**
        * Determine if Position is in region
@@ -162,7 +173,8 @@ namespace gams
 
     protected:
       /**
-       * populate bounding box values
+       * populate bounding box values. Also discards the region grid, so
+       * call this after changing regions_.
        **/
       void calculate_bounding_box ();
 
@@ -180,6 +192,18 @@ namespace gams
       std::vector<PrioritizedRegion> regions_;
 
     private:
+      /// uniform grid over region bounding boxes, in cpp
+      struct RegionGrid;
+
+      /**
+       * Returns the region grid, building it if needed
+       * @return the current grid
+       **/
+      std::shared_ptr<const RegionGrid> get_grid () const;
+
+      /// cached region grid; reset when regions_ changes
+      mutable std::shared_ptr<const RegionGrid> grid_;
+
       /**
        * Check if object is of correct type
        * @param kb        Knowledge Base with object
@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file TaggedCartesian.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains Cartesian coordinate types whose frame is fixed at
+ * compile time by a tag type
+ **/
+
+#include "ReferenceFrame.h"
+
+#ifndef _GAMS_POSE_TAGGED_CARTESIAN_H_
+#define _GAMS_POSE_TAGGED_CARTESIAN_H_
+
+#include <cmath>
+#include "CartesianFrame.h"
+#include "RigidTransform.h"
+
+namespace gams { namespace pose {
+
+/**
+ * Cartesian coordinate types whose frame is a template parameter, for
+ * code that works entirely within known Cartesian frames. They hold only
+ * their values, so arithmetic and distances are plain inline math, with
+ * no frame lookups or calls through ReferenceFrameType. Coordinates with
+ * different tags cannot be mixed; convert explicitly to the dynamic types
+ * (Position, Displacement) to work across frames, or use a
+ * CartesianTransform.
+ *
+ * A tag is any type with a static function returning its frame, which
+ * must be Cartesian:
+ *
+ * @code
+ * struct MapFrame
+ * {
+ *   static const ReferenceFrame &frame();
+ * };
+ *
+ * CartesianPosition<MapFrame> goal(10, 20);
+ * @endcode
+ **/
+template<typename FrameTag>
+class CartesianDisplacement
+{
+public:
+  /// Constructs a zero displacement
+  constexpr CartesianDisplacement() : x_(0), y_(0), z_(0) {}
+
+  /// Constructs from individual terms
+  constexpr CartesianDisplacement(double x, double y, double z = 0)
+    : x_(x), y_(y), z_(z) {}
+
+  /**
+   * Converts from a Displacement in any related frame
+   *
+   * @throws unrelated_frames if not related to frame()
+   **/
+  explicit CartesianDisplacement(const Displacement &displacement)
+  {
+    Displacement conv = displacement.transform_to(frame());
+    x_ = conv.x();
+    y_ = conv.y();
+    z_ = conv.z();
+  }
+
+  /**
+   * Converts to a Displacement in frame(). This is a named function, rather
+   * than a conversion operator, since Displacement's forwarding constructors
+   * would take precedence over one.
+   **/
+  Displacement displacement() const
+  {
+    return Displacement(frame(), x_, y_, z_);
+  }
+
+  /// The frame of this type's coordinates
+  static const ReferenceFrame &frame() { return FrameTag::frame(); }
+
+  constexpr double x() const { return x_; }
+  constexpr double y() const { return y_; }
+  constexpr double z() const { return z_; }
+
+  double x(double v) { return (x_ = v); }
+  double y(double v) { return (y_ = v); }
+  double z(double v) { return (z_ = v); }
+
+  /// Dot product with another displacement
+  constexpr double dot(const CartesianDisplacement &other) const
+  {
+    return x_ * other.x_ + y_ * other.y_ + z_ * other.z_;
+  }
+
+  /// Square of the length of this displacement
+  constexpr double squaredNorm() const { return dot(*this); }
+
+  /// Length of this displacement
+  double norm() const { return std::sqrt(squaredNorm()); }
+
+  constexpr CartesianDisplacement operator-() const
+  {
+    return CartesianDisplacement(-x_, -y_, -z_);
+  }
+
+  CartesianDisplacement &operator+=(const CartesianDisplacement &rhs)
+  {
+    x_ += rhs.x_;
+    y_ += rhs.y_;
+    z_ += rhs.z_;
+    return *this;
+  }
+
+  CartesianDisplacement &operator-=(const CartesianDisplacement &rhs)
+  {
+    x_ -= rhs.x_;
+    y_ -= rhs.y_;
+    z_ -= rhs.z_;
+    return *this;
+  }
+
+  CartesianDisplacement &operator*=(double scalar)
+  {
+    x_ *= scalar;
+    y_ *= scalar;
+    z_ *= scalar;
+    return *this;
+  }
+
+  CartesianDisplacement &operator/=(double scalar)
+  {
+    x_ /= scalar;
+    y_ /= scalar;
+    z_ /= scalar;
+    return *this;
+  }
+
+private:
+  double x_, y_, z_;
+};
+
+/**
+ * A position in the Cartesian frame named by FrameTag. See
+ * CartesianDisplacement for how tags are defined.
+ **/
+template<typename FrameTag>
+class CartesianPosition
+{
+public:
+  /// Constructs the origin of frame()
+  constexpr CartesianPosition() : x_(0), y_(0), z_(0) {}
+
+  /// Constructs from individual terms
+  constexpr CartesianPosition(double x, double y, double z = 0)
+    : x_(x), y_(y), z_(z) {}
+
+  /**
+   * Converts from a Position in any related frame
+   *
+   * @throws unrelated_frames if not related to frame()
+   **/
+  explicit CartesianPosition(const Position &position)
+  {
+    Position conv = position.transform_to(frame());
+    x_ = conv.x();
+    y_ = conv.y();
+    z_ = conv.z();
+  }
+
+  /**
+   * Converts to a Position in frame(). This is a named function, rather
+   * than a conversion operator, since Position's forwarding constructors
+   * would take precedence over one.
+   **/
+  Position position() const
+  {
+    return Position(frame(), x_, y_, z_);
+  }
+
+  /// The frame of this type's coordinates
+  static const ReferenceFrame &frame() { return FrameTag::frame(); }
+
+  constexpr double x() const { return x_; }
+  constexpr double y() const { return y_; }
+  constexpr double z() const { return z_; }
+
+  double x(double v) { return (x_ = v); }
+  double y(double v) { return (y_ = v); }
+  double z(double v) { return (z_ = v); }
+
+  /// Euclidean distance to another position in the same frame
+  double distance_to(const CartesianPosition &target) const
+  {
+    return (target - *this).norm();
+  }
+
+  CartesianPosition &operator+=(const CartesianDisplacement<FrameTag> &rhs)
+  {
+    x_ += rhs.x();
+    y_ += rhs.y();
+    z_ += rhs.z();
+    return *this;
+  }
+
+  CartesianPosition &operator-=(const CartesianDisplacement<FrameTag> &rhs)
+  {
+    x_ -= rhs.x();
+    y_ -= rhs.y();
+    z_ -= rhs.z();
+    return *this;
+  }
+
+private:
+  double x_, y_, z_;
+};
+
+template<typename T>
+constexpr CartesianDisplacement<T> operator+(
+    const CartesianDisplacement<T> &lhs, const CartesianDisplacement<T> &rhs)
+{
+  return CartesianDisplacement<T>(
+      lhs.x() + rhs.x(), lhs.y() + rhs.y(), lhs.z() + rhs.z());
+}
+
+template<typename T>
+constexpr CartesianDisplacement<T> operator-(
+    const CartesianDisplacement<T> &lhs, const CartesianDisplacement<T> &rhs)
+{
+  return CartesianDisplacement<T>(
+      lhs.x() - rhs.x(), lhs.y() - rhs.y(), lhs.z() - rhs.z());
+}
+
+template<typename T>
+constexpr CartesianDisplacement<T> operator*(
+    const CartesianDisplacement<T> &lhs, double scalar)
+{
+  return CartesianDisplacement<T>(
+      lhs.x() * scalar, lhs.y() * scalar, lhs.z() * scalar);
+}
+
+template<typename T>
+constexpr CartesianDisplacement<T> operator*(
+    double scalar, const CartesianDisplacement<T> &rhs)
+{
+  return rhs * scalar;
+}
+
+template<typename T>
+constexpr CartesianDisplacement<T> operator/(
+    const CartesianDisplacement<T> &lhs, double scalar)
+{
+  return CartesianDisplacement<T>(
+      lhs.x() / scalar, lhs.y() / scalar, lhs.z() / scalar);
+}
+
+template<typename T>
+constexpr CartesianDisplacement<T> operator-(
+    const CartesianPosition<T> &lhs, const CartesianPosition<T> &rhs)
+{
+  return CartesianDisplacement<T>(
+      lhs.x() - rhs.x(), lhs.y() - rhs.y(), lhs.z() - rhs.z());
+}
+
+template<typename T>
+constexpr CartesianPosition<T> operator+(
+    const CartesianPosition<T> &lhs, const CartesianDisplacement<T> &rhs)
+{
+  return CartesianPosition<T>(
+      lhs.x() + rhs.x(), lhs.y() + rhs.y(), lhs.z() + rhs.z());
+}
+
+template<typename T>
+constexpr CartesianPosition<T> operator+(
+    const CartesianDisplacement<T> &lhs, const CartesianPosition<T> &rhs)
+{
+  return rhs + lhs;
+}
+
+template<typename T>
+constexpr CartesianPosition<T> operator-(
+    const CartesianPosition<T> &lhs, const CartesianDisplacement<T> &rhs)
+{
+  return CartesianPosition<T>(
+      lhs.x() - rhs.x(), lhs.y() - rhs.y(), lhs.z() - rhs.z());
+}
+
+template<typename T>
+constexpr bool operator==(
+    const CartesianPosition<T> &lhs, const CartesianPosition<T> &rhs)
+{
+  return lhs.x() == rhs.x() && lhs.y() == rhs.y() && lhs.z() == rhs.z();
+}
+
+template<typename T>
+constexpr bool operator!=(
+    const CartesianPosition<T> &lhs, const CartesianPosition<T> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+template<typename T>
+constexpr bool operator==(
+    const CartesianDisplacement<T> &lhs, const CartesianDisplacement<T> &rhs)
+{
+  return lhs.x() == rhs.x() && lhs.y() == rhs.y() && lhs.z() == rhs.z();
+}
+
+template<typename T>
+constexpr bool operator!=(
+    const CartesianDisplacement<T> &lhs, const CartesianDisplacement<T> &rhs)
+{
+  return !(lhs == rhs);
+}
+
+/**
+ * The transform from one tagged Cartesian frame to another, composed
+ * once from the frames' current versions. Applying it gives the same
+ * result as transforming the dynamic types hop by hop.
+ **/
+template<typename FromTag, typename ToTag>
+class CartesianTransform
+{
+public:
+  /**
+   * Composes the transform between FromTag::frame() and ToTag::frame()
+   *
+   * @throws unrelated_frames if the frames are not connected through
+   *   Cartesian frames only
+   **/
+  CartesianTransform()
+  {
+    impl::ChainTransform chain;
+    if (!impl::compose_chain(FromTag::frame(), ToTag::frame(), chain))
+      throw unrelated_frames(FromTag::frame(), ToTag::frame());
+    linear_ = chain.linear;
+  }
+
+  CartesianPosition<ToTag> operator()(
+      const CartesianPosition<FromTag> &in) const
+  {
+    double x = in.x(), y = in.y(), z = in.z();
+    linear_.apply(x, y, z, true);
+    return CartesianPosition<ToTag>(x, y, z);
+  }
+
+  CartesianDisplacement<ToTag> operator()(
+      const CartesianDisplacement<FromTag> &in) const
+  {
+    double x = in.x(), y = in.y(), z = in.z();
+    linear_.apply(x, y, z, false);
+    return CartesianDisplacement<ToTag>(x, y, z);
+  }
+
+  /// The composed transform, e.g., for RigidTransform::apply on arrays
+  const RigidTransform &linear() const { return linear_; }
+
+private:
+  RigidTransform linear_;
+};
+
+} }
+
+#endif
@@ -251,6 +251,60 @@ class GeodeticConverter
     ecef2Geodetic(x, y, z, latitude, longitude, altitude);
   }
 
+  void geodetic2NedBatch(double* x, double* y, double* z,
+                         const size_t count) const
+  {
+    // In place: latitude/longitude/altitude arrays become north/east/down.
+    // The ECEF to NED rotation runs as a separate pass over the arrays.
+    for (size_t i = 0; i < count; ++i)
+    {
+      geodetic2Ecef(x[i], y[i], z[i], &x[i], &y[i], &z[i]);
+    }
+
+    const Matrix3 &m = ecef_to_ned_matrix_;
+    const double m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+    const double m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+    const double m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+    const double ex = initial_ecef_x_;
+    const double ey = initial_ecef_y_;
+    const double ez = initial_ecef_z_;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double dx = x[i] - ex, dy = y[i] - ey, dz = z[i] - ez;
+      x[i] = m00 * dx + m01 * dy + m02 * dz;
+      y[i] = m10 * dx + m11 * dy + m12 * dz;
+      z[i] = -(m20 * dx + m21 * dy + m22 * dz);
+    }
+  }
+
+  void ned2GeodeticBatch(double* x, double* y, double* z,
+                         const size_t count) const
+  {
+    // In place: north/east/down arrays become latitude/longitude/altitude.
+    // The NED to ECEF rotation runs as a separate pass over the arrays.
+    const Matrix3 &m = ned_to_ecef_matrix_;
+    const double m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+    const double m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+    const double m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+    const double ex = initial_ecef_x_;
+    const double ey = initial_ecef_y_;
+    const double ez = initial_ecef_z_;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double n = x[i], e = y[i], u = -z[i];
+      x[i] = m00 * n + m01 * e + m02 * u + ex;
+      y[i] = m10 * n + m11 * e + m12 * u + ey;
+      z[i] = m20 * n + m21 * e + m22 * u + ez;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      ecef2Geodetic(x[i], y[i], z[i], &x[i], &y[i], &z[i]);
+    }
+  }
+
  private:
   inline static Matrix3 nRe(const double lat_radians,
                                     const double lon_radians)
@@ -102,32 +102,58 @@ void print_usage (char * prog_name)
 "     Loop controller setup for gams\n" \
 " [-A |--algorithm type]        algorithm to start with\n" \
 " [-a |--accent type]           accent algorithm to start with\n" \
+" [--accent-threads threads]    worker threads for running accents that\n" \
+"                               declare independent access sets concurrently\n" \
+" [--algorithm-cache size]      number of commanded algorithms to keep for\n" \
+"                               reuse by repeated commands\n" \
 " [-b |--broadcast ip:port]     the broadcast ip to send and listen to\n" \
 " [--checkpoint-on-loop]        save checkpoint after each control loop\n" \
 " [--checkpoint-on-send]        save checkpoint before send of updates\n" \
 " [--checkpoint-diffs]          save checkpoint diffs instead of full saves\n" \
 " [--checkpoint-single-file]    save checkpoints to a single file\n" \
+" [--checkpoint-async]          save checkpoints on a background thread\n" \
 " [-c |--checkpoint prefix]     the filename prefix for checkpointing\n" \
 " [-d |--domain domain]         the knowledge domain to send and listen to\n" \
 " [-e |--rebroadcasts num]      number of hops for rebroadcasting messages\n" \
 " [-f |--logfile file]          log to a file\n" \
 " [-i |--id id]                 the id of this agent (should be non-negative)\n" \
+" [--lazy-agents]               bind swarm agent variables only when used\n" \
 " [--madara-level level]        the MADARA logger level (0+, higher is higher detail)\n" \
 " [--gams-level level]          the GAMS logger level (0+, higher is higher detail)\n" \
 " [-L |--loop-time time]        time to execute loop\n"\
 " [--loop-hertz hz]             hertz to run the MAPE loop\n"\
+" [--loop-cpu cpu]              pin the MAPE loop thread to a cpu\n"\
+" [--loop-priority priority]    real-time (SCHED_FIFO) priority of the loop\n"\
+" [--scheduler skip|catch-up]   keep a fixed release grid, skipping or\n"\
+"                               catching up on missed loop releases\n"\
+" [--hard-deadlines]            defer sends and checkpoints of late loops\n"\
+" [--adaptive-send]             reduce the send rate while loops overrun\n"\
+" [--max-catch-up num]          max late loops to run with catch-up\n"\
 " [-m |--multicast ip:port]     the multicast ip to send and listen to\n" \
 " [-M |--madara-file <file>]    file containing madara commands to execute\n" \
 "                               multiple space-delimited files can be used\n" \
 " [-n |--num_agents <number>]   the number of agents in the swarm\n" \
 " [-o |--host hostname]         the hostname of this process (def:localhost)\n" \
+" [--packed-status]             publish status flags as one packed record.\n" \
+"                               Remote readers of single flags must unpack it\n" \
 " [-p |--platform type]         platform for loop (vrep, dronerk)\n" \
 " [-P |--period period]         time, in seconds, between control loop executions\n" \
 " [-q |--queue-length length]   length of transport queue in bytes\n" \
 " [-r |--reduced]               use the reduced message header\n" \
 " [-s |--send-hertz hertz]      send hertz rate for modifications\n" \
+" [--sense-hertz hertz]         sense the platform on its own thread at hertz\n" \
+" [--stats-hertz hertz]         publish MAPE phase latencies to .gams.stats.*\n" \
+" [--stats-file prefix]         append MAPE phase latencies to prefix_agent.csv\n" \
+" [--stats-json]                write the stats file as JSON Lines\n" \
+" [--trajectory-length num]     locations to keep per agent for prediction\n" \
 " [-t |--target path]           file system location to save received files (NYI)\n" \
+" [--trigger variable]          variable that wakes the loop when updated.\n" \
+"                               May be repeated. Implies --wait-for-triggers\n" \
+" [--max-trigger-wait time]     max seconds to wait for a trigger\n" \
+" [--wait-for-triggers]         run the loop when commands or peer locations\n" \
+"                               change rather than at a fixed rate\n" \
 " [-u |--udp ip:port]           a udp ip to send to (first is self to bind to)\n" \
+" [--virtual-time]              step the loop on simulated time without sleeping\n" \
 " [--zmq proto:ip:port]         specifies a 0MQ transport endpoint\n"
 "\n",
         prog_name);
@@ -159,6 +185,18 @@ void handle_arguments (int argc, char ** argv)
 
       ++i;
     }
+    else if (arg1 == "--accent-threads")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.accent_threads;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
     else if (arg1 == "-b" || arg1 == "--broadcast")
     {
       if (i + 1 < argc && argv[i + 1][0] != '-')
@@ -202,6 +240,11 @@ void handle_arguments (int argc, char ** argv)
       controller_settings.checkpoint_strategy |=
         gams::controllers::CHECKPOINT_SAVE_ONE_FILE;
     }
+    else if (arg1 == "--checkpoint-async")
+    {
+      controller_settings.checkpoint_strategy |=
+        gams::controllers::CHECKPOINT_ASYNC;
+    }
     else if (arg1 == "-d" || arg1 == "--domain")
     {
       if (i + 1 < argc && argv[i + 1][0] != '-')
@@ -406,6 +449,166 @@ void handle_arguments (int argc, char ** argv)
 
       ++i;
     }
+    else if (arg1 == "--algorithm-cache")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.algorithm_cache_size;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--trigger")
+    {
+      if (i + 1 < argc && argv[i + 1][0] != '-')
+      {
+        controller_settings.trigger_variables.push_back (argv[i + 1]);
+        controller_settings.wait_for_triggers = true;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--max-trigger-wait")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.max_trigger_wait;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--wait-for-triggers")
+    {
+      controller_settings.wait_for_triggers = true;
+    }
+    else if (arg1 == "--lazy-agents")
+    {
+      controller_settings.lazy_agents = true;
+    }
+    else if (arg1 == "--packed-status")
+    {
+      controller_settings.packed_status = true;
+    }
+    else if (arg1 == "--virtual-time")
+    {
+      controller_settings.virtual_time = true;
+    }
+    else if (arg1 == "--loop-cpu")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.loop_cpu;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--loop-priority")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.loop_priority;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--scheduler")
+    {
+      if (i + 1 < argc && std::string (argv[i + 1]) == "skip")
+        controller_settings.scheduler_policy =
+          gams::controllers::SCHEDULE_SKIP;
+      else if (i + 1 < argc && std::string (argv[i + 1]) == "catch-up")
+        controller_settings.scheduler_policy =
+          gams::controllers::SCHEDULE_CATCH_UP;
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--hard-deadlines")
+    {
+      controller_settings.deadline_policy =
+        gams::controllers::DEADLINE_HARD;
+    }
+    else if (arg1 == "--adaptive-send")
+    {
+      controller_settings.adaptive_send = true;
+    }
+    else if (arg1 == "--max-catch-up")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.max_catch_up;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--sense-hertz")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.sense_hertz;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--trajectory-length")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.trajectory_length;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--stats-hertz")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> controller_settings.stats_hertz;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--stats-file")
+    {
+      if (i + 1 < argc && argv[i + 1][0] != '-')
+        controller_settings.stats_file_prefix = argv[i + 1];
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "--stats-json")
+    {
+      controller_settings.stats_file_format =
+        gams::controllers::STATS_FORMAT_JSON;
+    }
     else if (arg1 == "-t" || arg1 == "--target")
     {
       if (i + 1 < argc && argv[i + 1][0] != '-')
@@ -0,0 +1,319 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file ModelsOfComputation.cpp
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the virtual clock and synchronous rounds definitions
+ **/
+
+#include "ModelsOfComputation.h"
+
+#include <atomic>
+
+#include "gams/controllers/BaseController.h"
+#include "gams/controllers/Multicontroller.h"
+#include "gams/loggers/GlobalLogger.h"
+
+namespace
+{
+  /// true if the virtual clock is running on simulated time
+  std::atomic<bool> virtual_enabled (false);
+
+  /// the simulated time, in nanoseconds
+  std::atomic<int64_t> virtual_nanoseconds (0);
+
+  int64_t steady_nanoseconds (void)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds> (
+      std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+  }
+}
+
+gams::time::VirtualClock::time_point
+gams::time::VirtualClock::now (void)
+{
+  if (virtual_enabled.load (std::memory_order_acquire))
+  {
+    return time_point (duration (
+      virtual_nanoseconds.load (std::memory_order_acquire)));
+  }
+
+  return time_point (duration (steady_nanoseconds ()));
+}
+
+void
+gams::time::VirtualClock::enable (void)
+{
+  if (!virtual_enabled.load (std::memory_order_acquire))
+  {
+    virtual_nanoseconds.store (steady_nanoseconds (),
+      std::memory_order_release);
+    virtual_enabled.store (true, std::memory_order_release);
+  }
+}
+
+void
+gams::time::VirtualClock::enable (double start)
+{
+  virtual_nanoseconds.store ((int64_t)(start * 1000000000.0),
+    std::memory_order_release);
+  virtual_enabled.store (true, std::memory_order_release);
+}
+
+void
+gams::time::VirtualClock::disable (void)
+{
+  virtual_enabled.store (false, std::memory_order_release);
+}
+
+bool
+gams::time::VirtualClock::is_enabled (void)
+{
+  return virtual_enabled.load (std::memory_order_acquire);
+}
+
+void
+gams::time::VirtualClock::advance (double seconds)
+{
+  if (seconds > 0 && virtual_enabled.load (std::memory_order_acquire))
+  {
+    virtual_nanoseconds.fetch_add ((int64_t)(seconds * 1000000000.0),
+      std::memory_order_acq_rel);
+  }
+}
+
+double
+gams::time::VirtualClock::seconds (void)
+{
+  return std::chrono::duration<double> (
+    now ().time_since_epoch ()).count ();
+}
+
+gams::time::SynchronousRounds::SynchronousRounds (double round_period,
+  double send_period)
+  : round_period_ (round_period), send_period_ (send_period), rounds_ (0)
+{
+}
+
+void
+gams::time::SynchronousRounds::add (controllers::BaseController * controller)
+{
+  if (controller)
+  {
+    Participant participant = { controller, 0, false, 0.0 };
+    controllers_.push_back (participant);
+  }
+}
+
+void
+gams::time::SynchronousRounds::add (
+  controllers::Multicontroller * controller)
+{
+  if (controller)
+  {
+    Participant participant = { 0, controller, false, 0.0 };
+    controllers_.push_back (participant);
+  }
+}
+
+void
+gams::time::SynchronousRounds::clear (void)
+{
+  controllers_.clear ();
+}
+
+size_t
+gams::time::SynchronousRounds::size (void) const
+{
+  return controllers_.size ();
+}
+
+void
+gams::time::SynchronousRounds::set_round_period (double round_period)
+{
+  round_period_ = round_period;
+}
+
+double
+gams::time::SynchronousRounds::get_round_period (void) const
+{
+  return round_period_;
+}
+
+void
+gams::time::SynchronousRounds::set_send_period (double send_period)
+{
+  send_period_ = send_period;
+}
+
+double
+gams::time::SynchronousRounds::get_send_period (void) const
+{
+  return send_period_;
+}
+
+madara::knowledge::KnowledgeRecord::Integer
+gams::time::SynchronousRounds::get_rounds (void) const
+{
+  return rounds_;
+}
+
+bool
+gams::time::SynchronousRounds::send_due_ (Participant & participant,
+  double now)
+{
+  // every participant sends in its first round
+  if (participant.sent && send_period_ > 0 && now < participant.next_send)
+  {
+    return false;
+  }
+
+  if (!participant.sent || send_period_ <= 0)
+  {
+    participant.next_send = now;
+  }
+
+  while (send_period_ > 0 && participant.next_send <= now)
+  {
+    participant.next_send += send_period_;
+  }
+
+  participant.sent = true;
+
+  return true;
+}
+
+int
+gams::time::SynchronousRounds::run_round (void)
+{
+  int result (0);
+  const double now (VirtualClock::seconds ());
+
+  for (size_t i = 0; i < controllers_.size (); ++i)
+  {
+    Participant & participant = controllers_[i];
+
+    if (participant.controller)
+    {
+      controllers::BaseController * controller = participant.controller;
+      const int strategy = controller->settings_.checkpoint_strategy;
+
+      result |= controller->run_cycle_ ();
+
+      if (controllers::CHECKPOINT_EVERY_LOOP & strategy)
+      {
+        controller->save_checkpoint ();
+      }
+
+      if (send_due_ (participant, now))
+      {
+        if (controllers::CHECKPOINT_EVERY_SEND & strategy)
+        {
+          controller->save_checkpoint ();
+        }
+
+        controller->send_modifieds_ ();
+      }
+    }
+    else
+    {
+      controllers::Multicontroller * controller = participant.multicontroller;
+
+      for (size_t j = 0; j < controller->controllers_.size (); ++j)
+      {
+        result |= controller->run_agent_ (j, true);
+      }
+
+      if (send_due_ (participant, now))
+      {
+        controller->send_modifieds_ ();
+      }
+    }
+  }
+
+  VirtualClock::advance (round_period_);
+  ++rounds_;
+
+  return result;
+}
+
+int
+gams::time::SynchronousRounds::run (double max_runtime,
+  madara::knowledge::KnowledgeRecord::Integer max_rounds)
+{
+  int result (0);
+
+  VirtualClock::enable ();
+
+  const double start (VirtualClock::seconds ());
+  const madara::knowledge::KnowledgeRecord::Integer first_round (rounds_);
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::time::SynchronousRounds::run:" \
+    " stepping %d controllers with round period %fs, send period %fs,"
+    " max_runtime: %fs\n",
+    (int)controllers_.size (), round_period_, send_period_, max_runtime);
+
+  // run always executes at least one round
+  do
+  {
+    result = run_round ();
+  }
+  while ((max_runtime < 0 ||
+      VirtualClock::seconds () - start < max_runtime) &&
+    (max_rounds < 0 || rounds_ - first_round < max_rounds));
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::time::SynchronousRounds::run:" \
+    " finished %d rounds at virtual time %fs\n",
+    (int)(rounds_ - first_round), VirtualClock::seconds ());
+
+  return result;
+}
@@ -0,0 +1,290 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file ModelsOfComputation.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a virtual clock and a synchronous rounds model of
+ * computation for stepping controllers in lockstep on simulated time
+ **/
+
+#ifndef  _GAMS_TIME_MODELSOFCOMPUTATION_H_
+#define  _GAMS_TIME_MODELSOFCOMPUTATION_H_
+
+#include <chrono>
+#include <vector>
+
+#include "gams/GamsExport.h"
+#include "madara/knowledge/KnowledgeRecord.h"
+#include "madara/utility/EpochEnforcer.h"
+
+namespace gams
+{
+  namespace controllers
+  {
+    class BaseController;
+    class Multicontroller;
+  }
+
+  namespace time
+  {
+    /**
+     * A steady clock that can be switched from wall-clock time to a
+     * simulated time that only moves when it is advanced. The clock meets
+     * the std::chrono clock requirements, so it can parameterize
+     * madara::utility::EpochEnforcer and std::this_thread::sleep_until.
+     *
+     * When enabled, the virtual time starts at the current steady clock
+     * time unless a start time is provided, so timers that were started
+     * before the switch remain consistent.
+     **/
+    class GAMS_EXPORT VirtualClock
+    {
+    public:
+      /// the tick type of the clock
+      typedef std::chrono::nanoseconds duration;
+
+      /// the representation of a tick
+      typedef duration::rep rep;
+
+      /// the ratio of a tick to a second
+      typedef duration::period period;
+
+      /// a point in time on the clock
+      typedef std::chrono::time_point <VirtualClock> time_point;
+
+      /// the virtual clock never moves backwards
+      static const bool is_steady = true;
+
+      /**
+       * Returns the current time. If the virtual clock is disabled, this
+       * is the steady clock time.
+       * @return  the current time
+       **/
+      static time_point now (void);
+
+      /**
+       * Switches the clock to virtual time at the current steady clock time
+       **/
+      static void enable (void);
+
+      /**
+       * Switches the clock to virtual time at a specific time
+       * @param  start   the virtual time, in seconds, to start at
+       **/
+      static void enable (double start);
+
+      /**
+       * Switches the clock back to the steady clock
+       **/
+      static void disable (void);
+
+      /**
+       * Checks if the clock is running on virtual time
+       * @return  true if virtual time is enabled
+       **/
+      static bool is_enabled (void);
+
+      /**
+       * Moves virtual time forward. Has no effect if the clock is disabled.
+       * @param  seconds   the time to advance, in seconds
+       **/
+      static void advance (double seconds);
+
+      /**
+       * Returns the current time in seconds since the clock's epoch
+       * @return  the current time, in seconds
+       **/
+      static double seconds (void);
+    };
+
+    /// an epoch enforcer that follows the virtual clock when it is enabled
+    typedef madara::utility::EpochEnforcer <VirtualClock> EpochEnforcer;
+
+    /**
+     * A synchronous rounds model of computation. Each round, every
+     * controller runs one MAPE cycle in the order the controllers were
+     * added, and then the virtual clock advances by the round period.
+     * No round sleeps, so simulations run as fast as the controllers can
+     * compute, and the interleaving of agents is deterministic.
+     *
+     * Controllers send their modifications and save checkpoints as they
+     * would in real time: every round if the send period is not positive,
+     * and otherwise only in rounds where the send period has elapsed in
+     * virtual time. A Multicontroller runs a cycle of each hosted agent
+     * per round and sends once for all of them.
+     **/
+    class GAMS_EXPORT SynchronousRounds
+    {
+    public:
+      /**
+       * Constructor
+       * @param  round_period  the virtual time, in seconds, of a round
+       * @param  send_period   the virtual time, in seconds, between sends.
+       *                       Non-positive values send every round.
+       **/
+      SynchronousRounds (double round_period = 1.0,
+        double send_period = -1);
+
+      /**
+       * Adds a controller to the end of the round order. The controller
+       * is not managed by this class.
+       * @param  controller   the controller to step
+       **/
+      void add (controllers::BaseController * controller);
+
+      /**
+       * Adds all agents of a multicontroller to the end of the round
+       * order. The multicontroller is not managed by this class.
+       * @param  controller   the multicontroller to step
+       **/
+      void add (controllers::Multicontroller * controller);
+
+      /**
+       * Removes all controllers
+       **/
+      void clear (void);
+
+      /**
+       * Returns the number of controllers
+       * @return  the number of controllers stepped each round
+       **/
+      size_t size (void) const;
+
+      /**
+       * Sets the virtual time of a round
+       * @param  round_period  the time, in seconds, of a round
+       **/
+      void set_round_period (double round_period);
+
+      /**
+       * Returns the virtual time of a round
+       * @return  the time, in seconds, of a round
+       **/
+      double get_round_period (void) const;
+
+      /**
+       * Sets the virtual time between sends
+       * @param  send_period  the time, in seconds, between sends.
+       *                      Non-positive values send every round.
+       **/
+      void set_send_period (double send_period);
+
+      /**
+       * Returns the virtual time between sends
+       * @return  the time, in seconds, between sends
+       **/
+      double get_send_period (void) const;
+
+      /**
+       * Returns the number of rounds that have completed
+       * @return  the number of completed rounds
+       **/
+      madara::knowledge::KnowledgeRecord::Integer get_rounds (void) const;
+
+      /**
+       * Runs a single round and advances the virtual clock
+       * @return  the combined result of the controllers' MAPE cycles
+       **/
+      int run_round (void);
+
+      /**
+       * Runs rounds until a limit is reached. Enables the virtual clock
+       * if it is not already enabled.
+       * @param  max_runtime  the maximum virtual time, in seconds, to run.
+       *                      Negative values are unlimited.
+       * @param  max_rounds   the maximum number of rounds to run.
+       *                      Negative values are unlimited.
+       * @return  the result of the last round
+       **/
+      int run (double max_runtime = -1,
+        madara::knowledge::KnowledgeRecord::Integer max_rounds = -1);
+
+    protected:
+      /**
+       * A controller or multicontroller stepped each round
+       **/
+      struct Participant
+      {
+        /// the controller, if this is a single agent
+        controllers::BaseController * controller;
+
+        /// the multicontroller, if this is a group of hosted agents
+        controllers::Multicontroller * multicontroller;
+
+        /// true once the participant has sent
+        bool sent;
+
+        /// the virtual time, in seconds, of the next send
+        double next_send;
+      };
+
+      /**
+       * Checks if a participant should send this round and schedules its
+       * next send
+       * @param  participant  the participant to check
+       * @param  now          the virtual time of the round, in seconds
+       * @return  true if the participant should send
+       **/
+      bool send_due_ (Participant & participant, double now);
+
+      /// controllers in the order they are stepped
+      std::vector <Participant> controllers_;
+
+      /// the virtual time of a round, in seconds
+      double round_period_;
+
+      /// the virtual time between sends, in seconds
+      double send_period_;
+
+      /// the number of completed rounds
+      madara::knowledge::KnowledgeRecord::Integer rounds_;
+    };
+  }
+}
+
+#endif // _GAMS_TIME_MODELSOFCOMPUTATION_H_
@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+#include "LatencyHistogram.h"
+
+gams::utility::LatencyHistogram::LatencyHistogram ()
+  : max_ (0)
+{
+  for (unsigned int i = 0; i < NUM_BUCKETS; ++i)
+  {
+    buckets_[i].store (0, std::memory_order_relaxed);
+  }
+}
+
+unsigned int
+gams::utility::LatencyHistogram::bucket (uint64_t nanoseconds)
+{
+  if (nanoseconds < SUB_BUCKETS)
+  {
+    return (unsigned int)nanoseconds;
+  }
+
+  // find the most significant bit
+  unsigned int msb = 0;
+  for (uint64_t value = nanoseconds >> 1; value; value >>= 1)
+  {
+    ++msb;
+  }
+
+  // the bits just below the most significant bit select the sub-bucket
+  unsigned int shift = msb - SUB_BUCKET_BITS;
+  unsigned int sub = (unsigned int)(nanoseconds >> shift) - SUB_BUCKETS;
+
+  return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+}
+
+uint64_t
+gams::utility::LatencyHistogram::upper_bound (unsigned int index)
+{
+  if (index < SUB_BUCKETS)
+  {
+    return index;
+  }
+
+  unsigned int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+  uint64_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+
+  return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void
+gams::utility::LatencyHistogram::record (uint64_t nanoseconds)
+{
+  buckets_[bucket (nanoseconds)].fetch_add (1, std::memory_order_relaxed);
+
+  uint64_t current = max_.load (std::memory_order_relaxed);
+  while (nanoseconds > current &&
+    !max_.compare_exchange_weak (current, nanoseconds,
+      std::memory_order_relaxed))
+  {
+  }
+}
+
+gams::utility::LatencyHistogram::Summary
+gams::utility::LatencyHistogram::take (void)
+{
+  Summary result;
+  result.count = 0;
+  result.p50 = 0;
+  result.p99 = 0;
+  result.max = 0;
+
+  uint64_t counts[NUM_BUCKETS];
+
+  for (unsigned int i = 0; i < NUM_BUCKETS; ++i)
+  {
+    counts[i] = buckets_[i].exchange (0, std::memory_order_relaxed);
+    result.count += counts[i];
+  }
+
+  uint64_t max = max_.exchange (0, std::memory_order_relaxed);
+
+  if (result.count > 0)
+  {
+    // ranks of the percentiles, rounded up
+    uint64_t p50_rank = (result.count * 50 + 99) / 100;
+    uint64_t p99_rank = (result.count * 99 + 99) / 100;
+    uint64_t seen = 0;
+    bool p50_found = false;
+
+    for (unsigned int i = 0; i < NUM_BUCKETS; ++i)
+    {
+      seen += counts[i];
+
+      if (!p50_found && seen >= p50_rank)
+      {
+        result.p50 = upper_bound (i) / 1000000000.0;
+        p50_found = true;
+      }
+
+      if (seen >= p99_rank)
+      {
+        result.p99 = upper_bound (i) / 1000000000.0;
+        break;
+      }
+    }
+
+    result.max = max / 1000000000.0;
+
+    // bucket bounds may overshoot the exact maximum
+    if (result.p50 > result.max)
+    {
+      result.p50 = result.max;
+    }
+    if (result.p99 > result.max)
+    {
+      result.p99 = result.max;
+    }
+  }
+
+  return result;
+}
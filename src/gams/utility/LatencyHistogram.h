@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file LatencyHistogram.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a lock-free histogram for recording latencies
+ **/
+
+#ifndef  _GAMS_UTILITY_LATENCYHISTOGRAM_H_
+#define  _GAMS_UTILITY_LATENCYHISTOGRAM_H_
+
+#include "gams/GamsExport.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+namespace gams
+{
+  namespace utility
+  {
+    /**
+     * A log-linear histogram of latencies in nanoseconds. Each power of
+     * two is split into 8 sub-buckets, so reported percentiles are within
+     * 12.5% of the recorded values. Recording is wait-free (relaxed atomic
+     * increments), so a publisher can take a window of results while the
+     * recording thread keeps running.
+     **/
+    class GAMS_EXPORT LatencyHistogram
+    {
+    public:
+      /**
+       * Summary of a window of recorded latencies
+       **/
+      struct Summary
+      {
+        /// number of recorded latencies
+        uint64_t count;
+
+        /// median latency in seconds
+        double p50;
+
+        /// 99th percentile latency in seconds
+        double p99;
+
+        /// maximum latency in seconds
+        double max;
+      };
+
+      /**
+       * Constructor
+       **/
+      LatencyHistogram ();
+
+      /**
+       * Records a latency
+       * @param  nanoseconds   the latency to record
+       **/
+      void record (uint64_t nanoseconds);
+
+      /**
+       * Summarizes all latencies recorded since the last call and resets
+       * the histogram for the next window
+       * @return  the summary of the window
+       **/
+      Summary take (void);
+
+    private:
+
+      /// log2 of the number of sub-buckets per power of two
+      static const unsigned int SUB_BUCKET_BITS = 3;
+
+      /// number of sub-buckets per power of two
+      static const unsigned int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+      /// total number of buckets needed for 64 bit values
+      static const unsigned int NUM_BUCKETS =
+        SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+      /**
+       * Returns the bucket that a latency is counted in
+       * @param  nanoseconds   the latency
+       * @return the bucket index
+       **/
+      static unsigned int bucket (uint64_t nanoseconds);
+
+      /**
+       * Returns the largest latency counted in a bucket
+       * @param  index   the bucket index
+       * @return the upper bound of the bucket in nanoseconds
+       **/
+      static uint64_t upper_bound (unsigned int index);
+
+      /// counts for each bucket
+      std::atomic <uint64_t> buckets_[NUM_BUCKETS];
+
+      /// the exact maximum latency in the window
+      std::atomic <uint64_t> max_;
+    };
+  }
+}
+
+#endif // _GAMS_UTILITY_LATENCYHISTOGRAM_H_
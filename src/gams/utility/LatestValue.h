@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file LatestValue.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a lock-free single-slot handoff of the latest value
+ * from a producer thread to a consumer thread
+ **/
+
+#ifndef  _GAMS_UTILITY_LATESTVALUE_H_
+#define  _GAMS_UTILITY_LATESTVALUE_H_
+
+#include <atomic>
+
+namespace gams
+{
+  namespace utility
+  {
+    /**
+     * A single-producer, single-consumer slot that always holds the most
+     * recently written value. Implemented as a triple buffer: the producer
+     * and the consumer each own a buffer, and a third buffer is exchanged
+     * between them with a single atomic operation. Neither side ever
+     * blocks, and intermediate values the consumer did not read are
+     * overwritten.
+     **/
+    template <typename T>
+    class LatestValue
+    {
+    public:
+      /**
+       * Constructor
+       **/
+      LatestValue ()
+        : back_ (0), middle_ (1), front_ (2)
+      {
+      }
+
+      /**
+       * Publishes a value. Must only be called by the producer thread.
+       * @param  value   the value to publish
+       **/
+      void write (const T & value)
+      {
+        buffers_[back_] = value;
+
+        unsigned int previous = middle_.exchange (
+          back_ | FRESH, std::memory_order_acq_rel);
+
+        back_ = previous & INDEX;
+      }
+
+      /**
+       * Reads the latest value if one was published since the last read.
+       * Must only be called by the consumer thread.
+       * @param  value   filled with the latest value
+       * @return true if a new value was read, false if value is unchanged
+       **/
+      bool read (T & value)
+      {
+        if (!(middle_.load (std::memory_order_relaxed) & FRESH))
+        {
+          return false;
+        }
+
+        unsigned int previous = middle_.exchange (
+          front_, std::memory_order_acq_rel);
+
+        front_ = previous & INDEX;
+        value = buffers_[front_];
+
+        return true;
+      }
+
+    private:
+      /// mask of the buffer index in middle_
+      static const unsigned int INDEX = 3;
+
+      /// flag set in middle_ when it holds an unread value
+      static const unsigned int FRESH = 4;
+
+      /// the three buffers
+      T buffers_[3];
+
+      /// the buffer owned by the producer
+      unsigned int back_;
+
+      /// the buffer being handed off, plus the FRESH flag
+      std::atomic <unsigned int> middle_;
+
+      /// the buffer owned by the consumer
+      unsigned int front_;
+    };
+  }
+}
+
+#endif // _GAMS_UTILITY_LATESTVALUE_H_
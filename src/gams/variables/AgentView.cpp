@@ -0,0 +1,415 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+#include "AgentView.h"
+#include "gams/loggers/GlobalLogger.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+  // bound_ bit of each container, in accessor order
+  enum Fields
+  {
+    FIELD_ACCENTS,
+    FIELD_ACCELERATION,
+    FIELD_ALGORITHM,
+    FIELD_ALGORITHM_ACCEPTS,
+    FIELD_ALGORITHM_ARGS,
+    FIELD_ALGORITHM_CHANGED,
+    FIELD_ALGORITHM_ID,
+    FIELD_ALGORITHM_REJECTS,
+    FIELD_BATTERY_REMAINING,
+    FIELD_BRIDGE_ID,
+    FIELD_COVERAGE_TYPE,
+    FIELD_DESIRED_ALTITUDE,
+    FIELD_DEST,
+    FIELD_DEST_ORIENTATION,
+    FIELD_GAMS_DEBUG_LEVEL,
+    FIELD_HOME,
+    FIELD_IS_MOBILE,
+    FIELD_LAST_ALGORITHM,
+    FIELD_LAST_ALGORITHM_ARGS,
+    FIELD_LAST_ALGORITHM_ID,
+    FIELD_LOCATION,
+    FIELD_LOOP_HZ,
+    FIELD_MADARA_DEBUG_LEVEL,
+    FIELD_MIN_ALT,
+    FIELD_NEXT_COVERAGE_TYPE,
+    FIELD_ORIENTATION,
+    FIELD_SEARCH_AREA_ID,
+    FIELD_SEND_HZ,
+    FIELD_SOURCE,
+    FIELD_SOURCE_ORIENTATION,
+    FIELD_TEMPERATURE,
+    FIELD_VELOCITY,
+    NUM_FIELDS
+  };
+}
+
+gams::variables::AgentView::AgentView ()
+  : knowledge_ (0), bound_ (0)
+{
+}
+
+void
+gams::variables::AgentView::init_vars (
+  madara::knowledge::KnowledgeBase & knowledge,
+  const std::string & prefix)
+{
+  knowledge_ = &knowledge;
+  prefix_ = prefix;
+  bound_ = 0;
+  agent_ = Agent ();
+  agent_.prefix = prefix;
+}
+
+void
+gams::variables::AgentView::init_vars (
+  madara::knowledge::KnowledgeBase & knowledge,
+  const madara::knowledge::KnowledgeRecord::Integer& id)
+{
+  std::stringstream buffer;
+  buffer << "agent." << id;
+
+  init_vars (knowledge, buffer.str ());
+}
+
+gams::variables::Agent &
+gams::variables::AgentView::agent (void)
+{
+  if (bound_ != (1ULL << NUM_FIELDS) - 1 && knowledge_ != 0)
+  {
+    agent_.init_vars (*knowledge_, prefix_);
+    bound_ = (1ULL << NUM_FIELDS) - 1;
+  }
+
+  return agent_;
+}
+
+const std::string &
+gams::variables::AgentView::get_prefix (void) const
+{
+  return prefix_;
+}
+
+size_t
+gams::variables::AgentView::get_num_bound (void) const
+{
+  size_t result = 0;
+  for (uint64_t bits = bound_; bits; bits &= bits - 1)
+    ++result;
+  return result;
+}
+
+template <typename T>
+T &
+gams::variables::AgentView::bind (T & container, int field,
+  const char * suffix, bool local)
+{
+  if (!(bound_ & (1ULL << field)) && knowledge_ != 0)
+  {
+    container.set_name (prefix_ + suffix, *knowledge_);
+
+    if (local)
+    {
+      container.set_settings (
+        madara::knowledge::KnowledgeUpdateSettings (true));
+    }
+
+    bound_ |= 1ULL << field;
+  }
+
+  return container;
+}
+
+gams::variables::AccentStatuses &
+gams::variables::AgentView::accents (void)
+{
+  if (!(bound_ & (1ULL << FIELD_ACCENTS)) && knowledge_ != 0)
+  {
+    variables::init_vars (agent_.accents, *knowledge_, prefix_);
+    bound_ |= 1ULL << FIELD_ACCENTS;
+  }
+
+  return agent_.accents;
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::acceleration (void)
+{
+  return bind (agent_.acceleration, FIELD_ACCELERATION, ".acceleration");
+}
+
+madara::knowledge::containers::String &
+gams::variables::AgentView::algorithm (void)
+{
+  return bind (agent_.algorithm, FIELD_ALGORITHM, ".algorithm", true);
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::algorithm_accepts (void)
+{
+  return bind (agent_.algorithm_accepts,
+    FIELD_ALGORITHM_ACCEPTS, ".algorithm.accepts");
+}
+
+madara::knowledge::containers::Map &
+gams::variables::AgentView::algorithm_args (void)
+{
+  return bind (agent_.algorithm_args,
+    FIELD_ALGORITHM_ARGS, ".algorithm.args", true);
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::algorithm_changed (void)
+{
+  return bind (agent_.algorithm_changed,
+    FIELD_ALGORITHM_CHANGED, ".algorithm.changed");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::algorithm_id (void)
+{
+  return bind (agent_.algorithm_id, FIELD_ALGORITHM_ID, ".algorithm.id");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::algorithm_rejects (void)
+{
+  return bind (agent_.algorithm_rejects,
+    FIELD_ALGORITHM_REJECTS, ".algorithm.rejects");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::battery_remaining (void)
+{
+  return bind (agent_.battery_remaining, FIELD_BATTERY_REMAINING, ".battery");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::bridge_id (void)
+{
+  return bind (agent_.bridge_id, FIELD_BRIDGE_ID, ".bridge_id");
+}
+
+madara::knowledge::containers::String &
+gams::variables::AgentView::coverage_type (void)
+{
+  return bind (agent_.coverage_type,
+    FIELD_COVERAGE_TYPE, ".area_coverage_type");
+}
+
+madara::knowledge::containers::Double &
+gams::variables::AgentView::desired_altitude (void)
+{
+  return bind (agent_.desired_altitude,
+    FIELD_DESIRED_ALTITUDE, ".desired_altitude");
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::dest (void)
+{
+  return bind (agent_.dest, FIELD_DEST, ".dest");
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::dest_orientation (void)
+{
+  return bind (agent_.dest_orientation,
+    FIELD_DEST_ORIENTATION, ".dest_orientation");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::gams_debug_level (void)
+{
+  return bind (agent_.gams_debug_level,
+    FIELD_GAMS_DEBUG_LEVEL, ".gams_debug_level", true);
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::home (void)
+{
+  return bind (agent_.home, FIELD_HOME, ".home");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::is_mobile (void)
+{
+  return bind (agent_.is_mobile, FIELD_IS_MOBILE, ".mobile");
+}
+
+madara::knowledge::containers::String &
+gams::variables::AgentView::last_algorithm (void)
+{
+  return bind (agent_.last_algorithm, FIELD_LAST_ALGORITHM, ".algorithm.last");
+}
+
+madara::knowledge::containers::Map &
+gams::variables::AgentView::last_algorithm_args (void)
+{
+  return bind (agent_.last_algorithm_args,
+    FIELD_LAST_ALGORITHM_ARGS, ".algorithm.last.args");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::last_algorithm_id (void)
+{
+  return bind (agent_.last_algorithm_id,
+    FIELD_LAST_ALGORITHM_ID, ".algorithm.last.id");
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::location (void)
+{
+  return bind (agent_.location, FIELD_LOCATION, ".location");
+}
+
+madara::knowledge::containers::Double &
+gams::variables::AgentView::loop_hz (void)
+{
+  return bind (agent_.loop_hz, FIELD_LOOP_HZ, ".loop_hz");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::madara_debug_level (void)
+{
+  return bind (agent_.madara_debug_level,
+    FIELD_MADARA_DEBUG_LEVEL, ".madara_debug_level", true);
+}
+
+madara::knowledge::containers::Double &
+gams::variables::AgentView::min_alt (void)
+{
+  return bind (agent_.min_alt, FIELD_MIN_ALT, ".min_alt");
+}
+
+madara::knowledge::containers::String &
+gams::variables::AgentView::next_coverage_type (void)
+{
+  return bind (agent_.next_coverage_type,
+    FIELD_NEXT_COVERAGE_TYPE, ".next_area_coverage_type");
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::orientation (void)
+{
+  return bind (agent_.orientation, FIELD_ORIENTATION, ".orientation");
+}
+
+madara::knowledge::containers::Integer &
+gams::variables::AgentView::search_area_id (void)
+{
+  return bind (agent_.search_area_id, FIELD_SEARCH_AREA_ID, ".search_area_id");
+}
+
+madara::knowledge::containers::Double &
+gams::variables::AgentView::send_hz (void)
+{
+  return bind (agent_.send_hz, FIELD_SEND_HZ, ".send_hz");
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::source (void)
+{
+  return bind (agent_.source, FIELD_SOURCE, ".source");
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::source_orientation (void)
+{
+  return bind (agent_.source_orientation,
+    FIELD_SOURCE_ORIENTATION, ".source_orientation");
+}
+
+madara::knowledge::containers::Double &
+gams::variables::AgentView::temperature (void)
+{
+  return bind (agent_.temperature, FIELD_TEMPERATURE, ".temperature");
+}
+
+madara::knowledge::containers::NativeDoubleArray &
+gams::variables::AgentView::velocity (void)
+{
+  return bind (agent_.velocity, FIELD_VELOCITY, ".velocity");
+}
+
+void gams::variables::init_vars (AgentViews & variables,
+  madara::knowledge::KnowledgeBase & knowledge,
+  const madara::knowledge::KnowledgeRecord::Integer& processes)
+{
+  madara::knowledge::KnowledgeRecord::Integer limit = processes;
+  if (processes >= 0)
+  {
+    variables.resize (processes);
+  }
+  else
+  {
+    limit = knowledge.get ("agent.size").to_integer ();
+    variables.resize (limit);
+  }
+
+  for (unsigned int i = 0; i < limit; ++i)
+  {
+    variables[i].init_vars (knowledge, i);
+  }
+}
+
+void gams::variables::init_vars (AgentViews & variables,
+  madara::knowledge::KnowledgeBase & knowledge,
+  const groups::GroupBase & group)
+{
+  // get the member identifiers
+  groups::AgentVector members;
+  group.get_members (members);
+
+  variables.resize (members.size ());
+
+  for (unsigned int i = 0; i < members.size (); ++i)
+  {
+    variables[i].init_vars (knowledge, members[i]);
+  }
+}
@@ -0,0 +1,268 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file AgentView.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a lazily bound view of agent variables
+ **/
+
+#ifndef   _GAMS_VARIABLES_AGENT_VIEW_H_
+#define   _GAMS_VARIABLES_AGENT_VIEW_H_
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+#include "gams/GamsExport.h"
+#include "madara/knowledge/KnowledgeBase.h"
+#include "Agent.h"
+
+namespace gams
+{
+  namespace variables
+  {
+    /**
+     * A view of an agent's variables that binds each container to the
+     * knowledge base the first time it is accessed. Initializing a view
+     * only stores the agent prefix, so a swarm of views costs no knowledge
+     * base lookups until agent variables are actually used.
+     **/
+    class GAMS_EXPORT AgentView
+    {
+    public:
+      /**
+       * Constructor
+       **/
+      AgentView ();
+
+      /**
+       * Sets the agent that the view refers to. Previously bound
+       * containers are released.
+       * @param   knowledge  the variable context
+       * @param   prefix     the prefix of the agent in the knowledge base
+       **/
+      void init_vars (madara::knowledge::KnowledgeBase & knowledge,
+        const std::string & prefix);
+
+      /**
+       * Sets the agent that the view refers to
+       * @param   knowledge  the variable context
+       * @param   id         node identifier
+       **/
+      void init_vars (madara::knowledge::KnowledgeBase & knowledge,
+        const madara::knowledge::KnowledgeRecord::Integer& id);
+
+      /**
+       * Binds all containers of the agent
+       * @return the fully bound agent
+       **/
+      Agent & agent (void);
+
+      /**
+       * Gets the prefix of the agent
+       * @return the prefix (e.g., agent.0)
+       **/
+      const std::string & get_prefix (void) const;
+
+      /**
+       * Gets the number of containers bound so far
+       * @return the number of bound containers
+       **/
+      size_t get_num_bound (void) const;
+
+      /// @return the accents of the agent
+      AccentStatuses & accents (void);
+
+      /// @return the acceleration vector of the platform
+      madara::knowledge::containers::NativeDoubleArray & acceleration (void);
+
+      /// @return agent specific command
+      madara::knowledge::containers::String & algorithm (void);
+
+      /// @return number of algorithm accepts / changes
+      madara::knowledge::containers::Integer & algorithm_accepts (void);
+
+      /// @return arguments for algorithm
+      madara::knowledge::containers::Map & algorithm_args (void);
+
+      /// @return agent specific command has changed
+      madara::knowledge::containers::Integer & algorithm_changed (void);
+
+      /// @return the algorithm id
+      madara::knowledge::containers::Integer & algorithm_id (void);
+
+      /// @return number of algorithm rejections (bad name or id)
+      madara::knowledge::containers::Integer & algorithm_rejects (void);
+
+      /// @return the battery indicator for this agent
+      madara::knowledge::containers::Integer & battery_remaining (void);
+
+      /// @return the bridge id of this agent
+      madara::knowledge::containers::Integer & bridge_id (void);
+
+      /// @return the area coverage type
+      madara::knowledge::containers::String & coverage_type (void);
+
+      /// @return desired altitude in meters
+      madara::knowledge::containers::Double & desired_altitude (void);
+
+      /// @return the destination location
+      madara::knowledge::containers::NativeDoubleArray & dest (void);
+
+      /// @return the destination orientation
+      madara::knowledge::containers::NativeDoubleArray & dest_orientation (void);
+
+      /// @return the GAMS debug level
+      madara::knowledge::containers::Integer & gams_debug_level (void);
+
+      /// @return the home location
+      madara::knowledge::containers::NativeDoubleArray & home (void);
+
+      /// @return the mobility indicator for this agent
+      madara::knowledge::containers::Integer & is_mobile (void);
+
+      /// @return the last algorithm
+      madara::knowledge::containers::String & last_algorithm (void);
+
+      /// @return the last algorithm args
+      madara::knowledge::containers::Map & last_algorithm_args (void);
+
+      /// @return the last algorithm id
+      madara::knowledge::containers::Integer & last_algorithm_id (void);
+
+      /// @return the location, usually encoded in GPS
+      madara::knowledge::containers::NativeDoubleArray & location (void);
+
+      /// @return the rate to process the MAPE loop
+      madara::knowledge::containers::Double & loop_hz (void);
+
+      /// @return the MADARA debug level
+      madara::knowledge::containers::Integer & madara_debug_level (void);
+
+      /// @return the minimum altitude for this agent
+      madara::knowledge::containers::Double & min_alt (void);
+
+      /// @return the next area coverage type
+      madara::knowledge::containers::String & next_coverage_type (void);
+
+      /// @return the angle for this agent (roll, pitch, yaw)
+      madara::knowledge::containers::NativeDoubleArray & orientation (void);
+
+      /// @return the assigned search area id
+      madara::knowledge::containers::Integer & search_area_id (void);
+
+      /// @return the rate to send messages
+      madara::knowledge::containers::Double & send_hz (void);
+
+      /// @return the source location
+      madara::knowledge::containers::NativeDoubleArray & source (void);
+
+      /// @return the source angle
+      madara::knowledge::containers::NativeDoubleArray & source_orientation (void);
+
+      /// @return indicator for temperature
+      madara::knowledge::containers::Double & temperature (void);
+
+      /// @return the velocity vector of the platform
+      madara::knowledge::containers::NativeDoubleArray & velocity (void);
+
+    protected:
+      /**
+       * Binds a container if it has not been bound yet
+       * @param  container  the container within agent_
+       * @param  field      the index of the container's bound bit
+       * @param  suffix     the variable name following the prefix
+       * @param  local      if true, changes are kept local
+       * @return the bound container
+       **/
+      template <typename T>
+      T & bind (T & container, int field, const char * suffix,
+        bool local = false);
+
+      /// the knowledge base, or 0 if not initialized
+      madara::knowledge::KnowledgeBase * knowledge_;
+
+      /// the prefix of the agent
+      std::string prefix_;
+
+      /// bit i is set if container i has been bound
+      uint64_t bound_;
+
+      /// the containers, bound as accessed
+      Agent agent_;
+    };
+
+    /**
+     * An array of agent views
+     **/
+    typedef std::vector <AgentView>   AgentViews;
+
+    /**
+      * Initializes agent views. This does not access the knowledge base
+      * beyond reading agent.size when processes is negative.
+      * @param   variables  the views to initialize
+      * @param   knowledge  the knowledge base that houses the variables
+      * @param   processes  the number of processes in the agent swarm
+      **/
+    GAMS_EXPORT void init_vars (AgentViews & variables,
+      madara::knowledge::KnowledgeBase & knowledge,
+      const madara::knowledge::KnowledgeRecord::Integer& processes);
+
+    /**
+    * Initializes agent views
+    * @param   variables  the views to initialize
+    * @param   knowledge  the knowledge base that houses the variables
+    * @param   group      a group containing all agents of interest
+    **/
+    GAMS_EXPORT void init_vars (AgentViews & variables,
+      madara::knowledge::KnowledgeBase & knowledge,
+      const groups::GroupBase & group);
+  }
+}
+
+#endif // _GAMS_VARIABLES_AGENT_VIEW_H_
@@ -52,6 +52,7 @@ using std::string;
 typedef  madara::knowledge::KnowledgeRecord::Integer  Integer;
 
 gams::variables::AlgorithmStatus::AlgorithmStatus ()
+  : packed_ (false), unpacked_ (0)
 {
 }
 
@@ -72,6 +73,9 @@ gams::variables::AlgorithmStatus::operator= (const AlgorithmStatus & rhs)
     this->failed = rhs.failed;
     this->unknown = rhs.unknown;
     this->finished = rhs.finished;
+    this->flags = rhs.flags;
+    this->packed_ = rhs.packed_;
+    this->unpacked_ = rhs.unpacked_;
   }
 }
 
@@ -93,6 +97,7 @@ const std::string & new_name, const std::string & agent_prefix)
   this->failed.set_name (prefix + ".failed", knowledge);
   this->unknown.set_name (prefix + ".unknown", knowledge);
   this->finished.set_name (prefix + ".finished", knowledge);
+  this->flags.set_name (prefix + ".flags", knowledge);
 }
 
 void
@@ -113,6 +118,7 @@ const std::string & new_name, const std::string & agent_prefix)
   this->failed.set_name (prefix + ".failed", knowledge);
   this->unknown.set_name (prefix + ".unknown", knowledge);
   this->finished.set_name (prefix + ".finished", knowledge);
+  this->flags.set_name (prefix + ".flags", knowledge);
 }
 
 void
@@ -132,6 +138,7 @@ gams::variables::AlgorithmStatus::init_vars (
   this->failed.set_name (prefix + ".failed", knowledge);
   this->unknown.set_name (prefix + ".unknown", knowledge);
   this->finished.set_name (prefix + ".finished", knowledge);
+  this->flags.set_name (prefix + ".flags", knowledge);
 }
 
 void
@@ -151,6 +158,7 @@ gams::variables::AlgorithmStatus::init_vars (
   this->failed.set_name (prefix + ".failed", knowledge);
   this->unknown.set_name (prefix + ".unknown", knowledge);
   this->finished.set_name (prefix + ".finished", knowledge);
+  this->flags.set_name (prefix + ".flags", knowledge);
 }
 
 string
@@ -174,3 +182,53 @@ gams::variables::AlgorithmStatus::init_variable_values ()
   unknown = 0;
   finished = 0;
 }
+
+void
+gams::variables::AlgorithmStatus::set_packed (bool packed)
+{
+  StatusFlagList flag_list;
+  get_flag_containers (flag_list);
+
+  set_status_flags_local (flag_list, packed);
+  packed_ = packed;
+}
+
+bool
+gams::variables::AlgorithmStatus::is_packed (void) const
+{
+  return packed_;
+}
+
+bool
+gams::variables::AlgorithmStatus::pack (void)
+{
+  StatusFlagList flag_list;
+  get_flag_containers (flag_list);
+
+  return pack_status_flags (flag_list, flags);
+}
+
+bool
+gams::variables::AlgorithmStatus::unpack (void)
+{
+  StatusFlagList flag_list;
+  get_flag_containers (flag_list);
+
+  set_status_flags_local (flag_list, true);
+
+  return unpack_status_flags (flags, flag_list, unpacked_);
+}
+
+void
+gams::variables::AlgorithmStatus::get_flag_containers (
+  StatusFlagList & flag_list)
+{
+  flag_list.clear ();
+  flag_list.push_back (&ok);
+  flag_list.push_back (&paused);
+  flag_list.push_back (&waiting);
+  flag_list.push_back (&deadlocked);
+  flag_list.push_back (&failed);
+  flag_list.push_back (&unknown);
+  flag_list.push_back (&finished);
+}
@@ -52,6 +52,7 @@ using std::string;
 typedef  madara::knowledge::KnowledgeRecord::Integer  Integer;
 
 gams::variables::PlatformStatus::PlatformStatus ()
+  : packed_ (false), unpacked_ (0)
 {
 }
 
@@ -70,12 +71,18 @@ gams::variables::PlatformStatus::operator= (const PlatformStatus & rhs)
     this->deadlocked = rhs.deadlocked;
     this->failed = rhs.failed;
     this->moving = rhs.moving;
+    this->rotating = rhs.rotating;
+    this->paused_moving = rhs.paused_moving;
+    this->paused_rotating = rhs.paused_rotating;
     this->reduced_sensing = rhs.reduced_sensing;
     this->reduced_movement = rhs.reduced_movement;
     this->communication_available = rhs.communication_available;
     this->sensors_available = rhs.sensors_available;
     this->movement_available = rhs.movement_available;
     this->gps_spoofed = rhs.gps_spoofed;
+    this->flags = rhs.flags;
+    this->packed_ = rhs.packed_;
+    this->unpacked_ = rhs.unpacked_;
   }
 }
 
@@ -97,6 +104,9 @@ gams::variables::PlatformStatus::init_vars (
   this->deadlocked.set_name (prefix + ".deadlocked", knowledge);
   this->failed.set_name (prefix + ".failed", knowledge);
   this->moving.set_name (prefix + ".moving", knowledge);
+  this->rotating.set_name (prefix + ".rotating", knowledge);
+  this->paused_moving.set_name (prefix + ".paused_moving", knowledge);
+  this->paused_rotating.set_name (prefix + ".paused_rotating", knowledge);
   this->reduced_sensing.set_name (prefix + ".reduced_sensing", knowledge);
   this->reduced_movement.set_name (prefix + ".reduced_movement", knowledge);
   this->communication_available.set_name (
@@ -105,6 +115,7 @@ gams::variables::PlatformStatus::init_vars (
   this->movement_available.set_name (
     prefix + ".movement_available", knowledge);
   this->gps_spoofed.set_name (prefix + ".gps_spoofed", knowledge);
+  this->flags.set_name (prefix + ".flags", knowledge);
 
   init_variable_values ();
 }
@@ -126,6 +137,9 @@ gams::variables::PlatformStatus::init_vars (
   this->deadlocked.set_name (prefix + ".deadlocked", knowledge);
   this->failed.set_name (prefix + ".failed", knowledge);
   this->moving.set_name (prefix + ".moving", knowledge);
+  this->rotating.set_name (prefix + ".rotating", knowledge);
+  this->paused_moving.set_name (prefix + ".paused_moving", knowledge);
+  this->paused_rotating.set_name (prefix + ".paused_rotating", knowledge);
   this->reduced_sensing.set_name (prefix + ".reduced_sensing", knowledge);
   this->reduced_movement.set_name (prefix + ".reduced_movement", knowledge);
   this->communication_available.set_name (
@@ -134,6 +148,7 @@ gams::variables::PlatformStatus::init_vars (
   this->movement_available.set_name (
     prefix + ".movement_available", knowledge);
   this->gps_spoofed.set_name (prefix + ".gps_spoofed", knowledge);
+  this->flags.set_name (prefix + ".flags", knowledge);
 
   init_variable_values ();
 }
@@ -155,6 +170,9 @@ gams::variables::PlatformStatus::init_variable_values ()
   deadlocked = 0;
   failed = 0;
   moving = 0;
+  rotating = 0;
+  paused_moving = 0;
+  paused_rotating = 0;
   reduced_sensing = 0;
   reduced_movement = 0;
   communication_available = 0;
@@ -162,3 +180,60 @@ gams::variables::PlatformStatus::init_variable_values ()
   movement_available = 0;
   gps_spoofed = 0;
 }
+
+void
+gams::variables::PlatformStatus::set_packed (bool packed)
+{
+  StatusFlagList flag_list;
+  get_flag_containers (flag_list);
+
+  set_status_flags_local (flag_list, packed);
+  packed_ = packed;
+}
+
+bool
+gams::variables::PlatformStatus::is_packed (void) const
+{
+  return packed_;
+}
+
+bool
+gams::variables::PlatformStatus::pack (void)
+{
+  StatusFlagList flag_list;
+  get_flag_containers (flag_list);
+
+  return pack_status_flags (flag_list, flags);
+}
+
+bool
+gams::variables::PlatformStatus::unpack (void)
+{
+  StatusFlagList flag_list;
+  get_flag_containers (flag_list);
+
+  set_status_flags_local (flag_list, true);
+
+  return unpack_status_flags (flags, flag_list, unpacked_);
+}
+
+void
+gams::variables::PlatformStatus::get_flag_containers (
+  StatusFlagList & flag_list)
+{
+  // communication_available is a count, so it is published on its own
+  flag_list.clear ();
+  flag_list.push_back (&deadlocked);
+  flag_list.push_back (&failed);
+  flag_list.push_back (&gps_spoofed);
+  flag_list.push_back (&movement_available);
+  flag_list.push_back (&moving);
+  flag_list.push_back (&rotating);
+  flag_list.push_back (&ok);
+  flag_list.push_back (&paused_moving);
+  flag_list.push_back (&paused_rotating);
+  flag_list.push_back (&reduced_sensing);
+  flag_list.push_back (&reduced_movement);
+  flag_list.push_back (&sensors_available);
+  flag_list.push_back (&waiting);
+}
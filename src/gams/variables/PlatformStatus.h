@@ -62,6 +62,7 @@
 #include "madara/knowledge/containers/Integer.h"
 #include "madara/knowledge/KnowledgeBase.h"
 #include "gams/variables/Agent.h"
+#include "gams/variables/StatusFlags.h"
 
 namespace gams
 {
@@ -105,6 +106,35 @@ namespace gams
       void init_vars (madara::knowledge::Variables & knowledge,
         const std::string & new_name = "");
 
+      /**
+       * Sets whether the flags are disseminated as a single packed record.
+       * When packed, changes to the individual flags are kept local and
+       * pack publishes them in the flags record. Readers of another
+       * agent's individual flags then only see them after unpack.
+       * @param  packed  true to use the packed record
+       **/
+      void set_packed (bool packed);
+
+      /**
+       * Checks if the flags are disseminated as a packed record
+       * @return true if packed
+       **/
+      bool is_packed (void) const;
+
+      /**
+       * Packs the flags into the flags record if any have changed
+       * @return true if the flags record changed
+       **/
+      bool pack (void);
+
+      /**
+       * Sets the flags from the flags record, e.g., for the status of
+       * another agent that packs its flags. The flags are made local so
+       * that unpacked values are not sent again.
+       * @return true if the flags were changed
+       **/
+      bool unpack (void);
+
       /// the id of this agent
       std::string name;
       
@@ -156,6 +186,13 @@ namespace gams
       /// status flag for waiting
       madara::knowledge::containers::Integer waiting;
 
+      /**
+       * all flags packed into one record, in the order of the flags above.
+       * communication_available is a count and is not packed.
+       * @see gams::variables::StatusFlagList
+       **/
+      madara::knowledge::containers::Integer flags;
+
     protected:
       /**
        * Get variable prefix
@@ -167,6 +204,18 @@ namespace gams
        * Initialize variable values
        */
       void init_variable_values ();
+
+      /**
+       * Gets the flag containers in bit order
+       * @param  flag_list   the list to fill
+       **/
+      void get_flag_containers (StatusFlagList & flag_list);
+
+      /// true if the flags are disseminated as a packed record
+      bool packed_;
+
+      /// the flags record when last unpacked
+      madara::knowledge::KnowledgeRecord::Integer unpacked_;
     };
     
     /// deprecated typedef. Please use PlatformStatus instead.
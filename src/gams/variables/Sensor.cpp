@@ -45,12 +45,16 @@
  **/
 
 #include "gams/variables/Sensor.h"
+#include "gams/loggers/GlobalLogger.h"
+#include "madara/knowledge/ContextGuard.h"
 
 #include <float.h>
+#include <string.h>
 #include <sstream>
 #include <vector>
 #include <string>
 #include <cmath>
+#include <memory>
 
 using std::string;
 using std::stringstream;
@@ -58,15 +62,165 @@ using std::vector;
 
 typedef  madara::knowledge::KnowledgeRecord::Integer  Integer;
 
+namespace
+{
+  // tile coordinates are the cell indices shifted right, which floors
+  // negative indices onto the correct tile
+  int64_t tile_key (int x, int y)
+  {
+    return (int64_t)(
+      ((uint64_t)(uint32_t)(x >> gams::variables::Sensor::TILE_BITS) << 32) |
+      (uint32_t)(y >> gams::variables::Sensor::TILE_BITS));
+  }
+
+  /**
+   * Deltas are encoded little endian as:
+   *   u8 format, u8 flags, u32 sequence, u32 tile count, then per tile
+   *   i32 tile x, i32 tile y, u32 segment count, then per segment
+   *   u16 first cell, u16 cell count, u8 kind, and either one value
+   *   (SEGMENT_REPEAT) or cell count values (SEGMENT_LITERAL).
+   **/
+  const unsigned char DELTA_FORMAT = 1;
+  const unsigned char DELTA_KEYFRAME = 1;
+  const unsigned char SEGMENT_LITERAL = 0;
+  const unsigned char SEGMENT_REPEAT = 1;
+
+  // equal cells shorter than this are cheaper to send as literals
+  const size_t MIN_REPEAT = 3;
+
+  void put (std::vector <unsigned char> & buffer, uint64_t value,
+    size_t bytes)
+  {
+    for (size_t i = 0; i < bytes; ++i)
+      buffer.push_back ((unsigned char)(value >> (8 * i)));
+  }
+
+  void put_double (std::vector <unsigned char> & buffer, double value)
+  {
+    uint64_t bits;
+    memcpy (&bits, &value, sizeof (bits));
+    put (buffer, bits, 8);
+  }
+
+  void patch_u32 (std::vector <unsigned char> & buffer, size_t pos,
+    uint32_t value)
+  {
+    for (size_t i = 0; i < 4; ++i)
+      buffer[pos + i] = (unsigned char)(value >> (8 * i));
+  }
+
+  /**
+   * Bounds-checked little endian reader over a received delta
+   **/
+  struct DeltaReader
+  {
+    const unsigned char * pos;
+    const unsigned char * end;
+
+    bool get (uint64_t & value, size_t bytes)
+    {
+      if ((size_t)(end - pos) < bytes)
+        return false;
+
+      value = 0;
+      for (size_t i = 0; i < bytes; ++i)
+        value |= (uint64_t)pos[i] << (8 * i);
+      pos += bytes;
+      return true;
+    }
+
+    bool get_double (double & value)
+    {
+      uint64_t bits;
+      if (!get (bits, 8))
+        return false;
+
+      memcpy (&value, &bits, sizeof (value));
+      return true;
+    }
+  };
+
+  // cells in a delta are those changed since the last delta, or every
+  // cell of the tile in a keyframe
+  bool in_delta (const std::vector <bool> * mask, size_t cell)
+  {
+    return mask == 0 || (*mask)[cell];
+  }
+
+  size_t repeat_length (const std::vector <double> & values,
+    const std::vector <bool> * mask, size_t start)
+  {
+    size_t end = start + 1;
+    while (end < values.size () && in_delta (mask, end) &&
+      values[end] == values[start])
+      ++end;
+    return end - start;
+  }
+
+  /**
+   * Appends the run-length encoded cells of a tile
+   * @return the number of segments appended
+   **/
+  uint32_t encode_tile (std::vector <unsigned char> & buffer,
+    const std::vector <double> & values, const std::vector <bool> * mask)
+  {
+    uint32_t segments = 0;
+    size_t i = 0;
+
+    while (i < values.size ())
+    {
+      if (!in_delta (mask, i))
+      {
+        ++i;
+        continue;
+      }
+
+      size_t length = repeat_length (values, mask, i);
+      if (length >= MIN_REPEAT)
+      {
+        put (buffer, i, 2);
+        put (buffer, length, 2);
+        put (buffer, SEGMENT_REPEAT, 1);
+        put_double (buffer, values[i]);
+      }
+      else
+      {
+        // extend the literal until the delta ends or a repeat begins
+        length = 1;
+        while (i + length < values.size () && in_delta (mask, i + length) &&
+          repeat_length (values, mask, i + length) < MIN_REPEAT)
+          ++length;
+
+        put (buffer, i, 2);
+        put (buffer, length, 2);
+        put (buffer, SEGMENT_LITERAL, 1);
+        for (size_t j = i; j < i + length; ++j)
+          put_double (buffer, values[j]);
+      }
+
+      i += length;
+      ++segments;
+    }
+
+    return segments;
+  }
+}
+
 gams::variables::Sensor::Sensor () :
-  knowledge_ (0), name_ ("")
+  last_tile_ (0), last_key_ (0), knowledge_ (0), name_ (""),
+  merge_ (MERGE_OVERWRITE), keyframe_interval_ (0), delta_sequence_ (0),
+  keyframe_requests_ (0), syncs_ (0),
+  local_origin_ (pose::gps_frame (), DBL_MAX, DBL_MAX)
 {
 }
 
 gams::variables::Sensor::Sensor (const string & name,
   madara::knowledge::KnowledgeBase * knowledge,
   const double & range, const pose::Position & origin) :
-  knowledge_ (knowledge), name_ (name)
+  last_tile_ (0), last_key_ (0), knowledge_ (knowledge), name_ (name),
+  merge_ (MERGE_OVERWRITE), keyframe_interval_ (0), delta_sequence_ (0),
+  keyframe_requests_ (0), syncs_ (0),
+  local_origin_ (pose::gps_frame (), DBL_MAX, DBL_MAX)
 {
   init_vars ();
 
@@ -86,10 +240,19 @@ gams::variables::Sensor::operator= (const Sensor & rhs)
   if (this != &rhs)
   {
     this->range_ = rhs.range_;
-    this->value_ = rhs.value_;
+    this->tiles_ = rhs.tiles_;
+    this->last_tile_ = 0;
     this->origin_ = rhs.origin_;
     this->knowledge_ = rhs.knowledge_;
     this->name_ = rhs.name_;
+    this->delta_sender_ = rhs.delta_sender_;
+    this->merge_ = rhs.merge_;
+    this->keyframe_interval_ = rhs.keyframe_interval_;
+    this->delta_sequence_ = rhs.delta_sequence_;
+    this->delta_received_ = rhs.delta_received_;
+    this->delta_clocks_ = rhs.delta_clocks_;
+    this->keyframe_requests_ = rhs.keyframe_requests_;
+    this->syncs_ = rhs.syncs_;
   }
 }
 
@@ -155,18 +318,43 @@ gams::variables::Sensor::discretize (
       eastern = region.vertices[i];
   const int max_y = (int)get_index_from_gps (eastern).y();
 
+  // candidate cells of a column are converted to GPS as one batch
+  const double discretize = get_discretization ();
+  vector<double> rows;
+  vector<pose::Position> cells;
+
+  regenerate_local_frame ();
+
   // move east each iteration
   while (start_index.y() < max_y)
   {
+    rows.clear ();
+
     // check north
-    for (pose::Position pos = start_index; pos.x() <= max_x; pos.x(pos.x() + 1))
-      if (region.contains (get_gps_from_index (pos)))
-        ret_val.insert (pos);
-  
+    for (double x = start_index.x(); x <= max_x; x += 1)
+      rows.push_back (x);
+
     // check south
-    for (pose::Position pos = start_index; pos.x() >= min_x; pos.x(pos.x() - 1))
-      if (region.contains (get_gps_from_index (pos)))
+    for (double x = start_index.x(); x >= min_x; x -= 1)
+      rows.push_back (x);
+
+    cells.clear ();
+    for (size_t i = 0; i < rows.size (); ++i)
+      cells.push_back (pose::Position (local_frame_,
+        int(rows[i]) * discretize, int(start_index.y()) * discretize,
+        int(start_index.z())));
+
+    const vector<bool> inside = region.contains (cells);
+
+    for (size_t i = 0; i < cells.size (); ++i)
+    {
+      if (inside[i])
+      {
+        pose::Position pos = start_index;
+        pos.x(rows[i]);
         ret_val.insert (pos);
+      }
+    }
 
     start_index.y(start_index.y() + 1);
   }
@@ -197,7 +385,16 @@ gams::variables::Sensor::get_discretization () const
 void
 gams::variables::Sensor::regenerate_local_frame ()
 {
-  local_frame_ = pose::ReferenceFrame(pose::Cartesian, get_origin());
+  pose::Position origin = get_origin ();
+
+  // constructing a frame is expensive, so only do so when the origin moves
+  if (origin.latitude () != local_origin_.latitude () ||
+    origin.longitude () != local_origin_.longitude () ||
+    origin.altitude () != local_origin_.altitude ())
+  {
+    local_frame_ = pose::ReferenceFrame (pose::Cartesian, origin);
+    local_origin_ = origin;
+  }
 }
 
 gams::pose::Position
@@ -252,7 +449,32 @@ gams::variables::Sensor::get_range () const
 double
 gams::variables::Sensor::get_value (const pose::Position & pos)
 {
-  return value_[index_pos_to_index (get_index_from_gps (pos))].to_double ();
+  pose::Position idx = get_index_from_gps (pos);
+  return get_index_value ((int)idx.x (), (int)idx.y ());
+}
+
+double
+gams::variables::Sensor::get_index_value (int x, int y)
+{
+  Tile & tile = find_tile (x, y);
+  refresh_tile (tile);
+
+  return tile.values[cell_offset (x, y)];
+}
+
+size_t
+gams::variables::Sensor::get_num_tiles (void) const
+{
+  return tiles_.size ();
+}
+
+void
+gams::variables::Sensor::set_delta_mode (const std::string & sender,
+  MergePolicy merge, unsigned int keyframe_interval)
+{
+  delta_sender_ = sender;
+  merge_ = merge;
+  keyframe_interval_ = keyframe_interval;
 }
 
 void
@@ -272,18 +494,370 @@ gams::variables::Sensor::set_value (const pose::Position & pos,
   const double & val,
   const madara::knowledge::KnowledgeUpdateSettings & settings)
 {
-  string idx = index_pos_to_index (get_index_from_gps(pos));
-  value_.set (idx, val, settings);
+  pose::Position idx = get_index_from_gps (pos);
+  set_index_value ((int)idx.x (), (int)idx.y (), val, settings);
 }
 
-string
-gams::variables::Sensor::index_pos_to_index (
-  const pose::Position & pos) const
+void
+gams::variables::Sensor::set_index_value (int x, int y,
+  const double & val,
+  const madara::knowledge::KnowledgeUpdateSettings & settings)
 {
-  stringstream buffer;
-  buffer << (int)(pos.x()) << "x" << (int)(pos.y());
+  Tile & tile = find_tile (x, y);
+  double & cell = tile.values[cell_offset (x, y)];
 
-  return buffer.str ();
+  if (cell != val)
+  {
+    cell = val;
+
+    if (!settings.treat_globals_as_locals)
+    {
+      tile.dirty = true;
+      tile.changed[cell_offset (x, y)] = true;
+    }
+  }
+}
+
+size_t
+gams::variables::Sensor::sync (
+  const madara::knowledge::KnowledgeUpdateSettings & settings)
+{
+  size_t published = 0;
+
+  if (knowledge_ == 0)
+    return published;
+
+  // tiles read from here on check their records again
+  ++syncs_;
+
+  if (!delta_sender_.empty ())
+    return sync_deltas (settings);
+
+  madara::knowledge::ContextGuard guard (*knowledge_);
+  madara::knowledge::ThreadSafeContext & context =
+    knowledge_->get_context ();
+
+  for (Tiles::iterator i = tiles_.begin (); i != tiles_.end (); ++i)
+  {
+    Tile & tile = i->second;
+
+    if (!tile.dirty)
+      continue;
+
+    const madara::knowledge::KnowledgeRecord * record =
+      tile.ref.get_record_unsafe ();
+
+    // only cells written with broadcast settings replace the values in
+    // the knowledge base
+    std::vector <double> values;
+    if (record != 0 && record->size () == tile.values.size ())
+    {
+      values = record->to_doubles ();
+
+      if (record->clock != tile.clock)
+        merge_record (tile, *record);
+    }
+    else
+      values.assign (tile.values.size (), 0.0);
+
+    for (size_t cell = 0; cell < values.size (); ++cell)
+    {
+      if (tile.changed[cell])
+        values[cell] = tile.values[cell];
+    }
+
+    context.set (tile.ref, values, settings);
+    tile.clock = tile.ref.get_record_unsafe ()->clock;
+    tile.dirty = false;
+    tile.changed.assign (tile.changed.size (), false);
+    ++published;
+  }
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_DETAILED,
+    "gams::variables::Sensor::sync:" \
+    " %s: published %d of %d tiles\n",
+    name_.c_str (), (int)published, (int)tiles_.size ());
+
+  return published;
+}
+
+size_t
+gams::variables::Sensor::sync_deltas (
+  const madara::knowledge::KnowledgeUpdateSettings & settings)
+{
+  madara::knowledge::ContextGuard guard (*knowledge_);
+  madara::knowledge::ThreadSafeContext & context =
+    knowledge_->get_context ();
+
+  const std::string prefix ("sensor." + name_ + ".deltas.");
+  const std::string requests ("sensor." + name_ + ".keyframe_requests.");
+
+  bool changed = false;
+  for (Tiles::iterator i = tiles_.begin (); i != tiles_.end (); ++i)
+    changed = changed || i->second.dirty;
+
+  // receivers that missed deltas ask for a keyframe
+  const Integer requested =
+    context.get (requests + delta_sender_).to_integer ();
+  const bool keyframe_requested = requested != keyframe_requests_;
+
+  size_t published = 0;
+
+  if (changed || keyframe_requested)
+  {
+    ++delta_sequence_;
+    const bool keyframe = keyframe_requested || (keyframe_interval_ > 0 &&
+      delta_sequence_ % keyframe_interval_ == 0);
+
+    keyframe_requests_ = requested;
+
+    std::vector <unsigned char> buffer;
+    put (buffer, DELTA_FORMAT, 1);
+    put (buffer, keyframe ? DELTA_KEYFRAME : 0, 1);
+    put (buffer, delta_sequence_, 4);
+    const size_t count_pos = buffer.size ();
+    put (buffer, 0, 4);
+
+    for (Tiles::iterator i = tiles_.begin (); i != tiles_.end (); ++i)
+    {
+      Tile & tile = i->second;
+      tile.written = tile.written || tile.dirty;
+
+      if (tile.dirty || (keyframe && tile.written))
+      {
+        put (buffer, (uint32_t)(i->first >> 32), 4);
+        put (buffer, (uint32_t)i->first, 4);
+        const size_t segments_pos = buffer.size ();
+        put (buffer, 0, 4);
+
+        patch_u32 (buffer, segments_pos, encode_tile (buffer, tile.values,
+          keyframe ? 0 : &tile.changed));
+
+        tile.dirty = false;
+        tile.changed.assign (tile.changed.size (), false);
+        ++published;
+      }
+    }
+
+    patch_u32 (buffer, count_pos, (uint32_t)published);
+
+    context.set_file (prefix + delta_sender_,
+      &buffer[0], buffer.size (), settings);
+
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_DETAILED,
+      "gams::variables::Sensor::sync_deltas:" \
+      " %s: published %s %d with %d tiles in %d bytes\n",
+      name_.c_str (), keyframe ? "keyframe" : "delta",
+      (int)delta_sequence_, (int)published, (int)buffer.size ());
+  }
+
+  // the records are visited in place. Only records whose clock advanced
+  // since the last sync are decoded.
+  const madara::knowledge::KnowledgeMap & records = context.get_map_unsafe ();
+  std::vector <std::string> missed_senders;
+
+  for (madara::knowledge::KnowledgeMap::const_iterator i =
+    records.lower_bound (prefix);
+    i != records.end () && i->first.compare (0, prefix.size (), prefix) == 0;
+    ++i)
+  {
+    if (i->first.size () == prefix.size () + delta_sender_.size () &&
+      i->first.compare (prefix.size (), std::string::npos,
+        delta_sender_) == 0)
+      continue;
+
+    if (!i->second.is_binary_file_type ())
+      continue;
+
+    uint64_t & clock = delta_clocks_[i->first];
+    if (clock == i->second.clock)
+      continue;
+
+    clock = i->second.clock;
+
+    size_t size;
+    std::unique_ptr <unsigned char[]> buffer (
+      i->second.to_unmanaged_buffer (size));
+    bool missed = false;
+
+    if (!merge_delta (buffer.get (), size, delta_received_[i->first],
+      missed))
+    {
+      madara_logger_ptr_log (gams::loggers::global_logger.get (),
+        gams::loggers::LOG_MAJOR,
+        "gams::variables::Sensor::sync_deltas:" \
+        " %s: ignoring malformed delta in %s\n",
+        name_.c_str (), i->first.c_str ());
+    }
+    else if (missed)
+    {
+      missed_senders.push_back (i->first.substr (prefix.size ()));
+    }
+  }
+
+  // requests are set after the iteration, which they could invalidate
+  for (size_t i = 0; i < missed_senders.size (); ++i)
+  {
+    const std::string request (requests + missed_senders[i]);
+    context.set (request,
+      context.get (request).to_integer () + 1, settings);
+  }
+
+  return published;
+}
+
+bool
+gams::variables::Sensor::merge_delta (const unsigned char * buffer,
+  size_t size, uint32_t & sequence, bool & missed)
+{
+  DeltaReader reader = { buffer, buffer + size };
+  uint64_t format, flags, delta_sequence, tiles;
+
+  if (!reader.get (format, 1) || format != DELTA_FORMAT ||
+    !reader.get (flags, 1) || !reader.get (delta_sequence, 4) ||
+    !reader.get (tiles, 4))
+    return false;
+
+  // already merged
+  if ((uint32_t)delta_sequence == sequence)
+    return true;
+
+  if ((uint32_t)delta_sequence != sequence + 1 && !(flags & DELTA_KEYFRAME))
+  {
+    missed = true;
+
+    madara_logger_ptr_log (gams::loggers::global_logger.get (),
+      gams::loggers::LOG_MINOR,
+      "gams::variables::Sensor::merge_delta:" \
+      " %s: missed deltas %d to %d\n",
+      name_.c_str (), (int)sequence + 1, (int)delta_sequence - 1);
+  }
+
+  for (uint64_t t = 0; t < tiles; ++t)
+  {
+    uint64_t tx, ty, segments;
+    if (!reader.get (tx, 4) || !reader.get (ty, 4) ||
+      !reader.get (segments, 4))
+      return false;
+
+    Tile & tile = find_tile ((int32_t)(uint32_t)tx * TILE_SIZE,
+      (int32_t)(uint32_t)ty * TILE_SIZE);
+
+    for (uint64_t s = 0; s < segments; ++s)
+    {
+      uint64_t start, length, kind;
+      if (!reader.get (start, 2) || !reader.get (length, 2) ||
+        !reader.get (kind, 1) || start + length > tile.values.size ())
+        return false;
+
+      double value = 0.0;
+      for (uint64_t cell = start; cell < start + length; ++cell)
+      {
+        if ((kind == SEGMENT_LITERAL || cell == start) &&
+          !reader.get_double (value))
+          return false;
+
+        double & current = tile.values[cell];
+        if (merge_ == MERGE_OVERWRITE ||
+          (merge_ == MERGE_MAX && value > current) ||
+          (merge_ == MERGE_MIN && value < current))
+          current = value;
+      }
+    }
+  }
+
+  sequence = (uint32_t)delta_sequence;
+  return true;
+}
+
+gams::variables::Sensor::Tile &
+gams::variables::Sensor::find_tile (int x, int y)
+{
+  const int64_t key = tile_key (x, y);
+
+  if (last_tile_ != 0 && key == last_key_)
+    return *last_tile_;
+
+  Tiles::iterator found = tiles_.find (key);
+  if (found == tiles_.end ())
+  {
+    found = tiles_.insert (Tiles::value_type (key, Tile ())).first;
+
+    Tile & tile = found->second;
+    tile.values.assign (TILE_SIZE * TILE_SIZE, 0.0);
+    tile.clock = 0;
+    tile.dirty = false;
+    tile.changed.assign (TILE_SIZE * TILE_SIZE, false);
+    tile.written = false;
+    tile.refreshed = syncs_;
+
+    if (knowledge_ != 0)
+    {
+      stringstream buffer;
+      buffer << "sensor." << name_ << ".tiles." <<
+        (x >> TILE_BITS) << "x" << (y >> TILE_BITS);
+
+      madara::knowledge::ContextGuard guard (*knowledge_);
+      tile.ref = knowledge_->get_ref (buffer.str ());
+
+      // another agent may already have published this tile
+      madara::knowledge::KnowledgeRecord record = knowledge_->get (tile.ref);
+      if (record.size () == tile.values.size ())
+      {
+        tile.values = record.to_doubles ();
+        tile.clock = record.clock;
+      }
+    }
+  }
+
+  last_key_ = key;
+  last_tile_ = &found->second;
+
+  return found->second;
+}
+
+size_t
+gams::variables::Sensor::cell_offset (int x, int y)
+{
+  return (size_t)(((y & (TILE_SIZE - 1)) << TILE_BITS) | (x & (TILE_SIZE - 1)));
+}
+
+void
+gams::variables::Sensor::merge_record (Tile & tile,
+  const madara::knowledge::KnowledgeRecord & record)
+{
+  if (record.size () != tile.values.size ())
+    return;
+
+  const std::vector <double> values (record.to_doubles ());
+
+  for (size_t cell = 0; cell < values.size (); ++cell)
+  {
+    if (!tile.changed[cell])
+      tile.values[cell] = values[cell];
+  }
+}
+
+void
+gams::variables::Sensor::refresh_tile (Tile & tile)
+{
+  if (knowledge_ == 0 || !delta_sender_.empty () || tile.refreshed == syncs_)
+    return;
+
+  tile.refreshed = syncs_;
+
+  // the record is only copied when its clock has advanced
+  madara::knowledge::ContextGuard guard (*knowledge_);
+  const madara::knowledge::KnowledgeRecord * record =
+    tile.ref.get_record_unsafe ();
+
+  if (record != 0 && record->clock != tile.clock)
+  {
+    merge_record (tile, *record);
+    tile.clock = record->clock;
+  }
 }
 
 void
@@ -296,7 +870,6 @@ gams::variables::Sensor::init_vars ()
 
   // initialize the variable containers
   range_.set_name (prefix + ".range", *knowledge_);
-  value_.set_name (prefix + ".covered", *knowledge_);
   origin_.set_name (prefix + ".origin", *knowledge_);
 }
 
@@ -308,6 +881,10 @@ gams::variables::Sensor::init_vars (const string & name,
   name_ = name;
   knowledge_ = knowledge;
 
+  // tiles refer to records of the previous name and knowledge base
+  tiles_.clear ();
+  last_tile_ = 0;
+
   /**
    * We only want to update range if it has not yet been set. This could result 
    * in inconsistencies if multiple agents try to set different ranges. In the 
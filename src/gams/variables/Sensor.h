@@ -57,11 +57,14 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <stdint.h>
 
 #include "gams/GamsExport.h"
 #include "madara/knowledge/containers/Double.h"
-#include "madara/knowledge/containers/Map.h"
+#include "madara/knowledge/containers/NativeDoubleVector.h"
 #include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/VariableReference.h"
 
 #include "gams/pose/SearchArea.h"
 #include "gams/pose/GPSFrame.h"
@@ -75,11 +78,37 @@ namespace gams
   namespace variables
   {
     /**
-    * A container for sensor information
+    * A container for sensor information. Sensor values are held locally in
+    * a dense grid of fixed-size tiles. Writes only touch the local grid;
+    * call sync to publish the cells written with broadcast settings to the
+    * knowledge base. BaseController syncs every sensor in its sensors map
+    * once per cycle, after execute. The first read of a tile after each
+    * sync refreshes it if its record has changed in the knowledge base, so
+    * tiles published by other agents are seen once per cycle and cell
+    * reads otherwise stay local. In delta mode, sync instead publishes a
+    * single binary record holding only the cells changed since the last
+    * sync, and merges the deltas of other senders, which are only seen
+    * after a sync.
     **/
     class GAMS_EXPORT Sensor
     {
     public:
+      /**
+       * How cells received in a delta are combined with local values
+       **/
+      enum MergePolicy
+      {
+        MERGE_OVERWRITE,
+        MERGE_MAX,
+        MERGE_MIN
+      };
+
+      /// log2 of the number of cells along each side of a tile
+      static const int TILE_BITS = 6;
+
+      /// number of cells along each side of a tile
+      static const int TILE_SIZE = 1 << TILE_BITS;
+
       /**
        * Constructor
        **/
@@ -167,6 +196,40 @@ namespace gams
        **/
       double get_value (const pose::Position& pos);
 
+      /**
+       * Gets value at an index location, bypassing GPS conversion. On the
+       * first read of the tile since the last sync, the tile is refreshed
+       * if its record has changed.
+       * @param x     index along the x axis of the sensor map
+       * @param y     index along the y axis of the sensor map
+       * @return sensor value at the index
+       **/
+      double get_index_value (int x, int y);
+
+      /**
+       * Gets the number of tiles currently held in the local grid
+       * @return number of tiles
+       **/
+      size_t get_num_tiles (void) const;
+
+      /**
+       * Enables or disables delta dissemination. Each sender publishes
+       * its deltas to sensor.{name}.deltas.{sender}. A receiver that
+       * detects a gap in the sequence numbers of a sender increments
+       * sensor.{name}.keyframe_requests.{sender}, and the sender answers
+       * with a keyframe on its next sync.
+       * @param sender    unique name of this agent, e.g., agent.0. An
+       *                  empty name reverts to publishing whole tiles.
+       * @param merge     how received cells are combined with local cells
+       * @param keyframe_interval  every this many deltas, resend all
+       *                  locally written tiles in full, in addition to
+       *                  keyframes sent on request. 0 disables periodic
+       *                  keyframes.
+       **/
+      void set_delta_mode (const std::string & sender,
+        MergePolicy merge = MERGE_OVERWRITE,
+        unsigned int keyframe_interval = 0);
+
       /**
        * Sets origin
        * @param origin  new origin
@@ -188,6 +251,34 @@ namespace gams
       void set_value (const pose::Position& pos, const double& val,
         const madara::knowledge::KnowledgeUpdateSettings& settings =
           madara::knowledge::KnowledgeUpdateSettings());
+
+      /**
+       * Sets value at an index location, bypassing GPS conversion
+       * @param x     index along the x axis of the sensor map
+       * @param y     index along the y axis of the sensor map
+       * @param val   value to set at the index
+       * @param settings  settings to use for mutating value. If globals
+       *                  are treated as locals, the cell is not published
+       *                  by sync and may be overwritten by remote values.
+       **/
+      void set_index_value (int x, int y, const double& val,
+        const madara::knowledge::KnowledgeUpdateSettings& settings =
+          madara::knowledge::KnowledgeUpdateSettings());
+
+      /**
+       * Publishes cells written with broadcast settings to the knowledge
+       * base and refreshes all other cells of the published tiles. Tiles
+       * that were not written are refreshed on their next read. Cells of
+       * a tile that were not written keep the knowledge base values, so concurrent writers of different cells in
+       * a tile do not overwrite each other until both have synced.
+       * In delta mode, publishes changed cells as one encoded delta and
+       * merges deltas received from other senders.
+       * @param settings  settings to use for publishing tiles
+       * @return the number of tiles published
+       **/
+      size_t sync (const madara::knowledge::KnowledgeUpdateSettings& settings =
+          madara::knowledge::KnowledgeUpdateSettings());
+
       /**
        * Initializes the variables
        * @param name      name of the sensor
@@ -202,12 +293,95 @@ namespace gams
 
     protected:
       /**
-       * Convert index position to string index
-       * @param pos   gps position
-       * @return string index into map
+       * A square block of sensor cells and its knowledge base record
+       **/
+      struct Tile
+      {
+        /// cell values in row-major order (y * TILE_SIZE + x)
+        std::vector <double> values;
+
+        /// reference to the tile record in the knowledge base
+        madara::knowledge::VariableReference ref;
+
+        /// clock of the record when last published or read
+        uint64_t clock;
+
+        /// true if any cell in changed is set
+        bool dirty;
+
+        /// cells written with broadcast settings since the last sync
+        std::vector <bool> changed;
+
+        /// true if this agent has ever published changes to the tile
+        bool written;
+
+        /// value of Sensor::syncs_ when the record was last checked
+        uint64_t refreshed;
+      };
+
+      /// tiles keyed by packed tile coordinates
+      typedef std::unordered_map <int64_t, Tile> Tiles;
+
+      /**
+       * Finds the tile containing an index location, loading it from the
+       * knowledge base if it is not yet held locally
+       * @param x     index along the x axis of the sensor map
+       * @param y     index along the y axis of the sensor map
+       * @return the tile containing the cell
+       **/
+      Tile & find_tile (int x, int y);
+
+      /**
+       * Gets the offset of a cell within its tile
+       * @param x     index along the x axis of the sensor map
+       * @param y     index along the y axis of the sensor map
+       * @return offset into Tile::values
+       **/
+      static size_t cell_offset (int x, int y);
+
+      /**
+       * Copies the knowledge base values of a tile into all cells that
+       * have not been changed locally
+       * @param tile     the tile to update
+       * @param record   the knowledge base record of the tile
+       **/
+      static void merge_record (Tile & tile,
+        const madara::knowledge::KnowledgeRecord & record);
+
+      /**
+       * Refreshes a tile if its record has changed in the knowledge base
+       * since it was last published or read. The record is checked in
+       * place, at most once per sync. Does nothing in delta mode.
+       * @param tile     the tile to refresh
        **/
-      std::string index_pos_to_index (const pose::Position& pos) const;
+      void refresh_tile (Tile & tile);
 
+      /**
+       * Encodes changed tiles into a delta, publishes it, and merges
+       * deltas from other senders whose records have changed since the
+       * last sync
+       * @param settings  settings to use for publishing the delta
+       * @return the number of tiles in the published delta
+       **/
+      size_t sync_deltas (
+        const madara::knowledge::KnowledgeUpdateSettings& settings);
+
+      /**
+       * Merges an encoded delta into the local grid
+       * @param buffer    encoded delta
+       * @param size      size of buffer in bytes
+       * @param sequence  sequence number of the last delta merged from
+       *                  this sender. Updated on success.
+       * @param missed    set to true if deltas were missed since the last
+       *                  merged one and the delta is not a keyframe
+       * @return true if the delta was well formed
+       **/
+      bool merge_delta (const unsigned char * buffer, size_t size,
+        uint32_t & sequence, bool & missed);
+
+      /**
+       * Regenerates the local frame if the origin has changed
+       **/
       void regenerate_local_frame (void);
 
       /**
@@ -215,8 +389,14 @@ namespace gams
        */
       void init_vars ();
 
-      /// the map of locations to sensor value
-      madara::knowledge::containers::Map value_;
+      /// local tiles of sensor values
+      Tiles tiles_;
+
+      /// the most recently accessed tile, or 0
+      Tile * last_tile_;
+
+      /// key of the most recently accessed tile
+      int64_t last_key_;
 
       /// knowledge base
       madara::knowledge::KnowledgeBase* knowledge_;
@@ -230,8 +410,35 @@ namespace gams
       /// origin for index calculations
       madara::knowledge::containers::NativeDoubleArray origin_;
 
+      /// sender name in delta mode, or empty to publish whole tiles
+      std::string delta_sender_;
+
+      /// how received delta cells are merged
+      MergePolicy merge_;
+
+      /// number of deltas between keyframes, or 0 for none
+      unsigned int keyframe_interval_;
+
+      /// sequence number of the last published delta
+      uint32_t delta_sequence_;
+
+      /// sequence number of the last merged delta by record name
+      std::map <std::string, uint32_t> delta_received_;
+
+      /// clock of the last merged delta record by record name
+      std::map <std::string, uint64_t> delta_clocks_;
+
+      /// number of keyframe requests for this sender already answered
+      madara::knowledge::KnowledgeRecord::Integer keyframe_requests_;
+
+      /// number of calls to sync, which bound how often tiles are refreshed
+      uint64_t syncs_;
+
       /// local cartesian frame
       pose::ReferenceFrame local_frame_;
+
+      /// origin that local_frame_ was generated from
+      pose::Position local_origin_;
     };
 
     /// a map of sensor names to the sensor information
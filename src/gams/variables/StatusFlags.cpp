@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+#include "StatusFlags.h"
+
+typedef  madara::knowledge::KnowledgeRecord::Integer  Integer;
+
+namespace
+{
+  const Integer BITS_MASK = 0xffffffffLL;
+}
+
+bool
+gams::variables::pack_status_flags (const StatusFlagList & flags,
+  madara::knowledge::containers::Integer & packed)
+{
+  Integer bits = 0;
+
+  for (size_t i = 0; i < flags.size (); ++i)
+  {
+    if (flags[i]->to_integer () != 0)
+      bits |= (Integer)1 << i;
+  }
+
+  const Integer current = *packed;
+
+  // the first pack publishes even if all flags are clear
+  if (current != 0 && (current & BITS_MASK) == bits)
+    return false;
+
+  packed = (((current >> 32) + 1) << 32) | bits;
+  return true;
+}
+
+bool
+gams::variables::unpack_status_flags (
+  const madara::knowledge::containers::Integer & packed,
+  const StatusFlagList & flags, Integer & last)
+{
+  const Integer current = *packed;
+
+  if (current == last)
+    return false;
+
+  for (size_t i = 0; i < flags.size (); ++i)
+  {
+    *flags[i] = (current >> i) & 1;
+  }
+
+  last = current;
+  return true;
+}
+
+void
+gams::variables::set_status_flags_local (const StatusFlagList & flags,
+  bool local)
+{
+  madara::knowledge::KnowledgeUpdateSettings settings (local);
+
+  for (size_t i = 0; i < flags.size (); ++i)
+  {
+    flags[i]->set_settings (settings);
+  }
+}
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file StatusFlags.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains helpers for packing status flags into one record
+ **/
+
+#ifndef   _GAMS_VARIABLES_STATUS_FLAGS_H_
+#define   _GAMS_VARIABLES_STATUS_FLAGS_H_
+
+#include <vector>
+
+#include "gams/GamsExport.h"
+#include "madara/knowledge/containers/Integer.h"
+
+namespace gams
+{
+  namespace variables
+  {
+    /**
+     * Status flag containers in bit order. Packed records hold a flag's
+     * bit in the low 32 bits and a version, incremented on every change,
+     * in the high 32 bits.
+     **/
+    typedef std::vector <madara::knowledge::containers::Integer *>
+      StatusFlagList;
+
+    /**
+     * Packs the flags into a record if any flag has changed since the
+     * last pack. Flags are packed as nonzero or zero.
+     * @param  flags   the flag containers in bit order
+     * @param  packed  the packed record to update
+     * @return true if the packed record changed
+     **/
+    GAMS_EXPORT bool pack_status_flags (const StatusFlagList & flags,
+      madara::knowledge::containers::Integer & packed);
+
+    /**
+     * Sets the flags from a packed record if it has changed since the
+     * last unpack
+     * @param  packed  the packed record
+     * @param  flags   the flag containers in bit order
+     * @param  last    the packed value from the last unpack. Updated.
+     * @return true if the flags were changed
+     **/
+    GAMS_EXPORT bool unpack_status_flags (
+      const madara::knowledge::containers::Integer & packed,
+      const StatusFlagList & flags,
+      madara::knowledge::KnowledgeRecord::Integer & last);
+
+    /**
+     * Sets whether changes to the flags are sent to other agents
+     * @param  flags   the flag containers
+     * @param  local   if true, changes are kept local
+     **/
+    GAMS_EXPORT void set_status_flags_local (const StatusFlagList & flags,
+      bool local);
+  }
+}
+
+#endif // _GAMS_VARIABLES_STATUS_FLAGS_H_
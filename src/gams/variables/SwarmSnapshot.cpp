@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file SwarmSnapshot.cpp
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the definition of the swarm snapshot
+ **/
+
+#include "SwarmSnapshot.h"
+
+#include <sstream>
+
+#include "madara/knowledge/ContextGuard.h"
+#include "madara/utility/Utility.h"
+#include "gams/loggers/GlobalLogger.h"
+#include "gams/time/ModelsOfComputation.h"
+
+typedef madara::knowledge::KnowledgeRecord::Integer Integer;
+
+gams::variables::SwarmSnapshot::SwarmSnapshot ()
+  : knowledge_ (0), updates_ (0), history_length_ (0)
+{
+}
+
+void
+gams::variables::SwarmSnapshot::init (
+  madara::knowledge::KnowledgeBase & knowledge,
+  const std::vector <std::string> & agent_prefixes)
+{
+  knowledge_ = &knowledge;
+
+  const size_t num_agents (agent_prefixes.size ());
+
+  prefixes = agent_prefixes;
+  ids.assign (num_agents, -1);
+  has_location.assign (num_agents, 0);
+  x.assign (num_agents, 0.0);
+  y.assign (num_agents, 0.0);
+  z.assign (num_agents, 0.0);
+  vx.assign (num_agents, 0.0);
+  vy.assign (num_agents, 0.0);
+  vz.assign (num_agents, 0.0);
+  rx.assign (num_agents, 0.0);
+  ry.assign (num_agents, 0.0);
+  rz.assign (num_agents, 0.0);
+  location_clocks.assign (num_agents, 0);
+  trajectories.assign (history_length_ > 0 ? num_agents : 0,
+    Trajectory (history_length_));
+
+  location_refs_.resize (num_agents);
+  velocity_refs_.resize (num_agents);
+  orientation_refs_.resize (num_agents);
+  indices_.clear ();
+
+  for (size_t i = 0; i < num_agents; ++i)
+  {
+    const std::string & prefix = prefixes[i];
+
+    location_refs_[i] = knowledge.get_ref (prefix + ".location");
+    velocity_refs_[i] = knowledge.get_ref (prefix + ".velocity");
+    orientation_refs_[i] = knowledge.get_ref (prefix + ".orientation");
+    indices_[prefix] = i;
+
+    if (madara::utility::begins_with (prefix, "agent."))
+    {
+      std::stringstream buffer (prefix.substr (6));
+      Integer id;
+
+      if (buffer >> id && buffer.eof ())
+      {
+        ids[i] = id;
+      }
+    }
+  }
+
+  madara_logger_ptr_log (gams::loggers::global_logger.get (),
+    gams::loggers::LOG_MAJOR,
+    "gams::variables::SwarmSnapshot::init:" \
+    " tracking %d agents\n", (int)num_agents);
+}
+
+void
+gams::variables::SwarmSnapshot::init (
+  madara::knowledge::KnowledgeBase & knowledge,
+  const Agents & agents)
+{
+  std::vector <std::string> agent_prefixes (agents.size ());
+
+  for (size_t i = 0; i < agents.size (); ++i)
+  {
+    agent_prefixes[i] = agents[i].prefix;
+  }
+
+  init (knowledge, agent_prefixes);
+}
+
+size_t
+gams::variables::SwarmSnapshot::copy_ (
+  const madara::knowledge::KnowledgeRecord & record, size_t index,
+  std::vector <double> & first, std::vector <double> & second,
+  std::vector <double> & third)
+{
+  size_t values = record.size ();
+
+  first[index] = values > 0 ? record.retrieve_index (0).to_double () : 0.0;
+  second[index] = values > 1 ? record.retrieve_index (1).to_double () : 0.0;
+  third[index] = values > 2 ? record.retrieve_index (2).to_double () : 0.0;
+
+  return values;
+}
+
+void
+gams::variables::SwarmSnapshot::update (void)
+{
+  if (knowledge_)
+  {
+    madara::knowledge::ContextGuard guard (*knowledge_);
+
+    const double now = history_length_ > 0 ?
+      gams::time::VirtualClock::seconds () : 0.0;
+
+    for (size_t i = 0; i < prefixes.size (); ++i)
+    {
+      madara::knowledge::KnowledgeRecord location (
+        knowledge_->get (location_refs_[i]));
+
+      has_location[i] = copy_ (location, i, x, y, z) >= 2 ? 1 : 0;
+
+      // only new locations are added to the history
+      if (history_length_ > 0 && has_location[i] &&
+        (location.clock != location_clocks[i] ||
+         trajectories[i].size () == 0))
+      {
+        trajectories[i].add (now, x[i], y[i], z[i]);
+      }
+
+      location_clocks[i] = location.clock;
+
+      copy_ (knowledge_->get (velocity_refs_[i]), i, vx, vy, vz);
+      copy_ (knowledge_->get (orientation_refs_[i]), i, rx, ry, rz);
+    }
+
+    ++updates_;
+  }
+}
+
+size_t
+gams::variables::SwarmSnapshot::size (void) const
+{
+  return prefixes.size ();
+}
+
+int
+gams::variables::SwarmSnapshot::find (const std::string & prefix) const
+{
+  std::map <std::string, size_t>::const_iterator found =
+    indices_.find (prefix);
+
+  return found != indices_.end () ? (int)found->second : -1;
+}
+
+uint64_t
+gams::variables::SwarmSnapshot::get_updates (void) const
+{
+  return updates_;
+}
+
+void
+gams::variables::SwarmSnapshot::set_history_length (size_t length)
+{
+  history_length_ = length;
+  trajectories.assign (length > 0 ? prefixes.size () : 0,
+    Trajectory (length));
+}
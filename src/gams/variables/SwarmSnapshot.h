@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file SwarmSnapshot.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a struct-of-arrays snapshot of agent state
+ **/
+
+#ifndef   _GAMS_VARIABLES_SWARM_SNAPSHOT_H_
+#define   _GAMS_VARIABLES_SWARM_SNAPSHOT_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gams/GamsExport.h"
+#include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/VariableReference.h"
+#include "Agent.h"
+#include "Trajectory.h"
+
+namespace gams
+{
+  namespace variables
+  {
+    /**
+     * A copy of the location, velocity and orientation of a set of agents,
+     * stored as contiguous arrays indexed by agent. Knowledge base
+     * references are resolved once in init, and update copies every agent
+     * under a single context lock, so peer-wide computations can iterate
+     * over plain arrays instead of dereferencing one container per agent.
+     *
+     * Values of agents that have not published a field are 0, and
+     * has_location is 0 for agents without a location.
+     **/
+    class GAMS_EXPORT SwarmSnapshot
+    {
+    public:
+      /**
+       * Constructor
+       **/
+      SwarmSnapshot ();
+
+      /**
+       * Sets the agents in the snapshot
+       * @param  knowledge  the knowledge base containing the agents
+       * @param  prefixes   the agent prefixes (e.g., agent.0)
+       **/
+      void init (madara::knowledge::KnowledgeBase & knowledge,
+        const std::vector <std::string> & prefixes);
+
+      /**
+       * Sets the agents in the snapshot
+       * @param  knowledge  the knowledge base containing the agents
+       * @param  agents     the agents to copy
+       **/
+      void init (madara::knowledge::KnowledgeBase & knowledge,
+        const Agents & agents);
+
+      /**
+       * Copies the current state of every agent. Takes the context lock,
+       * which may already be held by the caller.
+       **/
+      void update (void);
+
+      /**
+       * Returns the number of agents in the snapshot
+       * @return  the number of agents
+       **/
+      size_t size (void) const;
+
+      /**
+       * Finds the index of an agent
+       * @param  prefix   the agent prefix (e.g., agent.0)
+       * @return  the index of the agent or -1 if it is not in the snapshot
+       **/
+      int find (const std::string & prefix) const;
+
+      /**
+       * Returns the number of times update has been called
+       * @return  the number of updates
+       **/
+      uint64_t get_updates (void) const;
+
+      /**
+       * Sets the number of locations to keep per agent in trajectories.
+       * Existing histories are cleared.
+       * @param  length   the number of locations, or 0 to keep none
+       **/
+      void set_history_length (size_t length);
+
+      /// the agent prefixes
+      std::vector <std::string> prefixes;
+
+      /// the agent ids parsed from agent.{id} prefixes, or -1
+      std::vector <madara::knowledge::KnowledgeRecord::Integer> ids;
+
+      /// 1 if the agent has a location of at least two values
+      std::vector <unsigned char> has_location;
+
+      /// the first location coordinate (e.g., longitude)
+      std::vector <double> x;
+
+      /// the second location coordinate (e.g., latitude)
+      std::vector <double> y;
+
+      /// the third location coordinate (e.g., altitude)
+      std::vector <double> z;
+
+      /// the first velocity component
+      std::vector <double> vx;
+
+      /// the second velocity component
+      std::vector <double> vy;
+
+      /// the third velocity component
+      std::vector <double> vz;
+
+      /// the first orientation component
+      std::vector <double> rx;
+
+      /// the second orientation component
+      std::vector <double> ry;
+
+      /// the third orientation component
+      std::vector <double> rz;
+
+      /// the Lamport clock of the last location update
+      std::vector <uint64_t> location_clocks;
+
+      /**
+       * the recent locations of each agent, timestamped with
+       * gams::time::VirtualClock when update first saw them. Empty unless
+       * a history length is set.
+       **/
+      Trajectories trajectories;
+
+    protected:
+      /**
+       * Copies up to three values of a record into arrays
+       * @param  record   the record to copy
+       * @param  index    the agent index
+       * @param  first    the array for the first value
+       * @param  second   the array for the second value
+       * @param  third    the array for the third value
+       * @return  the number of values in the record
+       **/
+      static size_t copy_ (const madara::knowledge::KnowledgeRecord & record,
+        size_t index, std::vector <double> & first,
+        std::vector <double> & second, std::vector <double> & third);
+
+      /// the knowledge base containing the agents
+      madara::knowledge::KnowledgeBase * knowledge_;
+
+      /// references to agent locations
+      std::vector <madara::knowledge::VariableReference> location_refs_;
+
+      /// references to agent velocities
+      std::vector <madara::knowledge::VariableReference> velocity_refs_;
+
+      /// references to agent orientations
+      std::vector <madara::knowledge::VariableReference> orientation_refs_;
+
+      /// maps agent prefixes to indices
+      std::map <std::string, size_t> indices_;
+
+      /// the number of updates
+      uint64_t updates_;
+
+      /// the number of locations kept per agent
+      size_t history_length_;
+    };
+  }
+}
+
+#endif // _GAMS_VARIABLES_SWARM_SNAPSHOT_H_
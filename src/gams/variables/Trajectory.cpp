@@ -0,0 +1,267 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file Trajectory.cpp
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains the definition of the trajectory history
+ **/
+
+#include "Trajectory.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // second differences amplify jitter in the sample times, so the
+  // acceleration is only estimated if the two intervals differ by at most
+  // this fraction of the longer one
+  const double MAX_SPACING_JITTER = 0.25;
+}
+
+gams::variables::Trajectory::Trajectory (size_t capacity)
+  : samples_ (capacity), start_ (0), size_ (0)
+{
+}
+
+void
+gams::variables::Trajectory::set_capacity (size_t capacity)
+{
+  samples_.assign (capacity, TrajectorySample ());
+  clear ();
+}
+
+size_t
+gams::variables::Trajectory::capacity (void) const
+{
+  return samples_.size ();
+}
+
+size_t
+gams::variables::Trajectory::size (void) const
+{
+  return size_;
+}
+
+void
+gams::variables::Trajectory::clear (void)
+{
+  start_ = 0;
+  size_ = 0;
+}
+
+void
+gams::variables::Trajectory::add (double time, double x, double y, double z)
+{
+  if (samples_.empty ())
+    return;
+
+  TrajectorySample sample = { time, x, y, z };
+
+  if (size_ > 0)
+  {
+    TrajectorySample & newest =
+      samples_[(start_ + size_ - 1) % samples_.size ()];
+
+    if (time < newest.time)
+    {
+      return;
+    }
+    else if (time == newest.time)
+    {
+      newest = sample;
+      return;
+    }
+  }
+
+  if (size_ < samples_.size ())
+  {
+    samples_[(start_ + size_) % samples_.size ()] = sample;
+    ++size_;
+  }
+  else
+  {
+    samples_[start_] = sample;
+    start_ = (start_ + 1) % samples_.size ();
+  }
+}
+
+const gams::variables::TrajectorySample &
+gams::variables::Trajectory::get (size_t index) const
+{
+  return samples_[(start_ + index) % samples_.size ()];
+}
+
+const gams::variables::TrajectorySample &
+gams::variables::Trajectory::back (void) const
+{
+  return get (size_ - 1);
+}
+
+bool
+gams::variables::Trajectory::interpolate (double time,
+  double & x, double & y, double & z) const
+{
+  if (size_ == 0 || time < get (0).time || time > back ().time)
+    return false;
+
+  // find the first sample at or after time
+  size_t low = 0;
+  size_t high = size_ - 1;
+  while (low < high)
+  {
+    size_t middle = low + (high - low) / 2;
+    if (get (middle).time < time)
+      low = middle + 1;
+    else
+      high = middle;
+  }
+
+  const TrajectorySample & after = get (low);
+  if (low == 0 || after.time == time)
+  {
+    x = after.x;
+    y = after.y;
+    z = after.z;
+    return true;
+  }
+
+  const TrajectorySample & before = get (low - 1);
+  const double ratio = (time - before.time) / (after.time - before.time);
+
+  x = before.x + (after.x - before.x) * ratio;
+  y = before.y + (after.y - before.y) * ratio;
+  z = before.z + (after.z - before.z) * ratio;
+  return true;
+}
+
+bool
+gams::variables::Trajectory::velocity (
+  double & vx, double & vy, double & vz) const
+{
+  if (size_ < 2)
+    return false;
+
+  const TrajectorySample & last = back ();
+  const TrajectorySample & previous = get (size_ - 2);
+  const double dt = last.time - previous.time;
+
+  // the difference is the velocity halfway between the two samples
+  vx = (last.x - previous.x) / dt;
+  vy = (last.y - previous.y) / dt;
+  vz = (last.z - previous.z) / dt;
+
+  double ax, ay, az;
+  if (acceleration (ax, ay, az))
+  {
+    vx += ax * dt / 2;
+    vy += ay * dt / 2;
+    vz += az * dt / 2;
+  }
+
+  return true;
+}
+
+bool
+gams::variables::Trajectory::acceleration (
+  double & ax, double & ay, double & az) const
+{
+  if (size_ < 3)
+    return false;
+
+  const TrajectorySample & s2 = back ();
+  const TrajectorySample & s1 = get (size_ - 2);
+  const TrajectorySample & s0 = get (size_ - 3);
+
+  const double dt1 = s1.time - s0.time;
+  const double dt2 = s2.time - s1.time;
+  const double span = (s2.time - s0.time) / 2;
+
+  if (dt1 <= 0 || dt2 <= 0 ||
+    std::fabs (dt2 - dt1) > MAX_SPACING_JITTER * std::max (dt1, dt2))
+    return false;
+
+  ax = ((s2.x - s1.x) / dt2 - (s1.x - s0.x) / dt1) / span;
+  ay = ((s2.y - s1.y) / dt2 - (s1.y - s0.y) / dt1) / span;
+  az = ((s2.z - s1.z) / dt2 - (s1.z - s0.z) / dt1) / span;
+
+  return true;
+}
+
+bool
+gams::variables::Trajectory::extrapolate (double time,
+  double & x, double & y, double & z) const
+{
+  if (size_ == 0)
+    return false;
+
+  const TrajectorySample & last = back ();
+  const double dt = time - last.time;
+
+  x = last.x;
+  y = last.y;
+  z = last.z;
+
+  double vx, vy, vz;
+  if (velocity (vx, vy, vz))
+  {
+    x += vx * dt;
+    y += vy * dt;
+    z += vz * dt;
+
+    double ax, ay, az;
+    if (acceleration (ax, ay, az))
+    {
+      x += ax * dt * dt / 2;
+      y += ay * dt * dt / 2;
+      z += az * dt * dt / 2;
+    }
+  }
+
+  return true;
+}
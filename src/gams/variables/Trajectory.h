@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file Trajectory.h
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a fixed-capacity history of timestamped locations
+ **/
+
+#ifndef   _GAMS_VARIABLES_TRAJECTORY_H_
+#define   _GAMS_VARIABLES_TRAJECTORY_H_
+
+#include <vector>
+
+#include "gams/GamsExport.h"
+
+namespace gams
+{
+  namespace variables
+  {
+    /**
+     * A timestamped location
+     **/
+    struct TrajectorySample
+    {
+      /// the time of the sample, in seconds
+      double time;
+
+      /// the first location coordinate
+      double x;
+
+      /// the second location coordinate
+      double y;
+
+      /// the third location coordinate
+      double z;
+    };
+
+    /**
+     * A ring buffer of the most recent locations of an agent, ordered by
+     * time. Adding a sample is O(1) and looking up a time is O(log n).
+     * Velocity and acceleration are estimated by finite differences of
+     * the newest samples, in location units per second.
+     **/
+    class GAMS_EXPORT Trajectory
+    {
+    public:
+      /**
+       * Constructor
+       * @param  capacity  the maximum number of samples to keep
+       **/
+      Trajectory (size_t capacity = 0);
+
+      /**
+       * Sets the maximum number of samples and clears the history
+       * @param  capacity  the maximum number of samples to keep
+       **/
+      void set_capacity (size_t capacity);
+
+      /**
+       * Returns the maximum number of samples
+       * @return  the capacity
+       **/
+      size_t capacity (void) const;
+
+      /**
+       * Returns the number of samples
+       * @return  the number of samples
+       **/
+      size_t size (void) const;
+
+      /**
+       * Removes all samples
+       **/
+      void clear (void);
+
+      /**
+       * Adds a sample, overwriting the oldest one if full. Samples older
+       * than the newest sample are ignored, and a sample at the same time
+       * as the newest replaces it.
+       * @param  time   the time of the sample, in seconds
+       * @param  x      the first location coordinate
+       * @param  y      the second location coordinate
+       * @param  z      the third location coordinate
+       **/
+      void add (double time, double x, double y, double z);
+
+      /**
+       * Returns a sample
+       * @param  index  0 for the oldest sample up to size () - 1
+       * @return  the sample
+       **/
+      const TrajectorySample & get (size_t index) const;
+
+      /**
+       * Returns the newest sample. The history must not be empty.
+       * @return  the newest sample
+       **/
+      const TrajectorySample & back (void) const;
+
+      /**
+       * Linearly interpolates the location at a time within the history
+       * @param  time   the time, in seconds
+       * @param  x      the first location coordinate
+       * @param  y      the second location coordinate
+       * @param  z      the third location coordinate
+       * @return  false if the time is outside of the history
+       **/
+      bool interpolate (double time, double & x, double & y, double & z)
+        const;
+
+      /**
+       * Estimates the velocity at the newest sample
+       * @param  vx     the first velocity component
+       * @param  vy     the second velocity component
+       * @param  vz     the third velocity component
+       * @return  false if there are fewer than two samples
+       **/
+      bool velocity (double & vx, double & vy, double & vz) const;
+
+      /**
+       * Estimates the acceleration at the newest sample
+       * @param  ax     the first acceleration component
+       * @param  ay     the second acceleration component
+       * @param  az     the third acceleration component
+       * @return  false if there are fewer than three samples, or if the
+       *          intervals between the newest three differ by more than a
+       *          quarter, which would make the estimate dominated by noise
+       **/
+      bool acceleration (double & ax, double & ay, double & az) const;
+
+      /**
+       * Predicts the location at a time after the newest sample using the
+       * estimated velocity and, if available, acceleration
+       * @param  time   the time, in seconds
+       * @param  x      the first location coordinate
+       * @param  y      the second location coordinate
+       * @param  z      the third location coordinate
+       * @return  false if the history is empty
+       **/
+      bool extrapolate (double time, double & x, double & y, double & z)
+        const;
+
+    protected:
+      /// the samples, starting at start_
+      std::vector <TrajectorySample> samples_;
+
+      /// the index of the oldest sample in samples_
+      size_t start_;
+
+      /// the number of samples
+      size_t size_;
+    };
+
+    /// a list of agent trajectories
+    typedef std::vector <Trajectory> Trajectories;
+  }
+}
+
+#endif // _GAMS_VARIABLES_TRAJECTORY_H_
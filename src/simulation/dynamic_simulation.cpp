@@ -654,7 +654,8 @@ void create_environment (const int& client_id,
       {
         SearchArea search;
         search.from_container (knowledge, regions[i]);
-        vector<PrioritizedRegion> search_regions = search.get_regions ();
+        const vector<PrioritizedRegion>& search_regions =
+          search.get_regions ();
         for (size_t j = 0; j < search_regions.size (); ++j)
           put_border (knowledge, search_regions[j], client_id);
       }
@@ -771,6 +772,8 @@ time_to_full_coverage (madara::knowledge::KnowledgeBase& knowledge,
     {
       madara::utility::sleep (1);
 
+      coverage_sensor.sync ();
+
       num_not_covered = 0;
       for (set<Position>::const_iterator it = valid_positions.begin ();
         it != valid_positions.end (); ++it)
@@ -53,6 +53,8 @@
 
 #include "madara/knowledge/KnowledgeBase.h"
 #include "gams/controllers/BaseController.h"
+#include "gams/algorithms/BaseAlgorithm.h"
+#include "gams/variables/Sensor.h"
 #include "madara/logger/GlobalLogger.h"
 
 // default transport settings
@@ -268,6 +270,105 @@ void handle_arguments (int argc, char ** argv)
   }
 }
 
+// re-commanding an algorithm that cannot be reset must start it over
+void test_recommanded_move (void)
+{
+  engine::KnowledgeBase knowledge;
+
+  controllers::ControllerSettings settings;
+  settings.algorithm_cache_size = 4;
+  controllers::BaseController loop (knowledge, settings);
+
+  loop.init_vars (0, 1);
+  loop.init_platform ("debug");
+  loop.init_algorithm ("move");
+
+  gams::algorithms::BaseAlgorithm * move = loop.get_algorithm ();
+
+  if (move)
+  {
+    move->get_algorithm_status ()->finished = 1;
+  }
+
+  loop.init_algorithm ("debug");
+  loop.init_algorithm ("move");
+
+  move = loop.get_algorithm ();
+
+  if (move && move->get_algorithm_status ()->finished.is_false ())
+  {
+    std::cerr << "SUCCESS: re-commanded move was not finished\n";
+  }
+  else
+  {
+    std::cerr << "FAIL: re-commanded move was reused after finishing\n";
+    ++gams_fails;
+  }
+}
+
+void test_lazy_agents (void)
+{
+  engine::KnowledgeBase knowledge;
+
+  controllers::ControllerSettings settings;
+  settings.lazy_agents = true;
+  controllers::BaseController loop (knowledge, settings);
+
+  loop.init_vars (0, 3);
+  loop.init_platform ("debug");
+  loop.init_algorithm ("debug");
+
+  gams::algorithms::BaseAlgorithm * algorithm = loop.get_algorithm ();
+  gams::variables::Agent * agent = algorithm ? algorithm->get_agent (2) : 0;
+
+  if (agent && agent->location.get_name () == "agent.2.location" &&
+    algorithm->get_agent (3) == 0)
+  {
+    std::cerr << "SUCCESS: lazy agents are bound through get_agent\n";
+  }
+  else
+  {
+    std::cerr << "FAIL: lazy agents are not bound through get_agent\n";
+    ++gams_fails;
+  }
+}
+
+void test_sensor_sync (void)
+{
+  engine::KnowledgeBase knowledge_a, knowledge_b;
+  gams::variables::Sensor sensor_a ("coverage", &knowledge_a, 2.5);
+  gams::variables::Sensor sensor_b ("coverage", &knowledge_b, 2.5);
+
+  controllers::BaseController loop_a (knowledge_a);
+  controllers::BaseController loop_b (knowledge_b);
+
+  loop_a.init_vars (0, 2);
+  loop_b.init_vars (1, 2);
+  (*loop_a.get_sensors ())["coverage"] = &sensor_a;
+  (*loop_b.get_sensors ())["coverage"] = &sensor_b;
+
+  bool unset = sensor_b.get_index_value (3, 4) == 0.0;
+
+  // an algorithm marks a cell as covered
+  sensor_a.set_index_value (3, 4, 1.5);
+  loop_a.run_once ();
+
+  // deliver the tile record as the transport would
+  const std::string tile ("sensor.coverage.tiles.0x0");
+  knowledge_b.set (tile, knowledge_a.get (tile).to_doubles ());
+  loop_b.run_once ();
+
+  if (unset && sensor_b.get_index_value (3, 4) == 1.5)
+  {
+    std::cerr << "SUCCESS: sensor values written by an agent reach peers\n";
+  }
+  else
+  {
+    std::cerr << "FAIL: sensor values written by an agent are not sent\n";
+    ++gams_fails;
+  }
+}
+
 // perform main logic of program
 int main (int argc, char ** argv)
 {
@@ -299,6 +400,10 @@ int main (int argc, char ** argv)
     knowledge.print ("SUCCESS: {.executions} is not enough to pass\n");
     ++gams_fails;
   }
+
+  test_recommanded_move ();
+  test_lazy_agents ();
+  test_sensor_sync ();
   
   if (gams_fails > 0)
   {
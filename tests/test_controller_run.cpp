@@ -53,9 +53,16 @@
 
 #include <iostream>
 #include <iomanip>
+#include <thread>
 
 #include "madara/knowledge/KnowledgeBase.h"
+#include "madara/knowledge/ContextGuard.h"
 #include "gams/controllers/BaseController.h"
+#include "gams/controllers/TriggerWatcher.h"
+#include "gams/controllers/ControllerSettings.h"
+#include "gams/algorithms/AlgorithmFactoryRepository.h"
+#include "gams/algorithms/BaseAlgorithm.h"
+#include "gams/time/ModelsOfComputation.h"
 
 #include "helper/CounterAlgorithm.h"
 #include "helper/CounterPlatform.h"
@@ -86,6 +93,76 @@ std::map <double, std::string> normal_status;
 
 int gams_fails = 0;
 
+/**
+ * Accent that counts its phases under its own prefix and declares that
+ * prefix as its only write, so that it can run concurrently
+ **/
+class CountingAccent : public algorithms::BaseAlgorithm
+{
+public:
+  CountingAccent (engine::KnowledgeBase * knowledge, const std::string & name)
+    : BaseAlgorithm (knowledge), prefix_ (".accent." + name)
+  {
+    analyzes_.set_name (prefix_ + ".analyzes", *knowledge);
+    plans_.set_name (prefix_ + ".plans", *knowledge);
+    executes_.set_name (prefix_ + ".executes", *knowledge);
+  }
+
+  virtual int analyze (void)
+  {
+    ++analyzes_;
+    return 0;
+  }
+
+  virtual int plan (void)
+  {
+    ++plans_;
+    return 0;
+  }
+
+  virtual int execute (void)
+  {
+    ++executes_;
+    return 0;
+  }
+
+  virtual bool get_access_sets (std::vector <std::string> & reads,
+    std::vector <std::string> & writes) const
+  {
+    reads.clear ();
+    writes.clear ();
+    writes.push_back (prefix_);
+    return true;
+  }
+
+private:
+  std::string prefix_;
+  madara::knowledge::containers::Integer analyzes_;
+  madara::knowledge::containers::Integer plans_;
+  madara::knowledge::containers::Integer executes_;
+};
+
+/**
+ * Factory for counting accents. The name argument sets the prefix.
+ **/
+class CountingAccentFactory : public algorithms::AlgorithmFactory
+{
+public:
+  virtual algorithms::BaseAlgorithm * create (
+    const engine::KnowledgeMap & args,
+    engine::KnowledgeBase * knowledge,
+    platforms::BasePlatform * /*platform*/,
+    gams::variables::Sensors * /*sensors*/,
+    gams::variables::Self * /*self*/,
+    gams::variables::Agents * /*agents*/)
+  {
+    engine::KnowledgeMap::const_iterator name = args.find ("name");
+
+    return new CountingAccent (knowledge,
+      name != args.end () ? name->second.to_string () : "0");
+  }
+};
+
 Record
 to_legible_hertz (engine::FunctionArguments & args, engine::Variables & /*vars*/)
 {
@@ -207,6 +284,269 @@ test_hz (engine::KnowledgeBase & knowledge,
   }
 }
 
+void
+test_scheduled (engine::KnowledgeBase & knowledge,
+  controllers::BaseController & loop, int policy, double hz, double duration)
+{
+  controllers::ControllerSettings settings;
+  settings.scheduler_policy = policy;
+  loop.configure (settings);
+
+  algorithm->reset_counters ();
+  std::cerr << "Testing " << duration << "s experiment with "
+    << hz << "hz and scheduler policy " << policy << ".\n";
+  loop.run_hz (hz, duration);
+  knowledge.set (".loops", algorithm->loops);
+  knowledge.set (".expected", (Integer)(hz * duration));
+  knowledge.print (
+    "  Results: {.loops} loops, {.agent.0.loop.skipped} skipped,"
+    " {.agent.0.loop.overruns} overruns, max jitter"
+    " {.agent.0.loop.max_jitter}s\n");
+
+  // every release on the grid is either executed or skipped
+  Integer releases = algorithm->loops +
+    knowledge.get (".agent.0.loop.skipped").to_integer ();
+
+  if (algorithm->loops > 0 &&
+    releases >= (Integer)(hz * duration) - 2 &&
+    releases <= (Integer)(hz * duration) + 2)
+  {
+    knowledge.print (
+      "  SUCCESS: loops + skipped == {.expected} releases\n");
+  }
+  else
+  {
+    knowledge.print (
+      "  FAIL: loops + skipped != {.expected} releases\n");
+    ++gams_fails;
+  }
+
+  loop.configure (controllers::ControllerSettings ());
+}
+
+void
+test_virtual_time (engine::KnowledgeBase & knowledge,
+  controllers::BaseController & loop, double hz, double duration)
+{
+  controllers::ControllerSettings settings;
+  settings.virtual_time = true;
+  loop.configure (settings);
+
+  algorithm->reset_counters ();
+  std::cerr << "Testing " << duration << "s virtual experiment with "
+    << hz << "hz.\n";
+
+  double virtual_start = gams::time::VirtualClock::seconds ();
+  madara::utility::TimeValue wall_start = madara::utility::Clock::now ();
+
+  gams::time::EpochEnforcer timeout (duration / 2, duration / 2);
+
+  loop.run_hz (hz, duration);
+
+  double wall_time = std::chrono::duration<double> (
+    madara::utility::Clock::now () - wall_start).count ();
+  double virtual_time = gams::time::VirtualClock::seconds () - virtual_start;
+
+  knowledge.set (".loops", algorithm->loops);
+  knowledge.set (".expected", (Integer)(hz * duration));
+  knowledge.set (".wall_time", wall_time);
+  knowledge.set (".virtual_time", virtual_time);
+  knowledge.print (
+    "  Results: {.loops} loops in {.virtual_time}s of virtual time"
+    " and {.wall_time}s of wall time\n");
+
+  // every round is executed, and timers follow the virtual clock
+  if (algorithm->loops >= (Integer)(hz * duration) &&
+    algorithm->loops <= (Integer)(hz * duration) + 1 &&
+    timeout.is_done () && wall_time < duration)
+  {
+    knowledge.print (
+      "  SUCCESS: {.loops} ~= {.expected} loops faster than real time\n");
+  }
+  else
+  {
+    knowledge.print (
+      "  FAIL: {.loops} != {.expected} loops or timeout not reached\n");
+    ++gams_fails;
+  }
+
+  gams::time::VirtualClock::disable ();
+  loop.configure (controllers::ControllerSettings ());
+}
+void
+test_idle_triggers (engine::KnowledgeBase & knowledge,
+  controllers::BaseController & loop, double duration)
+{
+  std::cerr << "Testing " << duration << "s idle wait on triggers.\n";
+
+  controllers::TriggerWatcher watcher (knowledge);
+  watcher.add (".idle_trigger");
+
+  // nothing updates the knowledge base, so only the deadline wakes us
+  bool triggered = watcher.wait (madara::utility::Clock::now () +
+    madara::utility::seconds_to_duration (duration));
+
+  knowledge.set (".wakeups", (Integer)watcher.get_wakeups ());
+  knowledge.print ("  Results: {.wakeups} wakeups while idle\n");
+
+  if (!triggered && watcher.get_wakeups () <= 2)
+  {
+    knowledge.print ("  SUCCESS: idle watcher woke {.wakeups} times\n");
+  }
+  else
+  {
+    knowledge.print ("  FAIL: idle watcher woke {.wakeups} times\n");
+    ++gams_fails;
+  }
+
+  // an update from another thread ends the wait well before the deadline
+  std::thread writer ([&knowledge] {
+    madara::utility::sleep (0.1);
+    knowledge.set (".idle_trigger", (Integer)1);
+  });
+
+  madara::utility::TimeValue start = madara::utility::Clock::now ();
+  triggered = watcher.wait (start +
+    madara::utility::seconds_to_duration (duration));
+  double waited = std::chrono::duration<double> (
+    madara::utility::Clock::now () - start).count ();
+
+  writer.join ();
+
+  knowledge.set (".waited", waited);
+
+  if (triggered && waited < duration / 2)
+  {
+    knowledge.print ("  SUCCESS: trigger woke watcher after {.waited}s\n");
+  }
+  else
+  {
+    knowledge.print ("  FAIL: trigger did not wake watcher ({.waited}s)\n");
+    ++gams_fails;
+  }
+
+  // an idle triggered controller only runs for its sends
+  controllers::ControllerSettings settings;
+  settings.wait_for_triggers = true;
+  settings.trigger_variables.push_back (".idle_trigger");
+  settings.max_trigger_wait = duration;
+  loop.configure (settings);
+
+  algorithm->reset_counters ();
+  loop.run_hz (100.0, duration, 1.0);
+
+  knowledge.set (".loops", algorithm->loops);
+  knowledge.print (
+    "  Results: {.loops} loops, {.agent.0.loop.wakeups} wakeups and"
+    " {.agent.0.loop.timeouts} timeouts while idle\n");
+
+  if (algorithm->loops <= (Integer)duration + 2 &&
+    knowledge.get (".agent.0.loop.wakeups").to_integer () == 0)
+  {
+    knowledge.print (
+      "  SUCCESS: idle controller ran {.loops} times at 100hz\n");
+  }
+  else
+  {
+    knowledge.print (
+      "  FAIL: idle controller ran {.loops} times at 100hz\n");
+    ++gams_fails;
+  }
+
+  loop.configure (controllers::ControllerSettings ());
+}
+
+void
+test_concurrent_accents (engine::KnowledgeBase & knowledge,
+  controllers::BaseController & loop, double hz, double duration)
+{
+  std::vector <std::string> aliases;
+  aliases.push_back ("counting_accent");
+  algorithms::global_algorithm_factory ()->add (
+    aliases, new CountingAccentFactory ());
+
+  controllers::ControllerSettings settings;
+  settings.accent_threads = 2;
+  loop.configure (settings);
+
+  engine::KnowledgeMap args;
+  args["name"] = "a";
+  loop.init_accent ("counting_accent", args);
+  args["name"] = "b";
+  loop.init_accent ("counting_accent", args);
+
+  algorithm->reset_counters ();
+  std::cerr << "Testing " << duration << "s experiment with "
+    << hz << "hz and two concurrent accents.\n";
+  loop.run_hz (hz, duration);
+
+  knowledge.set (".loops", algorithm->loops);
+  knowledge.print (
+    "  Results: {.loops} loops, accent a ran {.accent.a.analyzes}/"
+    "{.accent.a.plans}/{.accent.a.executes} and accent b ran"
+    " {.accent.b.analyzes}/{.accent.b.plans}/{.accent.b.executes}\n");
+
+  // every cycle ran each phase of both accents exactly once
+  bool success = algorithm->loops > 0;
+  const char * accents[] = { ".accent.a", ".accent.b" };
+
+  for (int i = 0; i < 2; ++i)
+  {
+    const std::string prefix (accents[i]);
+    success = success &&
+      knowledge.get (prefix + ".analyzes").to_integer () == algorithm->loops &&
+      knowledge.get (prefix + ".plans").to_integer () == algorithm->loops &&
+      knowledge.get (prefix + ".executes").to_integer () == algorithm->loops;
+  }
+
+  if (success)
+  {
+    knowledge.print (
+      "  SUCCESS: concurrent accents ran once per cycle\n");
+  }
+  else
+  {
+    knowledge.print (
+      "  FAIL: concurrent accents did not run once per cycle\n");
+    ++gams_fails;
+  }
+
+  std::cerr << "Testing run_once with two accents while the caller holds"
+    " the context.\n";
+
+  Integer before = knowledge.get (".accent.a.executes").to_integer ();
+
+  {
+    // the accents run in order on this thread, so this cannot deadlock
+    madara::knowledge::ContextGuard guard (knowledge);
+
+    for (int i = 0; i < 5; ++i)
+    {
+      loop.run_once ();
+    }
+  }
+
+  knowledge.set (".runs",
+    knowledge.get (".accent.a.executes").to_integer () - before);
+
+  if (knowledge.get (".runs").to_integer () == 5 &&
+    knowledge.get (".accent.b.executes").to_integer () ==
+    knowledge.get (".accent.a.executes").to_integer ())
+  {
+    knowledge.print (
+      "  SUCCESS: externally locked run_once ran accents {.runs} times\n");
+  }
+  else
+  {
+    knowledge.print (
+      "  FAIL: externally locked run_once ran accents {.runs} times\n");
+    ++gams_fails;
+  }
+
+  loop.clear_accents ();
+  loop.configure (controllers::ControllerSettings ());
+}
+
 // perform main logic of program
 int main (int /*argc*/, char ** /*argv*/)
 {
@@ -271,6 +611,35 @@ int main (int /*argc*/, char ** /*argv*/)
     test_period (knowledge, loop, period, duration);
   }
 
+  std::cerr << "*****************************************************\n";
+  std::cerr <<
+    "* Running deadline-aware scheduler\n";
+  std::cerr << "*****************************************************\n";
+
+  test_scheduled (knowledge, loop, controllers::SCHEDULE_SKIP, 100.0, 2.0);
+  test_scheduled (knowledge, loop, controllers::SCHEDULE_SKIP, 1000.0, 2.0);
+
+  std::cerr << "*****************************************************\n";
+  std::cerr <<
+    "* Running on the virtual clock\n";
+  std::cerr << "*****************************************************\n";
+
+  test_virtual_time (knowledge, loop, 10.0, 3600.0);
+
+  std::cerr << "*****************************************************\n";
+  std::cerr <<
+    "* Running on triggers\n";
+  std::cerr << "*****************************************************\n";
+
+  test_idle_triggers (knowledge, loop, 2.0);
+
+  std::cerr << "*****************************************************\n";
+  std::cerr <<
+    "* Running concurrent accents\n";
+  std::cerr << "*****************************************************\n";
+
+  test_concurrent_accents (knowledge, loop, 100.0, 2.0);
+
   if (gams_fails > 0)
   {
     std::cerr << "OVERALL: FAIL. " << gams_fails << " tests failed.\n";
@@ -5,6 +5,11 @@
 #include "gams/pose/Position.h"
 #include "gams/pose/CartesianFrame.h"
 #include "gams/pose/GPSFrame.h"
+#include "gams/pose/FrameIndex.h"
+#include "gams/pose/Region.h"
+#include "gams/pose/SearchArea.h"
+#include "gams/pose/RigidTransform.h"
+#include "gams/pose/TaggedCartesian.h"
 #include "madara/knowledge/KnowledgeBase.h"
 
 using namespace gams::pose;
@@ -55,6 +60,39 @@ double round_nearest(double in)
     } \
   } while(0)
 
+#define TEST_NEAR(expr, expect, tolerance) \
+  do {\
+    double v = (expr); \
+    double e = (expect); \
+    if(fabs(v - e) < (tolerance)) \
+    { \
+      std::cout << __LINE__ << ": " << #expr << " ?= " << e << "  SUCCESS! got " << v << std::endl; \
+    } \
+    else \
+    { \
+      std::cout << __LINE__ << ": " << #expr << " ?= " << e << "  FAIL! got " << v << " instead" << std::endl; \
+      gams_fails++; \
+    } \
+  } while(0)
+
+struct MapFrame
+{
+  static const ReferenceFrame &frame()
+  {
+    static ReferenceFrame map(Pose(default_frame(), 5, -3, 1, 0, 0, M_PI / 2));
+    return map;
+  }
+};
+
+struct BodyFrame
+{
+  static const ReferenceFrame &frame()
+  {
+    static ReferenceFrame body(Pose(MapFrame::frame(), 2, 1, 0, 0, 0, 0.5));
+    return body;
+  }
+};
+
 int main(int, char *[])
 {
   static_assert(!supports_transform_to<PositionVector>::value, "");
@@ -107,6 +145,13 @@ int main(int, char *[])
   LOG(gloc6);
   TEST(gloc6.distance_to(gloc0), EARTH_CIRC/2);
 
+  // neither point is on the equator or a pole, so the sin(lat1)*sin(lat2)
+  // term of the great circle formula matters (haversine gives 4013890.11)
+  Position gloc7(gpsframe,30,30);
+  Position gloc8(gpsframe,60,60);
+  TEST_NEAR(gloc7.distance_to(gloc8), 4013890.11, 1);
+  TEST_NEAR(gloc8.distance_to(gloc7), 4013890.11, 1);
+
   std::cout << std::endl << "Testing CartesianFrame tree:" << std::endl;
   Position gloc(gpsframe,0,90);
   ReferenceFrame cart_frame0(gloc);
@@ -640,6 +685,268 @@ int main(int, char *[])
   }
 #endif
 
+  std::cout << std::endl << "Testing cached frame chain transforms:"
+            << std::endl;
+  {
+    ReferenceFrame root{Pose{ReferenceFrame{}, 0, 0}};
+    ReferenceFrame arm{Pose{root, 3, 4, 1, 0.1, 0.2, 0.7}};
+    ReferenceFrame hand{Pose{arm, -2, 5, 0, 0, 0.3, -1.1}};
+    ReferenceFrame cart{Pose{root, 10, -4, 2, 0.5, 0, 2}};
+    ReferenceFrame cam{Pose{cart, 1, 1, 1, 0.2, -0.4, 0.3}};
+
+    Pose grip(hand, 1.5, -2, 0.3, 0.4, -0.2, 0.9);
+    Velocity speed(hand, 1, 2, 3);
+
+    ReferenceFrame::cache_transforms(false);
+    Pose grip0 = grip.transform_to(cam);
+    Velocity speed0 = speed.transform_to(cam);
+
+    ReferenceFrame::cache_transforms(true);
+    for (int i = 0; i < 2; ++i)
+    {
+      Pose grip1 = grip.transform_to(cam);
+      Velocity speed1 = speed.transform_to(cam);
+      TEST(grip1.x(), grip0.x());
+      TEST(grip1.y(), grip0.y());
+      TEST(grip1.z(), grip0.z());
+      TEST(grip1.rx(), grip0.rx());
+      TEST(grip1.ry(), grip0.ry());
+      TEST(grip1.rz(), grip0.rz());
+      TEST(speed1.dx(), speed0.dx());
+      TEST(speed1.dy(), speed0.dy());
+      TEST(speed1.dz(), speed0.dz());
+    }
+
+    ReferenceFrame::clear_transform_cache();
+  }
+
+  std::cout << std::endl << "Testing batch transforms:" << std::endl;
+  {
+    ReferenceFrame local{Pose{gps_frame(), 40.44, -79.94, 300, 0, 0, 0.4}};
+    ReferenceFrame arm{Pose{local, 3, 4, 1, 0.1, 0.2, 0.7}};
+
+    std::vector<Position> points;
+    for (int i = 0; i < 8; ++i)
+    {
+      points.push_back(Position(i % 2 ? arm : local, i * 1.5, -i, 0.3 * i));
+    }
+
+    std::vector<Position> batch(points);
+    gps_frame().transform_batch(batch);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      Position one = points[i].transform_to(gps_frame());
+      TEST(batch[i].lat(), one.lat());
+      TEST(batch[i].lng(), one.lng());
+      TEST(batch[i].alt(), one.alt());
+      TEST(batch[i].frame() == gps_frame(), 1);
+    }
+  }
+
+  std::cout << std::endl << "Testing indexed frame loading:" << std::endl;
+  {
+    madara::knowledge::KnowledgeBase ikb;
+    {
+      ReferenceFrame base("IndexBase", Pose{gps_frame(), 10, 20}, -1);
+      base.save(ikb);
+      for (int t = 1000; t <= 4000; t += 1000) {
+        ReferenceFrame("IndexDrone", Pose{base, t / 100.0, 0}, t).save(ikb);
+      }
+    }
+    ReferenceFrameIdentity::gc();
+
+    FrameIndex::enable(ikb, FrameEvalSettings::DEFAULT, 3);
+    auto index = FrameIndex::find(ikb, FrameEvalSettings::default_prefix());
+    TEST_EQ(index->size("IndexDrone"), 3UL);
+
+    ReferenceFrame base = ReferenceFrame::load(ikb, "IndexBase");
+    ReferenceFrame("IndexDrone", Pose{base, 50, 0}, 5000).save(ikb);
+    TEST_EQ(index->size("IndexDrone"), 3UL);
+
+    // 1000 and 2000 are no longer indexed; loading falls back to the kb
+    ReferenceFrame old = ReferenceFrame::load(ikb, "IndexDrone", 1500);
+    TEST(old.origin().x(), 15);
+    TEST_EQ(old.interpolated(), true);
+
+    ReferenceFrame recent = ReferenceFrame::load(ikb, "IndexDrone", 3500);
+    TEST(recent.origin().x(), 35);
+    TEST_EQ(recent.origin_frame().id(), std::string("IndexBase"));
+
+    TEST(ReferenceFrame::load(ikb, "IndexDrone").origin().x(), 50);
+
+    index->record(".gams.frames.IndexDrone.0000000000001770.origin",
+        madara::knowledge::KnowledgeRecord(std::vector<double>{60, 0, 0, 0, 0, 0}));
+    index->record(".gams.frames.IndexDrone.0000000000001770.parent",
+        madara::knowledge::KnowledgeRecord(std::string("IndexBase")));
+    TEST(ReferenceFrame::load(ikb, "IndexDrone", 5500).origin().x(), 55);
+
+    FrameIndex::disable(ikb);
+    TEST_EQ(FrameIndex::find(ikb, FrameEvalSettings::default_prefix()) == nullptr, true);
+  }
+
+  std::cout << std::endl << "Testing region containment and distance:" << std::endl;
+  {
+    std::vector<Position> corners = {
+      Position(gps_frame(), -79.939951, 40.443273),
+      Position(gps_frame(), -79.939973, 40.443116),
+      Position(gps_frame(), -79.940313, 40.443085),
+      Position(gps_frame(), -79.940242, 40.443285),
+    };
+    Region region(corners);
+    ReferenceFrame sw(Position(gps_frame(), -79.940313, 40.443085));
+
+    std::vector<Position> queries = {
+      Position(gps_frame(), -79.9401, 40.4432),
+      Position(sw, 20, -5),
+      corners[3],
+    };
+    std::vector<bool> inside = region.contains(queries);
+    for (size_t i = 0; i < queries.size(); ++i) {
+      TEST_EQ(inside[i], region.contains(queries[i]));
+    }
+    TEST_EQ(inside[0], true);
+    TEST_EQ(inside[1], false);
+
+    // nearest point is on the edge between the last two corners
+    double edge = region.distance(queries[1]);
+    TEST(edge, 5.3);
+    TEST(edge < queries[1].distance_to(corners[1]), 1);
+    TEST(region.distance(queries[0]), 0);
+
+    // the cached polygon is rebuilt when vertices change
+    region.vertices[2] = queries[1].transform_to(gps_frame());
+    TEST_EQ(region.contains(queries[1]), true);
+    TEST(region.distance(queries[1]), 0);
+  }
+
+  std::cout << std::endl << "Testing rigid transforms:" << std::endl;
+  {
+    constexpr RigidTransform quarter(0, -1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0);
+    constexpr RigidTransform moved =
+      RigidTransform::translation(1, 2, 3) * quarter;
+    constexpr RigidTransform undone = moved * moved.inverse();
+    static_assert(moved.trans(0) == 1 && moved.rot(1, 0) == 1, "");
+    static_assert(undone.rot(0, 0) == 1 && undone.trans(2) == 0, "");
+
+    // cached hops match the per-call quaternion rotation
+    ReferenceFrame tilted(Pose(default_frame(), 10, 20, 30, 0.3, -0.2, 1.1));
+    double x = 4, y = -5, z = 6;
+    simple_rotate::orient_linear_vec(x, y, z, 0.3, -0.2, 1.1);
+    Position out = Position(tilted, 4, -5, 6).transform_to(tilted.origin_frame());
+    TEST(out.x(), x + 10);
+    TEST(out.y(), y + 20);
+    TEST(out.z(), z + 30);
+
+    x = 1, y = 2, z = 3;
+    tilted.to_origin_transform().apply(&x, &y, &z, 1, false);
+    TEST(x, Velocity(tilted, 1, 2, 3).transform_to(tilted.origin_frame()).dx());
+  }
+
+  std::cout << std::endl << "Testing frame-tagged coordinates:" << std::endl;
+  {
+    constexpr CartesianPosition<MapFrame> a(1, 2, 3);
+    constexpr CartesianPosition<MapFrame> b(4, 6, 3);
+    constexpr CartesianDisplacement<MapFrame> ab = b - a;
+    static_assert(ab.x() == 3 && ab.y() == 4 && ab.squaredNorm() == 25, "");
+    static_assert(a + ab == b && b - ab == a, "");
+    static_assert((ab * 2 - ab) / 1 == ab, "");
+    TEST(a.distance_to(b), 5);
+    TEST(a.distance_to(b), a.position().distance_to(b.position()));
+
+    Position dynamic(default_frame(), 7, 8, 9);
+    CartesianPosition<MapFrame> tagged(dynamic);
+    Position back = tagged.position();
+    TEST(back.x(), dynamic.transform_to(MapFrame::frame()).x());
+    TEST(back.y(), dynamic.transform_to(MapFrame::frame()).y());
+    TEST_EQ(back.frame() == MapFrame::frame(), true);
+
+    // one composed transform matches the hop-by-hop dynamic transform
+    CartesianTransform<BodyFrame, MapFrame> body_to_map;
+    CartesianTransform<MapFrame, BodyFrame> map_to_body;
+    CartesianPosition<BodyFrame> p(3, -1, 2);
+    Position expect = p.position().transform_to(MapFrame::frame());
+    CartesianPosition<MapFrame> q = body_to_map(p);
+    TEST(q.x(), expect.x());
+    TEST(q.y(), expect.y());
+    TEST(q.z(), expect.z());
+    CartesianPosition<BodyFrame> r = map_to_body(a);
+    expect = a.position().transform_to(BodyFrame::frame());
+    TEST(r.x(), expect.x());
+    TEST(r.y(), expect.y());
+    CartesianDisplacement<MapFrame> d =
+      body_to_map(CartesianDisplacement<BodyFrame>(1, 0, 0));
+    TEST(d.norm(), 1);
+  }
+
+  std::cout << std::endl << "Testing search area priorities:" << std::endl;
+  {
+    // a low priority square with a high priority square in its corner,
+    // and a separate square off to the east
+    auto square = [](double lng, double lat, double size) {
+      return std::vector<Position>{
+        Position(gps_frame(), lng, lat),
+        Position(gps_frame(), lng + size, lat),
+        Position(gps_frame(), lng + size, lat + size),
+        Position(gps_frame(), lng, lat + size),
+      };
+    };
+    SearchArea search;
+    search.add_prioritized_region(PrioritizedRegion(square(-80, 40, 0.01), 1));
+    search.add_prioritized_region(PrioritizedRegion(square(-80, 40, 0.004), 5));
+    search.add_prioritized_region(PrioritizedRegion(square(-79.98, 40, 0.01), 3));
+
+    TEST(search.get_priority(Position(gps_frame(), -79.998, 40.002)), 5);
+    TEST(search.get_priority(Position(gps_frame(), -79.993, 40.008)), 1);
+    TEST(search.get_priority(Position(gps_frame(), -79.975, 40.005)), 3);
+    TEST(search.get_priority(Position(gps_frame(), -79.985, 40.005)), 0);
+    TEST_EQ(search.contains(Position(gps_frame(), -79.985, 40.005)), false);
+    TEST_EQ(search.contains(Position(gps_frame(), -79.975, 40.005)), true);
+
+    // local frames are converted before lookup
+    ReferenceFrame corner(Position(gps_frame(), -80, 40));
+    TEST(search.get_priority(Position(corner, 10, 10)), 5);
+
+    // 30 x 10 pixels of 0.001 degrees, row 0 at the north
+    std::vector<madara::knowledge::KnowledgeRecord::Integer> image =
+      search.get_priority_image(10, 30);
+    TEST(image.size(), 300);
+    TEST(image[9 * 30 + 0], 5);
+    TEST(image[0 * 30 + 0], 1);
+    TEST(image[5 * 30 + 15], 0);
+    TEST(image[5 * 30 + 25], 3);
+
+    // the grid is rebuilt when regions are added
+    search.add_prioritized_region(PrioritizedRegion(square(-79.99, 40, 0.01), 2));
+    TEST(search.get_priority(Position(gps_frame(), -79.985, 40.005)), 2);
+  }
+
+  std::cout << std::endl << "Testing fast local tangent plane mode:" << std::endl;
+  {
+    ReferenceFrame local{Pose{gps_frame(), 40.44, -79.94, 300}};
+    Position near(local, 600, -450, 20);
+
+    Position distant(local, 3000, 0, 0);
+
+    Position exact = near.transform_to(gps_frame());
+    Position exact_distant = distant.transform_to(gps_frame());
+    double prev = cartesian::fast_ltp_radius(1000);
+    Position fast = near.transform_to(gps_frame());
+    Position back = fast.transform_to(local);
+    Position fast_distant = distant.transform_to(gps_frame());
+    cartesian::fast_ltp_radius(prev);
+
+    // 1e-7 degrees is about a centimeter
+    TEST_NEAR(fast.lat(), exact.lat(), 1e-7);
+    TEST_NEAR(fast.lng(), exact.lng(), 1e-7);
+    TEST_NEAR(fast.alt(), exact.alt(), 1e-2);
+    TEST_NEAR(back.x(), near.x(), 1e-3);
+    TEST_NEAR(back.y(), near.y(), 1e-3);
+    TEST_NEAR(back.z(), near.z(), 1e-3);
+    TEST_NEAR(fast_distant.lat(), exact_distant.lat(), 1e-7);
+    TEST_NEAR(fast_distant.lng(), exact_distant.lng(), 1e-7);
+  }
+
   if (gams_fails > 0)
   {
     std::cerr << "OVERALL: FAIL. " << gams_fails << " tests failed.\n";
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <math.h>
+#include "gams/pose/Position.h"
+#include "gams/pose/CartesianFrame.h"
+#include "gams/pose/GPSFrame.h"
+#include "gams/pose/PositionArrays.h"
+
+using namespace gams::pose;
+
+int gams_fails = 0;
+
+/* multiplicative factor for deciding if a TEST is sufficiently close */
+const double TEST_epsilon = 0.0001;
+
+double round_nearest(double in)
+{
+  return floor(in + 0.5);
+}
+
+#define TEST(expr, expect) \
+  do {\
+    double bv = (expr); \
+    double v = round_nearest((bv) * 1024)/1024; \
+    double e = round_nearest((expect) * 1024)/1024; \
+    bool ok = \
+      e >= 0 ? (v >= e * (1 - TEST_epsilon) && v <= e * (1 + TEST_epsilon)) \
+             : (v >= e * (1 + TEST_epsilon) && v <= e * (1 - TEST_epsilon)); \
+    if(ok) \
+    { \
+      std::cout << __LINE__ << ": " << #expr << " ?= " << e << "  SUCCESS! got " << bv << std::endl; \
+    } \
+    else \
+    { \
+      std::cout << __LINE__ << ": " << #expr << " ?= " << e << "  FAIL! got " << bv << " instead" << std::endl; \
+      gams_fails++; \
+    } \
+  } while(0)
+
+/**
+ * Returns the largest difference between the batch distances and
+ * distance_to, relative to the distance
+ **/
+double max_relative_error(const Position &from,
+  const std::vector<Position> &to, const std::vector<double> &batch)
+{
+  double worst = 0;
+  for (size_t i = 0; i < to.size(); ++i)
+  {
+    double scalar = from.distance_to(to[i]);
+    double error = fabs(batch[i] - scalar) / (scalar > 1 ? scalar : 1);
+    if (error > worst)
+      worst = error;
+  }
+  return worst;
+}
+
+int main(int, char *[])
+{
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> lng(-80.1, -79.9);
+  std::uniform_real_distribution<double> lat(40.3, 40.5);
+  std::uniform_real_distribution<double> alt(-50, 50);
+  std::uniform_real_distribution<double> meters(-1000, 1000);
+
+  std::vector<Position> gps_points;
+  std::vector<Position> cartesian_points;
+  ReferenceFrame local(Position(gps_frame(), -80, 40.4));
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    gps_points.push_back(Position(gps_frame(), lng(rng), lat(rng),
+      i % 2 ? alt(rng) : 0));
+    cartesian_points.push_back(Position(local,
+      meters(rng), meters(rng), meters(rng)));
+  }
+
+  std::cout << std::endl << "Testing batch distances:" << std::endl;
+  {
+    PositionArrays gps_arrays(gps_frame(), gps_points);
+    PositionArrays cartesian_arrays(local, cartesian_points);
+
+    TEST(max_relative_error(gps_points[3], gps_points,
+      gps_arrays.distances_from(gps_points[3])) < 1e-9, 1);
+    TEST(max_relative_error(cartesian_points[3], cartesian_points,
+      cartesian_arrays.distances_from(cartesian_points[3])) < 1e-12, 1);
+
+    // known values, as in test_coordinates
+    PositionArrays poles(gps_frame());
+    poles.push_back(Position(gps_frame(), 90, 0));
+    poles.push_back(Position(gps_frame(), 90, 90));
+    std::vector<double> to_poles =
+      poles.distances_from(Position(gps_frame(), 0, 0));
+    TEST(to_poles[0], EARTH_CIRC/4);
+    TEST(to_poles[1], EARTH_CIRC/4);
+
+    // from is transformed into the frame of the arrays
+    std::vector<double> from_local = gps_arrays.distances_from(
+      Position(local, 0, 0));
+    TEST(from_local[5],
+      Position(gps_frame(), -80, 40.4).distance_to(gps_points[5]));
+
+    // many-to-many matches one-to-many, row by row
+    PositionArrays some(gps_frame(), std::vector<Position>(
+      gps_points.begin(), gps_points.begin() + 10));
+    std::vector<double> matrix = gps_arrays.distances_from(some);
+    TEST(matrix.size(), 10 * gps_points.size());
+    TEST(matrix[7 * gps_points.size() + 100],
+      gps_points[7].distance_to(gps_points[100]));
+
+    std::vector<Position> some_local;
+    for (size_t i = 0; i < 10; ++i)
+      some_local.push_back(gps_points[i].transform_to(local));
+    std::vector<double> mixed = gps_arrays.distances_from(
+      PositionArrays(local, some_local));
+    TEST(mixed[7 * gps_points.size() + 100], matrix[7 * gps_points.size() + 100]);
+  }
+
+  if (gams_fails > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << gams_fails << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return gams_fails;
+}
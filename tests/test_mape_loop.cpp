@@ -53,6 +53,7 @@
 
 #include "madara/knowledge/KnowledgeBase.h"
 #include "gams/controllers/MapeLoop.h"
+#include "gams/controllers/StaticMapeLoop.h"
 
 // create shortcuts to MADARA classes and namespaces
 namespace engine = madara::knowledge;
@@ -110,6 +111,29 @@ Record execute (engine::FunctionArguments & /*args*/, engine::Variables & vars)
   return Record (0);
 }
 
+/**
+ * Counting phase for the static MAPE loop
+ **/
+struct StaticCounter
+{
+  /// the number of calls
+  Integer calls;
+
+  /// the call that should stop the loop (0 never stops)
+  Integer stop_at;
+
+  StaticCounter (Integer stop = 0)
+    : calls (0), stop_at (stop)
+  {
+  }
+
+  int operator() (engine::KnowledgeBase &)
+  {
+    ++calls;
+    return calls == stop_at ? 1 : 0;
+  }
+};
+
 // perform main logic of program
 int main (int /*argc*/, char ** /*argv*/)
 {
@@ -174,6 +198,33 @@ int main (int /*argc*/, char ** /*argv*/)
     ++gams_fails;
   }
   
+  knowledge.print ("Looping static MAPE loop at 100hz until plan stops it\n");
+
+  controllers::StaticMapeLoop <StaticCounter, StaticCounter,
+    StaticCounter, StaticCounter> static_loop (knowledge,
+      StaticCounter (), StaticCounter (), StaticCounter (20));
+  static_loop.define_expression ("++.static_expression; 0");
+
+  static_loop.run (0.01, 5.0);
+
+  knowledge.set (".static_monitor", static_loop.get_monitor ().calls);
+  knowledge.set (".static_execute", static_loop.get_execute ().calls);
+
+  if (static_loop.get_monitor ().calls == 20 &&
+    static_loop.get_execute ().calls == 20 &&
+    knowledge.get (".static_expression").to_integer () == 20)
+  {
+    knowledge.print ("SUCCESS: static loop ran {.static_monitor} monitor,"
+      " {.static_execute} execute and {.static_expression} expression\n");
+  }
+  else
+  {
+    knowledge.print ("FAIL: static loop ran {.static_monitor} monitor,"
+      " {.static_execute} execute and {.static_expression} expression."
+      " Expected 20 each.\n");
+    ++gams_fails;
+  }
+
   if (gams_fails > 0)
   {
     std::cerr << "OVERALL: FAIL. " << gams_fails << " tests failed.\n";
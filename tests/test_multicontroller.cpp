@@ -0,0 +1,232 @@
+/**
+ * Copyright (c) 2018 Carnegie Mellon University. All Rights Reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following acknowledgments and disclaimers.
+ * 
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 
+ * 3. The names "Carnegie Mellon University," "SEI" and/or "Software
+ *    Engineering Institute" shall not be used to endorse or promote products
+ *    derived from this software without prior written permission. For written
+ *    permission, please contact permission@sei.cmu.edu.
+ * 
+ * 4. Products derived from this software may not be called "SEI" nor may "SEI"
+ *    appear in their names without prior written permission of
+ *    permission@sei.cmu.edu.
+ * 
+ * 5. Redistributions of any form whatsoever must retain the following
+ *    acknowledgment:
+ * 
+ *      This material is based upon work funded and supported by the Department
+ *      of Defense under Contract No. FA8721-05-C-0003 with Carnegie Mellon
+ *      University for the operation of the Software Engineering Institute, a
+ *      federally funded research and development center. Any opinions,
+ *      findings and conclusions or recommendations expressed in this material
+ *      are those of the author(s) and do not necessarily reflect the views of
+ *      the United States Department of Defense.
+ * 
+ *      NO WARRANTY. THIS CARNEGIE MELLON UNIVERSITY AND SOFTWARE ENGINEERING
+ *      INSTITUTE MATERIAL IS FURNISHED ON AN "AS-IS" BASIS. CARNEGIE MELLON
+ *      UNIVERSITY MAKES NO WARRANTIES OF ANY KIND, EITHER EXPRESSED OR
+ *      IMPLIED, AS TO ANY MATTER INCLUDING, BUT NOT LIMITED TO, WARRANTY OF
+ *      FITNESS FOR PURPOSE OR MERCHANTABILITY, EXCLUSIVITY, OR RESULTS
+ *      OBTAINED FROM USE OF THE MATERIAL. CARNEGIE MELLON UNIVERSITY DOES
+ *      NOT MAKE ANY WARRANTY OF ANY KIND WITH RESPECT TO FREEDOM FROM PATENT,
+ *      TRADEMARK, OR COPYRIGHT INFRINGEMENT.
+ * 
+ *      This material has been approved for public release and unlimited
+ *      distribution.
+ **/
+
+/**
+ * @file test_multicontroller.cpp
+ * @author James Edmondson <jedmondson@gmail.com>
+ *
+ * This file contains a test driver for hosting many agents in a
+ * GAMS Multicontroller.
+ **/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "madara/knowledge/KnowledgeBase.h"
+#include "gams/controllers/Multicontroller.h"
+#include "gams/time/ModelsOfComputation.h"
+
+#include "helper/CounterAlgorithm.h"
+#include "helper/CounterPlatform.h"
+
+// create shortcuts to MADARA classes and namespaces
+namespace engine = madara::knowledge;
+namespace controllers = gams::controllers;
+namespace platforms = gams::platforms;
+namespace algorithms = gams::algorithms;
+
+typedef madara::knowledge::KnowledgeRecord   Record;
+typedef Record::Integer Integer;
+
+int gams_fails = 0;
+
+/**
+ * Counter algorithm that checks that .id and .prefix refer to the agent
+ * it is running for
+ **/
+class IdentityAlgorithm : public algorithms::CounterAlgorithm
+{
+public:
+  IdentityAlgorithm (engine::KnowledgeBase & knowledge, Integer id)
+    : CounterAlgorithm (knowledge), id (id), mismatches (0)
+  {
+  }
+
+  virtual int analyze (void)
+  {
+    std::stringstream prefix;
+    prefix << "agent." << id;
+
+    if (*self_->id != id || *self_->prefix != prefix.str ())
+    {
+      ++mismatches;
+    }
+
+    return CounterAlgorithm::analyze ();
+  }
+
+  /// the id of the agent running this algorithm
+  Integer id;
+
+  /// the number of cycles that saw another agent's identity
+  Integer mismatches;
+};
+
+// perform main logic of program
+int main (int /*argc*/, char ** /*argv*/)
+{
+  const size_t num_agents = 8;
+  const double hertz = 10.0;
+  const double duration = 5.0;
+
+  // create knowledge base and a controller for all agents
+  engine::KnowledgeBase knowledge;
+  controllers::Multicontroller loop (knowledge, num_agents);
+  loop.set_num_threads (2);
+
+  std::vector <IdentityAlgorithm *> algorithms;
+
+  // initialize variables and function stubs
+  loop.init_vars (0, (Integer)num_agents);
+
+  for (size_t i = 0; i < num_agents; ++i)
+  {
+    IdentityAlgorithm * algorithm =
+      new IdentityAlgorithm (knowledge, (Integer)i);
+    algorithm->disable_counters ();
+    algorithms.push_back (algorithm);
+
+    loop.init_platform (new platforms::CounterPlatform (knowledge), i);
+    loop.init_algorithm (algorithm, i);
+  }
+
+  std::cerr << "Testing " << num_agents << " agents at " << hertz <<
+    "hz for " << duration << "s on 2 threads.\n";
+
+  loop.run_hz (hertz, duration);
+
+  for (size_t i = 0; i < num_agents; ++i)
+  {
+    std::stringstream overruns_name;
+    overruns_name << ".agent." << i << ".loop.overruns";
+
+    std::cerr << "  agent." << i << ": " << algorithms[i]->loops <<
+      " loops, " << loop.get_overruns (i) << " overruns (" <<
+      knowledge.get (overruns_name.str ()).to_integer () << " in KB)\n";
+
+    if (algorithms[i]->loops >= hertz * .5 * duration &&
+      algorithms[i]->loops <= hertz * 1.5 * duration)
+    {
+      std::cerr << "  SUCCESS: agent kept its loop rate\n";
+    }
+    else
+    {
+      std::cerr << "  FAIL: agent did not keep its loop rate\n";
+      ++gams_fails;
+    }
+
+    if (knowledge.get (overruns_name.str ()).to_integer () ==
+      loop.get_overruns (i))
+    {
+      std::cerr << "  SUCCESS: overruns were published\n";
+    }
+    else
+    {
+      std::cerr << "  FAIL: overruns were not published\n";
+      ++gams_fails;
+    }
+
+    if (algorithms[i]->mismatches == 0)
+    {
+      std::cerr << "  SUCCESS: .id and .prefix matched the agent\n";
+    }
+    else
+    {
+      std::cerr << "  FAIL: .id or .prefix belonged to another agent in " <<
+        algorithms[i]->mismatches << " cycles\n";
+      ++gams_fails;
+    }
+  }
+
+  const double virtual_duration = 60.0;
+
+  std::cerr << "Testing " << num_agents << " agents at " << hertz <<
+    "hz for " << virtual_duration << "s of virtual time.\n";
+
+  controllers::ControllerSettings settings;
+  settings.virtual_time = true;
+  loop.configure (settings);
+
+  for (size_t i = 0; i < num_agents; ++i)
+  {
+    algorithms[i]->reset_counters ();
+  }
+
+  loop.run_hz (hertz, virtual_duration);
+
+  gams::time::VirtualClock::disable ();
+
+  for (size_t i = 0; i < num_agents; ++i)
+  {
+    std::cerr << "  agent." << i << ": " << algorithms[i]->loops <<
+      " virtual loops\n";
+
+    // every agent runs once per round
+    if (algorithms[i]->loops >= (Integer)(hertz * virtual_duration) &&
+      algorithms[i]->loops <= (Integer)(hertz * virtual_duration) + 1 &&
+      algorithms[i]->mismatches == 0)
+    {
+      std::cerr << "  SUCCESS: agent ran once per round\n";
+    }
+    else
+    {
+      std::cerr << "  FAIL: agent did not run once per round\n";
+      ++gams_fails;
+    }
+  }
+
+  if (gams_fails > 0)
+  {
+    std::cerr << "OVERALL: FAIL. " << gams_fails << " tests failed.\n";
+  }
+  else
+  {
+    std::cerr << "OVERALL: SUCCESS.\n";
+  }
+
+  return gams_fails;
+}
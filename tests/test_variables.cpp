@@ -53,13 +53,18 @@
  **/
 
 #include <iostream>
+#include <cmath>
 
 #include "gams/pose/Position.h"
 #include "gams/platforms/BasePlatform.h"
 #include "gams/pose/GPSFrame.h"
 #include "gams/variables/Agent.h"
+#include "gams/variables/AgentView.h"
+#include "gams/variables/AlgorithmStatus.h"
 #include "gams/variables/Sensor.h"
 #include "gams/variables/Swarm.h"
+#include "gams/variables/SwarmSnapshot.h"
+#include "gams/variables/Trajectory.h"
 
 #include "gams/variables/AccentStatus.h"
 
@@ -434,7 +439,320 @@ test_agent (void)
 void
 test_sensor (void)
 {
+  std::cout << "Testing Sensor...\n";
 
+  knowledge::KnowledgeBase context;
+
+  variables::Sensor sensor ("coverage", &context, 2.5);
+
+  sensor.set_index_value (3, 4, 1.5);
+  sensor.set_index_value (-1, -70, 2.5);
+  sensor.set_index_value (200, 5, 3.5,
+    knowledge::KnowledgeUpdateSettings (true));
+
+  std::cout << "  Testing Sensor.get_index_value: ";
+  if (sensor.get_index_value (3, 4) == 1.5 &&
+    sensor.get_index_value (-1, -70) == 2.5 &&
+    sensor.get_index_value (200, 5) == 3.5 &&
+    sensor.get_index_value (4, 3) == 0.0 &&
+    sensor.get_num_tiles () == 3)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Sensor.sync publishes modified tiles: ";
+  if (sensor.sync () == 2 && sensor.sync () == 0 &&
+    context.get ("sensor.coverage.tiles.0x0").retrieve_index (
+      4 * variables::Sensor::TILE_SIZE + 3).to_double () == 1.5)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Sensor.sync imports remote tiles: ";
+  variables::Sensor remote ("coverage", &context, 2.5);
+  bool loaded = remote.get_index_value (3, 4) == 1.5;
+
+  sensor.set_index_value (3, 4, 4.5);
+  sensor.sync ();
+  remote.sync ();
+
+  if (loaded && remote.get_index_value (3, 4) == 4.5 &&
+    remote.get_index_value (-1, -70) == 2.5)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Sensor reads refresh changed tiles once per sync: ";
+  sensor.set_index_value (3, 4, 6.5);
+  sensor.sync ();
+  bool cached = remote.get_index_value (3, 4) == 4.5;
+  remote.sync ();
+
+  if (cached && remote.get_index_value (3, 4) == 6.5)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Sensor.sync publishes only broadcast cells: ";
+  const size_t tile_size = variables::Sensor::TILE_SIZE;
+  sensor.set_index_value (5, 5, 7.0,
+    knowledge::KnowledgeUpdateSettings (true));
+  sensor.set_index_value (6, 6, 1.0);
+  remote.set_index_value (7, 7, 2.0);
+  sensor.sync ();
+  remote.sync ();
+
+  knowledge::KnowledgeRecord tile = context.get ("sensor.coverage.tiles.0x0");
+  if (tile.retrieve_index (5 * tile_size + 5).to_double () == 0.0 &&
+    tile.retrieve_index (6 * tile_size + 6).to_double () == 1.0 &&
+    tile.retrieve_index (7 * tile_size + 7).to_double () == 2.0 &&
+    remote.get_index_value (6, 6) == 1.0 &&
+    sensor.get_index_value (7, 7) == 2.0)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Sensor delta mode merges with max: ";
+  knowledge::KnowledgeBase delta_context;
+  variables::Sensor sender ("swept", &delta_context, 2.5);
+  variables::Sensor receiver ("swept", &delta_context, 2.5);
+  sender.set_delta_mode ("agent.0", variables::Sensor::MERGE_MAX);
+  receiver.set_delta_mode ("agent.1", variables::Sensor::MERGE_MAX);
+
+  for (int x = 0; x < 100; ++x)
+    sender.set_index_value (x, 7, 5.0);
+  sender.set_index_value (-3, 2, 1.0);
+  receiver.set_index_value (10, 7, 9.0);
+
+  size_t sent = sender.sync ();
+  receiver.sync ();
+
+  if (sent == 3 &&
+    delta_context.get ("sensor.swept.deltas.agent.0").is_binary_file_type () &&
+    receiver.get_index_value (99, 7) == 5.0 &&
+    receiver.get_index_value (10, 7) == 9.0 &&
+    receiver.get_index_value (-3, 2) == 1.0 &&
+    sender.get_index_value (10, 7) == 0.0)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Sensor delta mode requests keyframes on gaps: ";
+  sender.set_index_value (1, 1, 3.0);
+  sender.sync ();
+  sender.set_index_value (2, 2, 4.0);
+  sender.sync ();
+
+  // the first delta was overwritten before the receiver synced
+  receiver.sync ();
+  bool missed = receiver.get_index_value (1, 1) == 0.0 &&
+    receiver.get_index_value (2, 2) == 4.0 &&
+    delta_context.get (
+      "sensor.swept.keyframe_requests.agent.0").to_integer () == 1;
+
+  size_t resent = sender.sync ();
+  receiver.sync ();
+
+  if (missed && resent == 3 && sender.sync () == 0 &&
+    receiver.get_index_value (1, 1) == 3.0)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+}
+
+void
+test_agent_views (void)
+{
+  std::cout << "Testing AgentView...\n";
+
+  knowledge::KnowledgeBase context;
+
+  variables::AgentViews views;
+  variables::init_vars (views, context, 1000);
+
+  std::cout << "  Testing init_vars does not bind: ";
+  if (views.size () == 1000 && views[999].get_prefix () == "agent.999" &&
+    views[999].get_num_bound () == 0 && !context.exists ("agent.999.dest"))
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  views[5].location ().set (std::vector <double> {1.0, 2.0, 3.0});
+  views[5].algorithm () = "patrol";
+
+  std::cout << "  Testing AgentView binds on access: ";
+  if (views[5].get_num_bound () == 2 &&
+    context.get ("agent.5.location").retrieve_index (1).to_double () == 2.0 &&
+    views[5].agent ().location[2] == 3.0 &&
+    views[5].agent ().algorithm == "patrol")
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+}
+
+void
+test_packed_status (void)
+{
+  std::cout << "Testing packed AlgorithmStatus...\n";
+
+  knowledge::KnowledgeBase context;
+
+  variables::AlgorithmStatus status;
+  status.init_vars (context, "move", "agent.0");
+  status.init_variable_values ();
+  status.set_packed (true);
+
+  status.waiting = 1;
+  status.finished = 1;
+
+  std::cout << "  Testing AlgorithmStatus.pack: ";
+  if (status.pack () && !status.pack () &&
+    (*status.flags & 0xffffffff) == (1 | 4 | 64) && (*status.flags >> 32) == 1)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  status.waiting = 0;
+  status.pack ();
+
+  variables::AlgorithmStatus peer;
+  peer.init_vars (context, "move", "agent.0");
+
+  std::cout << "  Testing AlgorithmStatus.unpack: ";
+  if (peer.unpack () && !peer.unpack () && *peer.ok == 1 &&
+    *peer.waiting == 0 && *peer.finished == 1 && (*peer.flags >> 32) == 2)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+}
+
+void
+test_trajectory (void)
+{
+  std::cout << "Testing Trajectory...\n";
+
+  // x accelerates at 4 units/s^2 and y moves at 3 units/s
+  variables::Trajectory trajectory (4);
+  for (int i = 0; i < 6; ++i)
+  {
+    double t = i * 0.5;
+    trajectory.add (t, 2 * t * t + 1, 3 * t, 0);
+  }
+
+  double x, y, z;
+
+  std::cout << "  Testing Trajectory.add wraps: ";
+  if (trajectory.size () == 4 && trajectory.get (0).time == 1.0 &&
+    trajectory.back ().time == 2.5)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Trajectory.interpolate: ";
+  if (trajectory.interpolate (1.75, x, y, z) && std::abs (y - 5.25) < 1e-9 &&
+    !trajectory.interpolate (0.5, x, y, z))
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  double vx, vy, vz, ax, ay, az;
+
+  std::cout << "  Testing Trajectory estimates: ";
+  if (trajectory.velocity (vx, vy, vz) && std::abs (vx - 10) < 1e-9 &&
+    std::abs (vy - 3) < 1e-9 &&
+    trajectory.acceleration (ax, ay, az) && std::abs (ax - 4) < 1e-9 &&
+    trajectory.extrapolate (3.0, x, y, z) && std::abs (x - 19) < 1e-9 &&
+    std::abs (y - 9) < 1e-9)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing Trajectory ignores uneven acceleration: ";
+  variables::Trajectory uneven (3);
+  uneven.add (0.0, 0, 0, 0);
+  uneven.add (0.1, 1, 0, 0);
+  uneven.add (1.0, 2, 0, 0);
+
+  if (!uneven.acceleration (ax, ay, az) &&
+    uneven.velocity (vx, vy, vz) && std::abs (vx - 1 / 0.9) < 1e-9)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
 }
 
 void
@@ -465,13 +783,90 @@ test_swarm (void)
     (swarm.size == 5 ? "SUCCESS\n" : "FAIL\n");
 }
 
+void
+test_swarm_snapshot (void)
+{
+  std::cout << "Testing SwarmSnapshot...\n";
+
+  knowledge::KnowledgeBase context;
+
+  variables::Agents agents;
+  variables::init_vars (agents, context, 3);
+
+  agents[0].location.set (std::vector <double> {1.0, 2.0, 3.0});
+  agents[0].velocity.set (std::vector <double> {0.5, 0.25, 0.0});
+  agents[2].location.set (std::vector <double> {7.0, 8.0});
+  agents[2].orientation.set (std::vector <double> {0.0, 0.0, 90.0});
+
+  variables::SwarmSnapshot snapshot;
+  snapshot.init (context, agents);
+  snapshot.update ();
+
+  std::cout << "  Testing SwarmSnapshot.size: ";
+  if (snapshot.size () == 3 && snapshot.ids[2] == 2 &&
+    snapshot.find ("agent.1") == 1)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing SwarmSnapshot.location: ";
+  if (snapshot.has_location[0] && !snapshot.has_location[1] &&
+    snapshot.has_location[2] &&
+    snapshot.x[0] == 1.0 && snapshot.y[0] == 2.0 && snapshot.z[0] == 3.0 &&
+    snapshot.x[2] == 7.0 && snapshot.y[2] == 8.0 && snapshot.z[2] == 0.0)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  std::cout << "  Testing SwarmSnapshot.velocity and orientation: ";
+  if (snapshot.vx[0] == 0.5 && snapshot.vy[0] == 0.25 &&
+    snapshot.rz[2] == 90.0 && snapshot.vx[1] == 0.0)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+
+  agents[1].location.set (std::vector <double> {4.0, 5.0, 6.0});
+  snapshot.update ();
+
+  std::cout << "  Testing SwarmSnapshot.update: ";
+  if (snapshot.has_location[1] && snapshot.x[1] == 4.0 &&
+    snapshot.get_updates () == 2)
+  {
+    std::cout << "SUCCESS\n";
+  }
+  else
+  {
+    std::cout << "FAIL\n";
+    ++gams_fails;
+  }
+}
+
 int
 main (int /*argc*/, char ** /*argv*/)
 {
   test_accent ();
   test_agent ();
   test_sensor ();
+  test_agent_views ();
+  test_packed_status ();
+  test_trajectory ();
   test_swarm ();
+  test_swarm_snapshot ();
 
   if (gams_fails > 0)
   {
@@ -0,0 +1,147 @@
+/**
+ * Times distance_to against the PositionArrays batch distances, for GPS
+ * and Cartesian frames. Prints nanoseconds per distance; checks nothing.
+ * Correctness is covered by test_distances.
+ **/
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "gams/pose/Position.h"
+#include "gams/pose/CartesianFrame.h"
+#include "gams/pose/GPSFrame.h"
+#include "gams/pose/PositionArrays.h"
+
+using namespace gams::pose;
+
+typedef std::chrono::steady_clock Clock;
+
+// number of positions in each set
+size_t num_points (1000);
+
+// number of one-to-many passes to time
+size_t rounds (2000);
+
+void print_usage (char * prog_name)
+{
+  std::cerr << "\nProgram summary for " << prog_name << ":\n\n" \
+" Times scalar and batch distance calculations\n\n" \
+" [-n |--points num]            number of positions (default: 1000)\n" \
+" [-r |--rounds num]            one-to-many passes to time (default: 2000)\n" \
+"\n";
+  exit (0);
+}
+
+void handle_arguments (int argc, char ** argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg1 (argv[i]);
+
+    if (arg1 == "-n" || arg1 == "--points")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> num_points;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else if (arg1 == "-r" || arg1 == "--rounds")
+    {
+      if (i + 1 < argc)
+      {
+        std::stringstream buffer (argv[i + 1]);
+        buffer >> rounds;
+      }
+      else
+        print_usage (argv[0]);
+
+      ++i;
+    }
+    else
+    {
+      print_usage (argv[0]);
+    }
+  }
+
+  if (num_points == 0 || rounds == 0)
+    print_usage (argv[0]);
+}
+
+double seconds_since (Clock::time_point start)
+{
+  return std::chrono::duration<double> (Clock::now () - start).count ();
+}
+
+/**
+ * Times one-to-many and many-to-many distances, scalar against batch
+ **/
+void benchmark (const std::string & name,
+  const std::vector<Position> & points)
+{
+  const PositionArrays arrays (points[0].frame (), points);
+  std::vector<double> results (points.size () * points.size ());
+  volatile double sink = 0;
+
+  Clock::time_point start = Clock::now ();
+  for (size_t r = 0; r < rounds; ++r)
+    for (size_t i = 0; i < points.size (); ++i)
+      sink = sink + points[r % points.size ()].distance_to (points[i]);
+  double scalar = seconds_since (start);
+
+  start = Clock::now ();
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    arrays.distances_from (points[r % points.size ()], results.data ());
+    sink = sink + results[0];
+  }
+  double batch = seconds_since (start);
+
+  start = Clock::now ();
+  arrays.distances_from (arrays, results.data ());
+  double matrix = seconds_since (start);
+  sink = sink + results[0];
+
+  double count = (double)rounds * points.size ();
+  std::cout << name << ": scalar " << scalar / count * 1e9 <<
+    " ns, one-to-many " << batch / count * 1e9 << " ns, many-to-many " <<
+    matrix / points.size () / points.size () * 1e9 <<
+    " ns per distance (" << scalar / batch << "x)" << std::endl;
+}
+
+int main (int argc, char ** argv)
+{
+  handle_arguments (argc, argv);
+
+  std::mt19937 rng (42);
+  std::uniform_real_distribution<double> lng (-80.1, -79.9);
+  std::uniform_real_distribution<double> lat (40.3, 40.5);
+  std::uniform_real_distribution<double> alt (-50, 50);
+  std::uniform_real_distribution<double> meters (-1000, 1000);
+
+  std::vector<Position> gps_points;
+  std::vector<Position> cartesian_points;
+  ReferenceFrame local (Position (gps_frame (), -80, 40.4));
+  for (size_t i = 0; i < num_points; ++i)
+  {
+    gps_points.push_back (Position (gps_frame (), lng (rng), lat (rng),
+      i % 2 ? alt (rng) : 0));
+    cartesian_points.push_back (Position (local,
+      meters (rng), meters (rng), meters (rng)));
+  }
+
+  std::cout << "Timing " << num_points << " positions over " <<
+    rounds << " rounds:" << std::endl;
+  benchmark ("GPS", gps_points);
+  benchmark ("Cartesian", cartesian_points);
+
+  return 0;
+}